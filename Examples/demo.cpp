@@ -9,6 +9,7 @@
  #include "display_config.h" // For panel_handle, frame_buffer, LCD_H_RES, LCD_V_RES
  #include "simple_touch.h"   // For touch_init, touch_touched, touch_last_x, touch_last_y, and ts
  #include "FastGraphics.h"   // The FastGraphics library
+ #include "FastWidgets.h"    // FastButton, FastLabel and the FastWidgets registry
 
 // --- Demo Scene Management ---
 int currentScene = 0;
@@ -22,15 +23,15 @@ int currentRotationDemoIndex = 0;
 const int MAX_ROTATION_DEMOS = sizeof(demoRotations) / sizeof(ScreenRotation);
 
 // --- For Interactive Scene ---
+// Targets are FastButtons: FastWidgets finds the one under the finger in its hit-test
+// grid, and a press or release repaints that button only.
 const int NUM_TARGETS = 5;
-struct TouchTarget {
-    int16_t x, y, r;
-    uint16_t color;
-    uint16_t originalColor;
-    bool hit;
-};
-TouchTarget touchTargets[NUM_TARGETS];
-bool interactiveTargetsInitialized = false;
+FastButton* targetButtons[NUM_TARGETS];
+int targetHits[NUM_TARGETS];
+FastLabel* touchLabel = nullptr;
+bool interactiveWaitForRelease = false; // Ignore the touch that opened the scene
+bool interactiveTouched = false;        // Finger was down on the previous poll
+bool interactivePressOnTarget = false;  // Current touch started on a target
 
 // Predefined colors for the palette scene
 struct ColorEntry {
@@ -222,38 +223,44 @@ void drawSceneRotationDemo() {
 }
 
 
-void initializeInteractiveTargets() {
-    if (!interactiveTargetsInitialized) {
-        for(int i=0; i<NUM_TARGETS; ++i) {
-            touchTargets[i].x = random(30 + 20, FastGraphics::getWidth() - 30 - 20); // Radius + padding
-            touchTargets[i].y = random(80 + 20, FastGraphics::getHeight() - 30 - 20); // Below title, radius + padding
-            touchTargets[i].r = random(15, 35);
-            // Ensure color is not black for visibility
-            do {
-                touchTargets[i].originalColor = colorPalette[random(0, NUM_PALETTE_COLORS -1)].color;
-            } while (touchTargets[i].originalColor == COLOR_BLACK);
-            touchTargets[i].color = touchTargets[i].originalColor;
-            touchTargets[i].hit = false;
-        }
-        interactiveTargetsInitialized = true;
+/**
+ * @brief Creates the interactive scene's widgets once the screen size is known.
+ * @details One target per column at a random height and in a random palette color.
+ *          The scene always runs in ROTATION_0 (leaving the rotation demo resets it).
+ */
+void createInteractiveTargets() {
+    int16_t columnWidth = FastGraphics::getWidth() / NUM_TARGETS;
+    uint8_t captionSize = columnWidth >= 140 ? 2 : 1;
+    for(int i=0; i<NUM_TARGETS; ++i) {
+        uint16_t color;
+        // Ensure color is not black for visibility
+        do {
+            color = colorPalette[random(0, NUM_PALETTE_COLORS -1)].color;
+        } while (color == COLOR_BLACK);
+        int16_t y = random(80, FastGraphics::getHeight() - 60 - 50); // Below the text, above the touch readout
+        targetButtons[i] = new FastButton(i * columnWidth + 10, y, columnWidth - 20, 60, "",
+                                          COLOR_WHITE, color, COLOR_GRAY, captionSize);
     }
+    touchLabel = new FastLabel(10, FastGraphics::getHeight() - 40, 200, 8, "", COLOR_WHITE, COLOR_BLACK, 1);
 }
 
-void resetInteractiveTargets() {
-     for(int i=0; i<NUM_TARGETS; ++i) {
-        touchTargets[i].color = touchTargets[i].originalColor;
-        touchTargets[i].hit = false;
+/**
+ * @brief Registers the interactive scene's widgets with fresh hit counters.
+ */
+void enterSceneInteractive() {
+    for(int i=0; i<NUM_TARGETS; ++i) {
+        targetHits[i] = 0;
+        targetButtons[i]->setText("Hits: 0");
+        FastWidgets::add(targetButtons[i]);
     }
+    touchLabel->setText("");
+    FastWidgets::add(touchLabel);
+    interactiveWaitForRelease = true;
+    interactiveTouched = false;
 }
 
 void drawSceneInteractive() {
-    // Ensure targets are initialized for the current screen dimensions (especially after rotation)
-    if(FastGraphics::getRotation() != ROTATION_0 && currentScene == 4) { // If coming from rotation scene
-         interactiveTargetsInitialized = false; // Force re-init
-    }
     FastGraphics::clear(COLOR_BLACK);
-    initializeInteractiveTargets();
-
 
     FastGraphics::setTextColor(COLOR_CYAN, COLOR_BLACK);
     FastGraphics::setTextSize(2);
@@ -261,23 +268,51 @@ void drawSceneInteractive() {
 
     FastGraphics::setTextSize(1);
     FastGraphics::setTextColor(COLOR_YELLOW);
-    FastGraphics::text(10, 45, "Touch the circles! Touch empty space to advance.", COLOR_YELLOW, COLOR_BLACK, 1);
+    FastGraphics::text(10, 45, "Tap the buttons! Tap empty space to advance.", COLOR_YELLOW, COLOR_BLACK, 1);
 
-    for(int i=0; i<NUM_TARGETS; ++i) {
-        FastGraphics::fillCircle(touchTargets[i].x, touchTargets[i].y, touchTargets[i].r, touchTargets[i].color);
-        if (touchTargets[i].hit) {
-            FastGraphics::circle(touchTargets[i].x, touchTargets[i].y, touchTargets[i].r + 3, COLOR_WHITE); // Highlight hit
-        }
+    FastWidgets::invalidateAll(); // clear() painted over the widgets
+    FastWidgets::update();
+    drawSceneIndicator();
+}
+
+/**
+ * @brief Feeds one touch poll to the interactive scene.
+ * @details Only the pressed or released button and the coordinate label are
+ *          repainted and flushed; the rest of the scene is never redrawn.
+ * @param touched Result of touch_touched() for this poll.
+ * @return true when a tap that started on empty space asks for the next scene.
+ */
+bool updateSceneInteractive(bool touched) {
+    if (interactiveWaitForRelease) {
+        interactiveWaitForRelease = touched;
+        return false;
     }
 
-    // Display last touch coordinate for feedback
-    if (ts.isTouched) {
-         char touchCoords[30];
-         sprintf(touchCoords, "Touch: %03d, %03d", touch_last_x, touch_last_y);
-         FastGraphics::text(10, FastGraphics::getHeight() - 40, touchCoords, COLOR_WHITE, COLOR_BLACK, 1);
-         FastGraphics::fillCircle(touch_last_x, touch_last_y, 3, COLOR_RED); // Small dot for precise touch point
+    bool advance = false;
+    if (touched) {
+        FastWidget* target = FastWidgets::touchDown(touch_last_x, touch_last_y);
+        if (!interactiveTouched) interactivePressOnTarget = target != nullptr;
+
+        // Display last touch coordinate for feedback
+        char touchCoords[30];
+        sprintf(touchCoords, "Touch: %03d, %03d", touch_last_x, touch_last_y);
+        touchLabel->setText(touchCoords);
+    } else if (interactiveTouched) {
+        FastWidget* released = FastWidgets::touchUp(); // nullptr if the finger slid off
+        for(int i=0; i<NUM_TARGETS; ++i) {
+            if (released == targetButtons[i]) {
+                char caption[16];
+                sprintf(caption, "Hits: %d", ++targetHits[i]);
+                targetButtons[i]->setText(caption);
+            }
+        }
+        advance = !interactivePressOnTarget;
     }
-    drawSceneIndicator();
+    interactiveTouched = touched;
+
+    FastWidgets::update();
+    FastGraphics::flush();
+    return advance;
 }
 
 // --- Main Application Logic ---
@@ -295,12 +330,11 @@ void drawCurrentSceneAndUpdateDisplay() {
         currentRotationDemoIndex = 0; // Reset rotation demo state
     }
 
-    // If not in interactive scene, ensure its state is ready for next entry
-    if (currentScene != 4) {
-        interactiveTargetsInitialized = false; // Allows re-initialization with current screen dimensions
-    } else {
-        // Ensure interactive scene is initialized if just entered
-        if(!interactiveTargetsInitialized) initializeInteractiveTargets();
+    // The interactive scene's widgets are registered only while it is shown
+    if (currentScene == 4 && previousSceneForRotationReset != 4) {
+        enterSceneInteractive();
+    } else if (currentScene != 4) {
+        FastWidgets::removeAll();
     }
 
 
@@ -317,10 +351,8 @@ void drawCurrentSceneAndUpdateDisplay() {
     }
     previousSceneForRotationReset = currentScene;
 
-    // Actually send the framebuffer to the display
-    if (panel_handle && frame_buffer) {
-        esp_lcd_panel_draw_bitmap(panel_handle, 0, 0, LCD_H_RES, LCD_V_RES, frame_buffer);
-    }
+    // Send the regions that changed to the display
+    FastGraphics::flush();
 }
 
 void setup() {
@@ -328,11 +360,6 @@ void setup() {
     Serial.println("ESP32-S3 FastGraphics Demo Starting...");
     randomSeed(analogRead(A0)); // Use a floating analog pin for random seed
 
-    // Initialize touch controller
-    touch_init();
-    Serial.println(ts.isTouched ? "Touch controller seems active." : "Touch controller state unknown at init.");
-
-
     // Initialize display and framebuffer
     if (!initialize_display_and_framebuffer()) {
         Serial.println("FATAL: Display initialization FAILED! Halting.");
@@ -340,15 +367,19 @@ void setup() {
     }
     Serial.println("Display initialized.");
 
+    // Initialize touch controller (after the display: panel detection probes the same I2C bus)
+    touch_init();
+    Serial.println(ts.isTouched ? "Touch controller seems active." : "Touch controller state unknown at init.");
+
     // Initialize graphics library
-    FastGraphics::begin(frame_buffer);
+    FastGraphics::begin(frame_buffer, panel_handle);
     FastGraphics::setRotation(ROTATION_0); // Ensure default rotation
     FastGraphics::setTextWrap(true);       // Default for most text
     FastGraphics::setLineSpacing(2);       // Default line spacing
     Serial.println("FastGraphics library initialized.");
 
     currentRotationDemoIndex = 0; // Start rotation demo from first rotation
-    interactiveTargetsInitialized = false; // Ensure targets are fresh for first interactive scene
+    createInteractiveTargets(); // Sized for the screen, so after FastGraphics::begin()
 
     drawCurrentSceneAndUpdateDisplay();
     lastInteractionTime = millis();
@@ -359,6 +390,17 @@ void loop() {
     bool sceneNeedsRedraw = false;
     bool justTouched = touch_touched(); // Poll touch once per loop
 
+    if (currentScene == 4) { // Interactive Demo Scene: the widgets handle the touch
+        if (updateSceneInteractive(justTouched)) {
+            currentScene = (currentScene + 1) % MAX_SCENES;
+            lastInteractionTime = millis();
+            drawCurrentSceneAndUpdateDisplay();
+            Serial.printf("Redrawing scene %d.\n", currentScene + 1);
+        }
+        delay(30);
+        return;
+    }
+
     if (justTouched && (millis() - lastInteractionTime > INTERACTION_DEBOUNCE)) {
         Serial.printf("Touch detected at: %d, %d. Current scene: %d\n", touch_last_x, touch_last_y, currentScene + 1);
         lastInteractionTime = millis();
@@ -371,38 +413,10 @@ void loop() {
                 // Rotation will be reset by drawCurrentSceneAndUpdateDisplay's logic
             }
             sceneNeedsRedraw = true;
-        } else if (currentScene == 4) { // Interactive Demo Scene
-            bool targetHit = false;
-            for(int i=0; i<NUM_TARGETS; ++i) {
-                int dx = touchTargets[i].x - touch_last_x;
-                int dy = touchTargets[i].y - touch_last_y;
-                if (dx*dx + dy*dy < touchTargets[i].r * touchTargets[i].r) {
-                    touchTargets[i].color = colorPalette[random(0, NUM_PALETTE_COLORS -1)].color; // Change to random color
-                    while(touchTargets[i].color == COLOR_BLACK) touchTargets[i].color = colorPalette[random(0, NUM_PALETTE_COLORS -1)].color; // ensure not black
-                    touchTargets[i].hit = true;
-                    targetHit = true;
-                    break; // Only one hit per touch
-                }
-            }
-            if (!targetHit) { // If no target was hit, advance to next scene
-                currentScene = (currentScene + 1) % MAX_SCENES;
-                resetInteractiveTargets(); // Reset for next time
-                interactiveTargetsInitialized = false;
-            }
-            sceneNeedsRedraw = true;
         } else { // All other scenes
             currentScene = (currentScene + 1) % MAX_SCENES;
             sceneNeedsRedraw = true;
-             // If moving to interactive scene, reset its state
-            if (currentScene == 4) {
-                resetInteractiveTargets();
-                interactiveTargetsInitialized = false;
-            }
         }
-    } else if (justTouched && currentScene == 4) {
-        // For interactive scene, allow quick touch feedback even within debounce for scene change
-        // This redraws the touch point but doesn't necessarily change targets yet
-        sceneNeedsRedraw = true;
     }
 
 
@@ -0,0 +1,457 @@
+/**
+ * @file benchmark.cpp
+ * @brief FastGraphics throughput benchmark (PlatformIO env:benchmark)
+ * @author p43lz3r
+ * @date 2025
+ *
+ * @details Runs a fixed, repeatable suite of drawing operations on the real panel and
+ *          prints one CSV line per test over serial:
+ *
+ *          BENCH,<test>,<rotation>,<param>,<ops>,<total_us>,<us_per_op>,<mpix_per_s>
+ *
+ *          Lines starting with '#' are comments, the INFO line identifies the board.
+ *          Send any character over serial to run the suite again.
+ *
+ * @note Build and upload with: pio run -e benchmark -t upload -t monitor
+ * @note Coordinates come from a fixed-seed generator, so every run draws the same frames
+ * @note Draw tests start with the whole screen marked dirty, so dirty tracking costs
+ *       its minimum; the flush tests measure panel transfer separately
+ */
+
+#include <Arduino.h>
+#include "esp_timer.h"
+#include "display_config.h"
+#include "FastGraphics.h"
+#include "FastKernels.h"
+#include "FastFormat.h"
+#include "FixedCanvas.h"
+
+// =============================================================================
+// BENCHMARK HELPERS
+// =============================================================================
+
+// Minimum time per test, short tests are repeated until they reach it
+#define BENCH_MIN_US 200000
+
+/**
+ * @brief One benchmark operation
+ * @param i Operation index (drives the coordinate generator)
+ * @return Pixels written by this operation
+ */
+typedef uint32_t (*BenchOp)(uint32_t i);
+
+static uint32_t bench_seed = 1;
+static int16_t bench_param = 0;     // Size/radius/text size of the running test
+
+/**
+ * @brief Fixed-seed linear congruential generator
+ * @return Pseudo-random value in [0, range)
+ */
+static int16_t benchRandom(int16_t range) {
+    bench_seed = bench_seed * 1664525u + 1013904223u;
+    return (int16_t)((bench_seed >> 16) % (uint32_t)range);
+}
+
+/**
+ * @brief Time one operation and print its CSV line
+ * @implementation Runs one untimed warm-up call, then repeats batches of ops until
+ *                 BENCH_MIN_US has passed. The seed is reset first so each run draws
+ *                 the same sequence.
+ */
+static void runBench(const char* name, int16_t param, uint32_t batch, BenchOp op) {
+    bench_param = param;
+    bench_seed = 1;
+    FastGraphics::markAllDirty();
+    op(0);
+
+    uint64_t pixels = 0;
+    uint32_t ops = 0;
+    int64_t start = esp_timer_get_time();
+    int64_t elapsed;
+    do {
+        for (uint32_t i = 0; i < batch; i++) {
+            pixels += op(ops + i);
+        }
+        ops += batch;
+        elapsed = esp_timer_get_time() - start;
+    } while (elapsed < BENCH_MIN_US);
+
+    double us_per_op = (double)elapsed / ops;
+    double mpix_per_s = (double)pixels / elapsed;     // pixels/us == Mpixels/s
+    Serial.printf("BENCH,%s,%d,%d,%lu,%lld,%.3f,%.2f\n", name, (int)FastGraphics::getRotation() * 90,
+                  param, (unsigned long)ops, (long long)elapsed, us_per_op, mpix_per_s);
+}
+
+// =============================================================================
+// BENCHMARK OPERATIONS
+// =============================================================================
+
+static uint32_t opClear(uint32_t i) {
+    FastGraphics::clear(i & 1 ? COLOR_BLUE : COLOR_BLACK);
+    return (uint32_t)LCD_H_RES * LCD_V_RES;
+}
+
+static uint32_t opClearAsync(uint32_t i) {
+    // Waits for the previous clear, so us/op is the DMA fill rate (the CPU idles meanwhile)
+    FastGraphics::waitIdle();
+    FastGraphics::clear(i & 1 ? COLOR_BLUE : COLOR_BLACK);
+    return (uint32_t)LCD_H_RES * LCD_V_RES;
+}
+
+static uint32_t opPixel(uint32_t i) {
+    FastGraphics::pixel(benchRandom(FastGraphics::getWidth()), benchRandom(FastGraphics::getHeight()),
+                        (uint16_t)(i * 0x1234));
+    return 1;
+}
+
+static uint32_t opFillRect(uint32_t i) {
+    int16_t size = bench_param;
+    int16_t x = benchRandom(FastGraphics::getWidth() - size);
+    int16_t y = benchRandom(FastGraphics::getHeight() - size);
+    FastGraphics::fillRect(x, y, size, size, (uint16_t)(i * 0x1234));
+    return (uint32_t)size * size;
+}
+
+static uint32_t opFillRectAlpha(uint32_t i) {
+    int16_t size = bench_param;
+    int16_t x = benchRandom(FastGraphics::getWidth() - size);
+    int16_t y = benchRandom(FastGraphics::getHeight() - size);
+    FastGraphics::fillRectAlpha(x, y, size, size, (uint16_t)(i * 0x1234), 128);
+    return (uint32_t)size * size;
+}
+
+static uint32_t opDimScreen(uint32_t i) {
+    (void)i;
+    FastGraphics::dimRect(0, 0, FastGraphics::getWidth(), FastGraphics::getHeight(), 1);
+    return (uint32_t)LCD_H_RES * LCD_V_RES;
+}
+
+static uint16_t bench_image[64 * 64];
+
+static uint32_t opBlitAlpha(uint32_t i) {
+    int16_t x = benchRandom(FastGraphics::getWidth() - 64);
+    int16_t y = benchRandom(FastGraphics::getHeight() - 64);
+    FastGraphics::drawImageAlpha(x, y, bench_image, 64, 64, (uint8_t)(i * 37));
+    return 64 * 64;
+}
+
+static uint32_t opBlit(uint32_t i) {
+    (void)i;
+    int16_t x = benchRandom(FastGraphics::getWidth() - 64);
+    int16_t y = benchRandom(FastGraphics::getHeight() - 64);
+    FastGraphics::drawImage(x, y, bench_image, 64, 64);
+    return 64 * 64;
+}
+
+static uint32_t opLine(uint32_t i) {
+    int16_t x0 = benchRandom(FastGraphics::getWidth()), y0 = benchRandom(FastGraphics::getHeight());
+    int16_t x1 = benchRandom(FastGraphics::getWidth()), y1 = benchRandom(FastGraphics::getHeight());
+    FastGraphics::line(x0, y0, x1, y1, (uint16_t)(i * 0x1234));
+    return max(abs(x1 - x0), abs(y1 - y0)) + 1;
+}
+
+static uint32_t opClippedLine(uint32_t i) {
+    // Long diagonals through a centred param x param clip: only the clip is walked
+    int16_t size = bench_param;
+    int16_t w = FastGraphics::getWidth(), h = FastGraphics::getHeight();
+    FastGraphics::pushClip((w - size) / 2, (h - size) / 2, size, size);
+    FastGraphics::line(-w + benchRandom(w), -h, 2 * w - benchRandom(w), 2 * h, (uint16_t)(i * 0x1234));
+    FastGraphics::popClip();
+    return size;
+}
+
+static uint32_t opCircle(uint32_t i) {
+    int16_t r = bench_param;
+    int16_t x = r + benchRandom(FastGraphics::getWidth() - 2 * r);
+    int16_t y = r + benchRandom(FastGraphics::getHeight() - 2 * r);
+    FastGraphics::circle(x, y, r, (uint16_t)(i * 0x1234));
+    return (uint32_t)(2 * PI * r);
+}
+
+static uint32_t opFillCircle(uint32_t i) {
+    int16_t r = bench_param;
+    int16_t x = r + benchRandom(FastGraphics::getWidth() - 2 * r);
+    int16_t y = r + benchRandom(FastGraphics::getHeight() - 2 * r);
+    FastGraphics::fillCircle(x, y, r, (uint16_t)(i * 0x1234));
+    return (uint32_t)(PI * r * r);
+}
+
+static uint32_t opLineAA(uint32_t i) {
+    int16_t x0 = benchRandom(FastGraphics::getWidth()), y0 = benchRandom(FastGraphics::getHeight());
+    int16_t x1 = benchRandom(FastGraphics::getWidth()), y1 = benchRandom(FastGraphics::getHeight());
+    FastGraphics::lineAA(x0, y0, x1, y1, (uint16_t)(i * 0x1234));
+    return 2 * (max(abs(x1 - x0), abs(y1 - y0)) + 1);
+}
+
+static uint32_t opThickLineAA(uint32_t i) {
+    // Gauge needle: 150 px from a fixed hub at a random angle
+    int16_t thickness = bench_param;
+    int16_t angle = benchRandom(360);
+    int16_t x1 = 400 + (int16_t)(150 * sin(angle * PI / 180));
+    int16_t y1 = 240 - (int16_t)(150 * cos(angle * PI / 180));
+    FastGraphics::thickLineAA(400, 240, x1, y1, thickness, (uint16_t)(i * 0x1234));
+    return (uint32_t)150 * thickness;
+}
+
+static uint32_t opCircleAA(uint32_t i) {
+    int16_t r = bench_param;
+    int16_t x = r + 1 + benchRandom(FastGraphics::getWidth() - 2 * r - 2);
+    int16_t y = r + 1 + benchRandom(FastGraphics::getHeight() - 2 * r - 2);
+    FastGraphics::circleAA(x, y, r, (uint16_t)(i * 0x1234));
+    return (uint32_t)(2 * PI * r);
+}
+
+static uint32_t opFillCircleAA(uint32_t i) {
+    int16_t r = bench_param;
+    int16_t x = r + 1 + benchRandom(FastGraphics::getWidth() - 2 * r - 2);
+    int16_t y = r + 1 + benchRandom(FastGraphics::getHeight() - 2 * r - 2);
+    FastGraphics::fillCircleAA(x, y, r, (uint16_t)(i * 0x1234));
+    return (uint32_t)(PI * r * r);
+}
+
+static uint32_t opArcAA(uint32_t i) {
+    // 270 degree gauge track of radius param, 12 px wide
+    int16_t r = bench_param;
+    FastGraphics::arcAA(400, 240, r, 225, 495, 12, (uint16_t)(i * 0x1234));
+    return (uint32_t)(1.5 * PI * r * 12);
+}
+
+static const char bench_text[] = "The quick brown fox jumps over the lazy dog 0123456789";
+
+static uint32_t opText(uint32_t i) {
+    int16_t size = bench_param;
+    int16_t chars = sizeof(bench_text) - 1;
+    int16_t max_chars = FastGraphics::getWidth() / (8 * size);
+    if (chars > max_chars) chars = max_chars;
+    int16_t y = benchRandom(FastGraphics::getHeight() - 8 * size);
+
+    char line[sizeof(bench_text)];
+    memcpy(line, bench_text, chars);
+    line[chars] = '\0';
+    FastGraphics::text(0, y, line, i & 1 ? COLOR_WHITE : COLOR_YELLOW, COLOR_BLACK, size);
+    return (uint32_t)chars * 64 * size * size;
+}
+
+static uint32_t opPrint(uint32_t i) {
+    // Cursor-based printing of mixed values, including number formatting
+    FastGraphics::setTextSize(bench_param);
+    FastGraphics::setCursor(0, benchRandom(FastGraphics::getHeight() - 8 * bench_param));
+    FastGraphics::print("T=");
+    FastGraphics::print(23.5f + (i & 7), 1);
+    FastGraphics::print(" n=");
+    FastGraphics::print((int)i);
+    return 0;   // Varies with the digits printed, us/op is the figure of interest
+}
+
+static const char bench_paragraph[] =
+    "This demonstrates automatic word wrapping with improved line spacing. "
+    "Long sentences will automatically break at word boundaries to fit within "
+    "the specified width.";
+
+static uint32_t opPrintWrapped(uint32_t i) {
+    FastGraphics::printWrapped(0, benchRandom(FastGraphics::getHeight() / 2), FastGraphics::getWidth() / 2,
+                               bench_paragraph, i & 1 ? COLOR_WHITE : COLOR_CYAN, bench_param);
+    return 0;
+}
+
+static uint32_t opDrawAligned(uint32_t i) {
+    // Right-aligned readout with a changing number of digits, old box cleared by difference
+    static TextBox box = { 0, 0, 0, 0 };
+    if (i == 0) box = { 0, 0, 0, 0 };
+    char buffer[FG_FORMAT_BUFFER_SIZE];
+    FastFormat::formatUnsigned(buffer, (i * 7919) % 100000);
+    box = FastGraphics::drawAligned(FastGraphics::getWidth() - 10, 10, buffer, ALIGN_RIGHT,
+                                    COLOR_WHITE, COLOR_BLACK, bench_param, &box);
+    return (uint32_t)box.w * box.h;
+}
+
+#if !LCD_RUNTIME_PANEL
+// Compile-time geometry: same work as the run-time ops above, on a FixedCanvas
+template <ScreenRotation R>
+static FixedCanvas<LCD_H_RES, LCD_V_RES, R>& fixedCanvas() {
+    static FixedCanvas<LCD_H_RES, LCD_V_RES, R> canvas;
+    canvas.setBuffer(frame_buffer);
+    return canvas;
+}
+
+template <ScreenRotation R>
+static uint32_t opFixedPixel(uint32_t i) {
+    typedef FixedCanvas<LCD_H_RES, LCD_V_RES, R> Canvas;
+    fixedCanvas<R>().pixel(benchRandom(Canvas::getWidth()), benchRandom(Canvas::getHeight()), (uint16_t)(i * 0x1234));
+    return 1;
+}
+
+template <ScreenRotation R>
+static uint32_t opFixedFillRect(uint32_t i) {
+    typedef FixedCanvas<LCD_H_RES, LCD_V_RES, R> Canvas;
+    int16_t size = bench_param;
+    int16_t x = benchRandom(Canvas::getWidth() - size);
+    int16_t y = benchRandom(Canvas::getHeight() - size);
+    fixedCanvas<R>().fillRect(x, y, size, size, (uint16_t)(i * 0x1234));
+    return (uint32_t)size * size;
+}
+
+template <ScreenRotation R>
+static uint32_t opFixedText(uint32_t i) {
+    typedef FixedCanvas<LCD_H_RES, LCD_V_RES, R> Canvas;
+    int16_t size = bench_param;
+    int16_t chars = sizeof(bench_text) - 1;
+    int16_t max_chars = Canvas::getWidth() / (8 * size);
+    if (chars > max_chars) chars = max_chars;
+    int16_t y = benchRandom(Canvas::getHeight() - 8 * size);
+
+    char line[sizeof(bench_text)];
+    memcpy(line, bench_text, chars);
+    line[chars] = '\0';
+    fixedCanvas<R>().text(0, y, line, i & 1 ? COLOR_WHITE : COLOR_YELLOW, COLOR_BLACK, size);
+    return (uint32_t)chars * 64 * size * size;
+}
+#endif
+
+static uint32_t opFlushFull(uint32_t i) {
+    (void)i;
+    FastGraphics::markAllDirty();
+    FastGraphics::flush();
+    return (uint32_t)LCD_H_RES * LCD_V_RES;
+}
+
+static uint32_t opFlushSmall(uint32_t i) {
+    (void)i;
+    FastGraphics::markDirty(benchRandom(FastGraphics::getWidth() - 32), benchRandom(FastGraphics::getHeight() - 32), 32, 32);
+    FastGraphics::flush();
+    return 32 * 32;
+}
+
+// =============================================================================
+// BENCHMARK SUITE
+// =============================================================================
+
+static const ScreenRotation bench_rotations[] = { ROTATION_0, ROTATION_90, ROTATION_180, ROTATION_270 };
+static const int16_t bench_radii[] = { 5, 20, 80, 200 };
+
+/**
+ * @brief Run the FixedCanvas counterparts of pixel, fillRect and text in rotation R
+ * @implementation The screen is set to R as well, so the CSV rotation column matches
+ *                 and the rows compare directly with the run-time ones.
+ * @note A LCD_RUNTIME_PANEL build has no compile-time geometry and runs only the
+ *       run-time ops, for comparison with a fixed build
+ */
+template <ScreenRotation R>
+static void runFixedBench() {
+    FastGraphics::setRotation(R);
+#if !LCD_RUNTIME_PANEL
+    runBench("fixedPixel", 0, 1000, opFixedPixel<R>);
+    runBench("fixedFillRect", 16, 200, opFixedFillRect<R>);
+    runBench("fixedText", 1, 10, opFixedText<R>);
+#endif
+    runBench("pixel", 0, 1000, opPixel);
+    runBench("text", 1, 10, opText);
+}
+
+/**
+ * @brief Run the whole suite once
+ */
+static void runSuite() {
+    Serial.println("# FastGraphics benchmark");
+    Serial.printf("INFO,lcd,%d,%d,pclk_hz,%lu,cpu_mhz,%lu,pie,%d,fbs,%d,runtime_panel,%d\n", LCD_H_RES, LCD_V_RES,
+                  (unsigned long)lcd_pixel_clock_hz(), (unsigned long)getCpuFrequencyMhz(), FG_USE_PIE,
+                  lcd_active_panel()->num_fbs, LCD_RUNTIME_PANEL);
+    Serial.println("# BENCH,test,rotation,param,ops,total_us,us_per_op,mpix_per_s");
+
+    FastGraphics::setTextWrap(false);
+    FastGraphics::setLineSpacing(2);
+
+    for (ScreenRotation rotation : bench_rotations) {
+        FastGraphics::setRotation(rotation);
+        runBench("clear", 0, 1, opClear);
+        runBench("fillRect", 16, 200, opFillRect);
+        runBench("fillRect", 200, 10, opFillRect);
+        runBench("blit", 64, 50, opBlit);
+        runBench("fillRectAlpha", 200, 10, opFillRectAlpha);
+        runBench("dimScreen", 0, 1, opDimScreen);
+        runBench("blitAlpha", 64, 50, opBlitAlpha);
+    }
+    runFixedBench<ROTATION_0>();
+    runFixedBench<ROTATION_90>();
+    
+    // Portrait drawn unrotated, the flush rows include rotating the dirty area
+    if (FastGraphics::setRotateOnFlush(true)) {
+        runBench("fillRectShadow", 16, 200, opFillRect);
+        runBench("fillRectShadow", 200, 10, opFillRect);
+        runBench("textShadow", 1, 10, opText);
+        runBench("flushFullShadow", 0, 1, opFlushFull);
+        runBench("flushSmallShadow", 32, 10, opFlushSmall);
+        FastGraphics::setRotateOnFlush(false);
+    }
+    FastGraphics::setRotation(ROTATION_0);
+
+    if (FastGraphics::setAsync(true)) {
+        runBench("clearAsync", 0, 1, opClearAsync);
+        FastGraphics::setAsync(false);
+    }
+
+    runBench("line", 0, 100, opLine);
+    runBench("clippedLine", 64, 100, opClippedLine);
+    for (int16_t r : bench_radii) {
+        runBench("circle", r, 10, opCircle);
+        runBench("fillCircle", r, 10, opFillCircle);
+        runBench("circleAA", r, 10, opCircleAA);
+        runBench("fillCircleAA", r, 10, opFillCircleAA);
+        runBench("arcAA", r, 5, opArcAA);
+    }
+    runBench("lineAA", 0, 100, opLineAA);
+    runBench("thickLineAA", 3, 20, opThickLineAA);
+    runBench("thickLineAA", 8, 20, opThickLineAA);
+    for (int16_t size = 1; size <= 4; size++) {
+        runBench("text", size, 10, opText);
+    }
+    if (FastGraphics::setGlyphCache(true)) {
+        for (int16_t size = 2; size <= 4; size++) {
+            runBench("textCached", size, 10, opText);
+        }
+        FastGraphics::setGlyphCache(false);
+    }
+    FastGraphics::setTextColor(COLOR_WHITE, COLOR_BLACK);
+    for (int16_t size = 1; size <= 4; size++) {
+        runBench("print", size, 10, opPrint);
+    }
+    runBench("printWrapped", 1, 5, opPrintWrapped);
+    runBench("printWrapped", 2, 5, opPrintWrapped);
+    runBench("drawAligned", 4, 10, opDrawAligned);
+
+    FastGraphics::clear(COLOR_BLACK);
+    runBench("flushFull", 0, 1, opFlushFull);
+    runBench("flushSmall", 32, 10, opFlushSmall);
+
+    Serial.println("DONE");
+
+    FastGraphics::clear(COLOR_BLACK);
+    FastGraphics::text(10, 10, "Benchmark done - results on serial", COLOR_GREEN, COLOR_BLACK, 2);
+    FastGraphics::flush();
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);    // Give the serial monitor time to attach
+
+    if (!initialize_display_and_framebuffer()) {
+        Serial.println("# Display initialization FAILED! Halting.");
+        while (1) {
+            delay(1000);
+        }
+    }
+    FastGraphics::begin(frame_buffer, panel_handle);
+    for (int i = 0; i < 64 * 64; i++) {
+        bench_image[i] = (uint16_t)(i * 0x0841);
+    }
+
+    runSuite();
+}
+
+void loop() {
+    if (Serial.available()) {
+        while (Serial.available()) Serial.read();
+        runSuite();
+    }
+    delay(10);
+}
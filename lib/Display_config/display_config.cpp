@@ -3,63 +3,276 @@
 #include "esp_lcd_panel_rgb.h" // For panel configuration structs and functions
 #include "driver/gpio.h"       // For GPIO_NUM_NC
 #include "esp_heap_caps.h"     // For heap_caps_malloc (for PSRAM)
+#include <Wire.h>              // For lcd_detect_panel()
+#include <string.h>            // For memset
 
 // --- Global Variable Definitions ---
 esp_lcd_panel_handle_t panel_handle = NULL;
 uint16_t *frame_buffer = NULL;
+uint8_t *index_buffer = NULL;
+#if LCD_RUNTIME_PANEL
+int16_t lcd_h_res = 0;          // Set by initialize_display(), before FastGraphics::begin*()
+int16_t lcd_v_res = 0;
+#endif
+
+// --- Panel Presets ---
+#if !LCD_RUNTIME_PANEL
+const lcd_panel_desc_t lcd_panel_build = {
+    "build", LCD_H_RES, LCD_V_RES,
+    { LCD_PIXEL_CLOCK_HZ, LCD_PIXEL_CLOCK_HZ, LCD_PIXEL_CLOCK_HZ },
+    LCD_HSYNC_PULSE_WIDTH, LCD_HSYNC_BACK_PORCH, LCD_HSYNC_FRONT_PORCH,
+    LCD_VSYNC_PULSE_WIDTH, LCD_VSYNC_BACK_PORCH, LCD_VSYNC_FRONT_PORCH,
+    true,
+    PIN_NUM_DE, PIN_NUM_VSYNC, PIN_NUM_HSYNC, PIN_NUM_PCLK,
+    { PIN_NUM_DATA0, PIN_NUM_DATA1, PIN_NUM_DATA2, PIN_NUM_DATA3,
+      PIN_NUM_DATA4, PIN_NUM_DATA5, PIN_NUM_DATA6, PIN_NUM_DATA7,
+      PIN_NUM_DATA8, PIN_NUM_DATA9, PIN_NUM_DATA10, PIN_NUM_DATA11,
+      PIN_NUM_DATA12, PIN_NUM_DATA13, PIN_NUM_DATA14, PIN_NUM_DATA15 },
+    LCD_NUM_FBS, LCD_FB_MODE, LCD_BOUNCE_LINES,
+    -1, -1, 0,
+};
+#endif
+
+// Both Waveshare boards share pins and porches; they differ in the panel glass and in what
+// else sits on the touch I2C bus (GPIO 8/9). PSRAM-direct scanout stays at the 16 MHz the
+// DMA sustains while the CPU draws. The bounce modes take PSRAM out of the scanout path, so
+// there the limit is the panel: 21 MHz (51 Hz refresh) for the 7" glass, 18 MHz (44 Hz)
+// for the 4.3" one.
+const lcd_panel_desc_t lcd_panel_waveshare_7 = {
+    "Waveshare 7\"", 800, 480,
+    { 16 * 1000 * 1000, 21 * 1000 * 1000, 21 * 1000 * 1000 },
+    4, 8, 8,
+    4, 8, 8,
+    true,
+    5, 3, 46, 7,
+    { 14, 38, 18, 17, 10, 39, 0, 45, 48, 47, 21, 1, 2, 42, 41, 40 },
+    LCD_NUM_FBS, LCD_FB_MODE, LCD_BOUNCE_LINES,
+    8, 9, 0,                    // No device of its own, the fallback for the 800x480 boards
+};
+
+const lcd_panel_desc_t lcd_panel_waveshare_4_3b = {
+    "Waveshare 4.3B", 800, 480,
+    { 16 * 1000 * 1000, 18 * 1000 * 1000, 18 * 1000 * 1000 },
+    4, 8, 8,
+    4, 8, 8,
+    true,
+    5, 3, 46, 7,
+    { 14, 38, 18, 17, 10, 39, 0, 45, 48, 47, 21, 1, 2, 42, 41, 40 },
+    LCD_NUM_FBS, LCD_FB_MODE, LCD_BOUNCE_LINES,
+    8, 9, 0x51,                 // PCF85063 RTC, not fitted on the 7" board
+};
+
+const lcd_panel_desc_t *const lcd_panel_presets[] = {
+    &lcd_panel_waveshare_4_3b,
+    &lcd_panel_waveshare_7,
+};
+const int lcd_panel_preset_count = sizeof(lcd_panel_presets) / sizeof(lcd_panel_presets[0]);
+
+// --- Panel State ---
+static lcd_panel_desc_t active_panel;
+static bool panel_active = false;
+static uint32_t pixel_clock_hz = 0;
+
+// --- Bounce Buffer State ---
+static int bounce_lines = 0;
+static lcd_band_renderer_t band_renderer = NULL;
+static void *band_renderer_ctx = NULL;
+
+// Pick the bounce buffer height: long enough that one buffer takes LCD_BOUNCE_TARGET_US
+// to scan out at the chosen pixel clock (fewer refill interrupts), and a divisor of
+// v_res / 2 because the driver requires the frame to be an even number of buffers.
+static int choose_bounce_lines(const lcd_panel_desc_t *panel) {
+    if (panel->fb_mode == LCD_FB_DIRECT) return 0;
+    int lines = panel->bounce_lines;
+    if (lines <= 0) {
+        const uint32_t line_clocks = panel->h_res + panel->hsync_pulse_width + panel->hsync_back_porch + panel->hsync_front_porch;
+        const uint64_t target_clocks = (uint64_t)pixel_clock_hz * LCD_BOUNCE_TARGET_US / 1000000;
+        lines = (int)((target_clocks + line_clocks - 1) / line_clocks);
+        if (lines < 1) lines = 1;
+    }
+    while (lines < panel->v_res / 2 && (panel->v_res % (2 * lines)) != 0) {
+        lines++;
+    }
+    return lines;
+}
+
+// Bounce buffer refill in render-on-the-fly mode (LCD interrupt context).
+// Buffers are whole lines, so pos_px always starts a row.
+static bool IRAM_ATTR on_bounce_empty(esp_lcd_panel_handle_t panel, void *bounce_buf, int pos_px, int len_bytes, void *user_ctx) {
+    uint16_t *band = (uint16_t *)bounce_buf;
+    int lines = len_bytes / (LCD_H_RES * sizeof(uint16_t));
+    if (band_renderer) {
+        band_renderer(band, pos_px / LCD_H_RES, lines, band_renderer_ctx);
+    } else {
+        memset(band, 0, len_bytes);
+    }
+    return false;
+}
+
+void lcd_set_band_renderer(lcd_band_renderer_t renderer, void *user_ctx) {
+    // Context first: the interrupt reads the renderer and then its context
+    band_renderer_ctx = user_ctx;
+    band_renderer = renderer;
+}
+
+int lcd_bounce_buffer_lines() {
+    return bounce_lines;
+}
+
+const lcd_panel_desc_t *lcd_active_panel() {
+    return panel_active ? &active_panel : NULL;
+}
+
+uint32_t lcd_pixel_clock_hz() {
+    return pixel_clock_hz;
+}
+
+// Resolution this build can draw
+static bool resolution_fits(const lcd_panel_desc_t *panel) {
+#if LCD_RUNTIME_PANEL
+    return panel->h_res > 0 && panel->v_res > 0 && panel->h_res <= LCD_MAX_H_RES && panel->v_res <= LCD_MAX_V_RES;
+#else
+    return panel->h_res == LCD_H_RES && panel->v_res == LCD_V_RES;
+#endif
+}
+
+// Reject descriptors this build cannot drive or draw
+static bool check_panel(const lcd_panel_desc_t *panel) {
+#if LCD_RUNTIME_PANEL
+    if (!resolution_fits(panel)) {
+        Serial.printf("Panel %s: %dx%d exceeds LCD_MAX_H_RES x LCD_MAX_V_RES\n", panel->name, panel->h_res, panel->v_res);
+        return false;
+    }
+#else
+    if (!resolution_fits(panel)) {
+        Serial.printf("Panel %s: %dx%d, but built for %dx%d (use LCD_RUNTIME_PANEL)\n",
+                      panel->name, panel->h_res, panel->v_res, LCD_H_RES, LCD_V_RES);
+        return false;
+    }
+#endif
+    if (panel->fb_mode > LCD_FB_NONE || panel->num_fbs < 1 || panel->num_fbs > 2) {
+        Serial.printf("Panel %s: invalid fb_mode or num_fbs\n", panel->name);
+        return false;
+    }
+    if (panel->num_fbs != 1 && (panel->fb_mode == LCD_FB_NONE || LCD_FB_BITS != 16)) {
+        Serial.printf("Panel %s: LCD_FB_NONE and LCD_FB_BITS < 16 need num_fbs 1\n", panel->name);
+        return false;
+    }
+    if (panel->pclk_hz[LCD_FB_DIRECT] == 0) {
+        Serial.printf("Panel %s: no pixel clock\n", panel->name);
+        return false;
+    }
+    return true;
+}
+
+// Probe the board-specific I2C device of each candidate, one bus at a time (the candidates
+// may use different pins); the bus is released again for touch_init().
+const lcd_panel_desc_t *lcd_detect_panel(const lcd_panel_desc_t *const *candidates, int count) {
+    for (int i = 0; i < count; i++) {
+        const lcd_panel_desc_t *panel = candidates[i];
+        if (!panel || !resolution_fits(panel)) continue;
+        if (panel->probe_addr == 0) return panel;
+        if (!Wire.begin(panel->probe_sda_gpio, panel->probe_scl_gpio)) continue;
+        Wire.beginTransmission(panel->probe_addr);
+        bool found = Wire.endTransmission() == 0;
+        Wire.end();
+        if (found) return panel;
+    }
+    return NULL;
+}
 
 bool initialize_display_and_framebuffer() {
-    // Allocate frame buffer
-    // Since panel_config.flags.fb_in_psram = 1, we MUST allocate from PSRAM
-    frame_buffer = (uint16_t*)heap_caps_malloc(LCD_H_RES * LCD_V_RES * sizeof(uint16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_DEFAULT);
+#if LCD_DETECT_PANEL
+    const lcd_panel_desc_t *detected = lcd_detect_panel(lcd_panel_presets, lcd_panel_preset_count);
+    if (detected) {
+        Serial.printf("Detected panel: %s\n", detected->name);
+        return initialize_display(detected);
+    }
+#endif
+    return initialize_display(&LCD_PANEL_DEFAULT);
+}
+
+bool initialize_display(const lcd_panel_desc_t *panel) {
+    if (!panel || panel_active || !check_panel(panel)) return false;
+    active_panel = *panel;
+    panel = &active_panel;
+#if LCD_RUNTIME_PANEL
+    lcd_h_res = panel->h_res;
+    lcd_v_res = panel->v_res;
+#endif
+    pixel_clock_hz = panel->pclk_hz[panel->fb_mode] ? panel->pclk_hz[panel->fb_mode] : panel->pclk_hz[LCD_FB_DIRECT];
+    bounce_lines = choose_bounce_lines(panel);
+    const bool no_fb = panel->fb_mode == LCD_FB_NONE;
     
-    if (!frame_buffer) {
-        Serial.println("Failed to allocate frame buffer in PSRAM!");
+#if LCD_FB_BITS != 16
+    // Allocate the palette index buffer; small ones (1-bit) fit internal SRAM,
+    // which the bounce buffer refill of LCD_FB_NONE reads fastest
+    const size_t index_bytes = (size_t)LCD_H_RES * LCD_V_RES * LCD_FB_BITS / 8;
+    if (index_bytes <= 64 * 1024) {
+        index_buffer = (uint8_t*)heap_caps_malloc(index_bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+    if (!index_buffer) {
+        index_buffer = (uint8_t*)heap_caps_malloc(index_bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    if (!index_buffer) {
+        Serial.println("Failed to allocate index buffer!");
         return false;
     }
+    memset(index_buffer, 0, index_bytes);
+#else
+    if (panel->num_fbs == 1 && !no_fb) {
+        // Allocate frame buffer
+        // Since panel_config.flags.fb_in_psram = 1, we MUST allocate from PSRAM
+        frame_buffer = (uint16_t*)heap_caps_malloc(LCD_H_RES * LCD_V_RES * sizeof(uint16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_DEFAULT);
+        
+        if (!frame_buffer) {
+            Serial.println("Failed to allocate frame buffer in PSRAM!");
+            return false;
+        }
+    }
+#endif
     
     // Configure RGB LCD panel
     esp_lcd_rgb_panel_config_t panel_config = {
         .clk_src = LCD_CLK_SRC_DEFAULT,
         .timings = {
-            .pclk_hz = LCD_PIXEL_CLOCK_HZ,
-            .h_res = LCD_H_RES,
-            .v_res = LCD_V_RES,
-            .hsync_pulse_width = 4,
-            .hsync_back_porch = 8,
-            .hsync_front_porch = 8,
-            .vsync_pulse_width = 4,
-            .vsync_back_porch = 8,
-            .vsync_front_porch = 8,
+            .pclk_hz = pixel_clock_hz,
+            .h_res = panel->h_res,
+            .v_res = panel->v_res,
+            .hsync_pulse_width = panel->hsync_pulse_width,
+            .hsync_back_porch = panel->hsync_back_porch,
+            .hsync_front_porch = panel->hsync_front_porch,
+            .vsync_pulse_width = panel->vsync_pulse_width,
+            .vsync_back_porch = panel->vsync_back_porch,
+            .vsync_front_porch = panel->vsync_front_porch,
             .flags = {
                 .hsync_idle_low = 0,
                 .vsync_idle_low = 0,
                 .de_idle_high = 0,
-                .pclk_active_neg = 1, // As per your original config
+                .pclk_active_neg = panel->pclk_active_neg,
                 .pclk_idle_high = 0,  // As per your original config
             },
         },
         .data_width = 16,
         .bits_per_pixel = 16, // Assuming 16bpp for RGB565
-        .num_fbs = 1,
-        .bounce_buffer_size_px = 0, // No bounce buffer
+        .num_fbs = no_fb ? 0u : panel->num_fbs,
+        .bounce_buffer_size_px = (size_t)bounce_lines * panel->h_res, // 0 = DMA reads the framebuffer directly
         .sram_trans_align = 4,
         .psram_trans_align = 64,
-        .hsync_gpio_num = PIN_NUM_HSYNC,
-        .vsync_gpio_num = PIN_NUM_VSYNC,
-        .de_gpio_num = PIN_NUM_DE,
-        .pclk_gpio_num = PIN_NUM_PCLK,
+        .hsync_gpio_num = panel->hsync_gpio,
+        .vsync_gpio_num = panel->vsync_gpio,
+        .de_gpio_num = panel->de_gpio,
+        .pclk_gpio_num = panel->pclk_gpio,
         .disp_gpio_num = GPIO_NUM_NC, // No dedicated display enable/disable if not used
-        .data_gpio_nums = {
-            PIN_NUM_DATA0, PIN_NUM_DATA1, PIN_NUM_DATA2, PIN_NUM_DATA3,
-            PIN_NUM_DATA4, PIN_NUM_DATA5, PIN_NUM_DATA6, PIN_NUM_DATA7,
-            PIN_NUM_DATA8, PIN_NUM_DATA9, PIN_NUM_DATA10, PIN_NUM_DATA11,
-            PIN_NUM_DATA12, PIN_NUM_DATA13, PIN_NUM_DATA14, PIN_NUM_DATA15,
-        },
+        .data_gpio_nums = {},
         .flags = {
-            .fb_in_psram = 1, // Frame buffer is in PSRAM
+            .fb_in_psram = !no_fb, // Frame buffer is in PSRAM
+            .no_fb = no_fb,        // Render on the fly into the bounce buffers
         },
     };
+    for (int i = 0; i < 16; i++) {
+        panel_config.data_gpio_nums[i] = panel->data_gpio[i];
+    }
     
     // Install RGB LCD panel driver
     esp_err_t ret;
@@ -69,6 +282,16 @@ bool initialize_display_and_framebuffer() {
         return false;
     }
     
+    if (no_fb) {
+        esp_lcd_rgb_panel_event_callbacks_t callbacks = {};
+        callbacks.on_bounce_empty = on_bounce_empty;
+        ret = esp_lcd_rgb_panel_register_event_callbacks(panel_handle, &callbacks, NULL);
+        if (ret != ESP_OK) {
+            Serial.printf("esp_lcd_rgb_panel_register_event_callbacks failed: %s\n", esp_err_to_name(ret));
+            return false;
+        }
+    }
+    
     ret = esp_lcd_panel_reset(panel_handle);
     if (ret != ESP_OK) {
         Serial.printf("esp_lcd_panel_reset failed: %s\n", esp_err_to_name(ret));
@@ -81,6 +304,22 @@ bool initialize_display_and_framebuffer() {
         return false;
     }
     
-    Serial.println("Display initialized successfully.");
+    if (panel->num_fbs == 2) {
+        // Double buffering: the driver owns both buffers, expose the initial back buffer
+        void *fb0 = NULL, *fb1 = NULL;
+        ret = esp_lcd_rgb_panel_get_frame_buffer(panel_handle, 2, &fb0, &fb1);
+        if (ret != ESP_OK) {
+            Serial.printf("esp_lcd_rgb_panel_get_frame_buffer failed: %s\n", esp_err_to_name(ret));
+            return false;
+        }
+        frame_buffer = (uint16_t*)fb1;
+    }
+    
+    panel_active = true;
+    if (bounce_lines > 0) {
+        Serial.printf("Bounce buffers: 2 x %d lines in internal SRAM\n", bounce_lines);
+    }
+    Serial.printf("Display initialized successfully: %s, %dx%d at %lu Hz.\n", panel->name,
+                  panel->h_res, panel->v_res, (unsigned long)pixel_clock_hz);
     return true;
-}
\ No newline at end of file
+}
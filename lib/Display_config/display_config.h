@@ -5,11 +5,91 @@
 #include "esp_lcd_panel_ops.h" // For esp_lcd_panel_handle_t
 
 // --- Display Configuration ---
+// Fixed builds drive the panel below (lcd_panel_build). With -DLCD_RUNTIME_PANEL=1 the
+// panel is a descriptor passed to initialize_display() instead, e.g. one of the presets
+// at the end of this file, and LCD_H_RES / LCD_V_RES become its run-time resolution.
 #define LCD_PIXEL_CLOCK_HZ     (16 * 1000 * 1000)
 #define LCD_BK_LIGHT_ON_LEVEL  1
 #define LCD_BK_LIGHT_OFF_LEVEL !LCD_BK_LIGHT_ON_LEVEL
+#ifndef LCD_RUNTIME_PANEL
+#define LCD_RUNTIME_PANEL 0
+#endif
+#if LCD_RUNTIME_PANEL
+extern int16_t lcd_h_res;              // Set by initialize_display()
+extern int16_t lcd_v_res;
+#define LCD_H_RES              ((int)lcd_h_res)
+#define LCD_V_RES              ((int)lcd_v_res)
+#else
+#ifndef LCD_H_RES
 #define LCD_H_RES              800
+#endif
+#ifndef LCD_V_RES
 #define LCD_V_RES              480
+#endif
+#endif
+
+// Largest panel a LCD_RUNTIME_PANEL build accepts (sizes static tables such as FG_HIT_GRID)
+#ifndef LCD_MAX_H_RES
+#if LCD_RUNTIME_PANEL
+#define LCD_MAX_H_RES 1024
+#define LCD_MAX_V_RES 600
+#else
+#define LCD_MAX_H_RES LCD_H_RES
+#define LCD_MAX_V_RES LCD_V_RES
+#endif
+#endif
+
+// --- Panel Timing (pixel clocks / lines) ---
+#define LCD_HSYNC_PULSE_WIDTH  4
+#define LCD_HSYNC_BACK_PORCH   8
+#define LCD_HSYNC_FRONT_PORCH  8
+#define LCD_VSYNC_PULSE_WIDTH  4
+#define LCD_VSYNC_BACK_PORCH   8
+#define LCD_VSYNC_FRONT_PORCH  8
+
+// Number of framebuffers owned by the RGB driver:
+// 1 = library draws into its own PSRAM buffer, flush() copies changes to the driver
+// 2 = driver owns front/back buffers, use FastGraphics::beginDoubleBuffered()
+#ifndef LCD_NUM_FBS
+#define LCD_NUM_FBS            1
+#endif
+
+// Scanout mode:
+// LCD_FB_DIRECT = LCD DMA reads the PSRAM framebuffer directly (competes with drawing for PSRAM)
+// LCD_FB_BOUNCE = DMA reads two small internal-SRAM bounce buffers, refilled from PSRAM by the CPU
+// LCD_FB_NONE   = no framebuffer at all ("render on the fly"): bounce buffers are filled by the
+//                 band renderer set with lcd_set_band_renderer(); saves LCD_H_RES*LCD_V_RES*2 bytes of PSRAM
+#define LCD_FB_DIRECT          0
+#define LCD_FB_BOUNCE          1
+#define LCD_FB_NONE            2
+#ifndef LCD_FB_MODE
+#define LCD_FB_MODE            LCD_FB_DIRECT
+#endif
+
+// Bounce buffer height in lines (LCD_FB_BOUNCE / LCD_FB_NONE); 0 = derive from the pixel clock
+// so one buffer takes at least LCD_BOUNCE_TARGET_US to scan out
+#ifndef LCD_BOUNCE_LINES
+#define LCD_BOUNCE_LINES       0
+#endif
+#ifndef LCD_BOUNCE_TARGET_US
+#define LCD_BOUNCE_TARGET_US   500
+#endif
+
+// Bits per pixel of the drawing buffer: 16 = RGB565 frame_buffer, 8/4/1 = palette indices
+// in index_buffer for FastGraphics::beginIndexed() (no frame_buffer is allocated then)
+#ifndef LCD_FB_BITS
+#define LCD_FB_BITS            16
+#endif
+
+#if LCD_FB_MODE == LCD_FB_NONE && LCD_NUM_FBS != 1
+#error "LCD_FB_NONE has no framebuffers, leave LCD_NUM_FBS at 1"
+#endif
+#if LCD_FB_BITS != 16 && LCD_FB_BITS != 8 && LCD_FB_BITS != 4 && LCD_FB_BITS != 1
+#error "LCD_FB_BITS must be 16, 8, 4 or 1"
+#endif
+#if LCD_FB_BITS != 16 && LCD_NUM_FBS != 1
+#error "Palettised drawing (LCD_FB_BITS < 16) copies into one panel framebuffer, leave LCD_NUM_FBS at 1"
+#endif
 
 // --- RGB Pin Definitions ---
 #define PIN_NUM_DE             5
@@ -33,11 +113,104 @@
 #define PIN_NUM_DATA14         41  // R3
 #define PIN_NUM_DATA15         40  // R4
 
+// --- Panel Descriptor ---
+// Everything initialize_display() needs to drive one RGB panel. The pixel clock is
+// tuned per scanout mode: bounce buffers (and no framebuffer at all) take PSRAM out of
+// the scanout path, so those modes run faster panels without underruns.
+typedef struct {
+    const char *name;
+    uint16_t h_res;
+    uint16_t v_res;
+    uint32_t pclk_hz[3];               // Fastest stable pixel clock, indexed by LCD_FB_MODE
+                                       // (0 = use pclk_hz[LCD_FB_DIRECT])
+    uint16_t hsync_pulse_width;
+    uint16_t hsync_back_porch;
+    uint16_t hsync_front_porch;
+    uint16_t vsync_pulse_width;
+    uint16_t vsync_back_porch;
+    uint16_t vsync_front_porch;
+    bool pclk_active_neg;              // Data latched on the falling PCLK edge
+    int8_t de_gpio;
+    int8_t vsync_gpio;
+    int8_t hsync_gpio;
+    int8_t pclk_gpio;
+    int8_t data_gpio[16];              // B0-B4, G0-G5, R0-R4
+    uint8_t num_fbs;                   // As LCD_NUM_FBS
+    uint8_t fb_mode;                   // As LCD_FB_MODE
+    uint16_t bounce_lines;             // As LCD_BOUNCE_LINES (0 = derive from the pixel clock)
+    int8_t probe_sda_gpio;             // I2C bus of the device that identifies the board
+    int8_t probe_scl_gpio;
+    uint8_t probe_addr;                // 7-bit address lcd_detect_panel() expects an ACK from
+                                       // (0 = always matches)
+} lcd_panel_desc_t;
+
+// Presets; scanout options (num_fbs, fb_mode, bounce_lines) default to the build flags.
+// Copy one and change those fields to pick another scanout mode.
+#if !LCD_RUNTIME_PANEL
+extern const lcd_panel_desc_t lcd_panel_build;          // The #defines above
+#endif
+extern const lcd_panel_desc_t lcd_panel_waveshare_7;    // Waveshare ESP32-S3-Touch-LCD-7, 800x480
+extern const lcd_panel_desc_t lcd_panel_waveshare_4_3b; // Waveshare ESP32-S3-Touch-LCD-4.3B, 800x480
+
+// Candidates of initialize_display_and_framebuffer() with LCD_DETECT_PANEL, most specific
+// probe first; the last one matches any board
+extern const lcd_panel_desc_t *const lcd_panel_presets[];
+extern const int lcd_panel_preset_count;
+
+// Panel of initialize_display_and_framebuffer() (the fallback with LCD_DETECT_PANEL)
+#ifndef LCD_PANEL_DEFAULT
+#if LCD_RUNTIME_PANEL
+#define LCD_PANEL_DEFAULT      lcd_panel_waveshare_7
+#else
+#define LCD_PANEL_DEFAULT      lcd_panel_build
+#endif
+#endif
+
+// 1 = initialize_display_and_framebuffer() picks the board from lcd_panel_presets first,
+// so one firmware image runs each supported board with its own pixel clocks
+#ifndef LCD_DETECT_PANEL
+#define LCD_DETECT_PANEL       LCD_RUNTIME_PANEL
+#endif
+
 // --- Global Variable Declarations (defined in display_config.cpp) ---
 extern esp_lcd_panel_handle_t panel_handle;
-extern uint16_t *frame_buffer;
+extern uint16_t *frame_buffer; // With LCD_NUM_FBS 2: the driver's second (initial back) buffer
+                               // With LCD_FB_NONE: NULL, draw through the band renderer instead
+                               // With LCD_FB_BITS < 16: NULL, draw into index_buffer instead
+extern uint8_t *index_buffer;  // With LCD_FB_BITS < 16: LCD_H_RES*LCD_V_RES*LCD_FB_BITS/8 bytes, else NULL
+
+// --- Band Renderer (LCD_FB_NONE) ---
+// Fills `lines` full rows starting at row `y` into `band` (LCD_H_RES pixels per row).
+// Called from the LCD interrupt: keep it short, no blocking calls, and put it in IRAM
+// if flash cache may be disabled (e.g. during flash writes). The interrupt does not save
+// the ESP32-S3 vector (PIE) registers, so it must not use PIE either: call FastKernels
+// only between FastKernels::beginScalar() and endScalar(), as FastGraphics::renderBand() does.
+typedef void (*lcd_band_renderer_t)(uint16_t *band, int y, int lines, void *user_ctx);
+
+// --- Function Prototypes ---
+bool initialize_display_and_framebuffer(); // initialize_display(&LCD_PANEL_DEFAULT), or of the
+                                           // detected preset with LCD_DETECT_PANEL
+
+// First of `count` candidates whose probe device ACKs on its I2C bus and whose resolution
+// this build can draw; NULL if none does. Leaves the bus released: call before touch_init().
+const lcd_panel_desc_t *lcd_detect_panel(const lcd_panel_desc_t *const *candidates, int count);
+
+// Bring up the panel of a descriptor (copied) and allocate frame_buffer / index_buffer.
+// Fails for a resolution the build cannot draw: another one than LCD_H_RES x LCD_V_RES in
+// fixed builds, one above LCD_MAX_H_RES x LCD_MAX_V_RES with LCD_RUNTIME_PANEL.
+// Call once, before FastGraphics::begin*().
+bool initialize_display(const lcd_panel_desc_t *panel);
+
+// Descriptor in use after initialize_display(), NULL before
+const lcd_panel_desc_t *lcd_active_panel();
+
+// Pixel clock chosen at init for the descriptor's scanout mode
+uint32_t lcd_pixel_clock_hz();
+
+// Set the function that renders bounce buffer bands in LCD_FB_NONE mode (NULL = black)
+void lcd_set_band_renderer(lcd_band_renderer_t renderer, void *user_ctx);
 
-// --- Function Prototype for Display Initialization ---
-bool initialize_display_and_framebuffer();
+// Bounce buffer height chosen at init, in lines (0 in LCD_FB_DIRECT mode)
+int lcd_bounce_buffer_lines();
 
 #endif // DISPLAY_CONFIG_H
\ No newline at end of file
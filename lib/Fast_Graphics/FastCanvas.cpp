@@ -0,0 +1,1668 @@
+// FastCanvas.cpp - Drawing surface implementation
+// Every pixel FastGraphics writes goes through these primitives
+
+#include "FastCanvas.h"
+#include "FastKernels.h"
+#include "FastDMA.h"
+#include "FastGlyphCache.h"
+#include "FastImage.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if FG_PROFILE
+#define FG_PROFILE_PIXELS(n)        (FastCanvas::pixels_written += (n))
+#else
+#define FG_PROFILE_PIXELS(n)        ((void)0)
+#endif
+
+// =============================================================================
+// STATIC VARIABLES
+// =============================================================================
+
+#if FG_PROFILE
+uint32_t FastCanvas::pixels_written = 0;
+#endif
+
+/**
+ * @brief 8x8 pixel font bitmap data
+ * @details Contains bitmap data for ASCII characters 0-127. Each character is
+ *          defined as 8 bytes representing 8 rows of 8 pixels each.
+ * @note Bit 0 = leftmost pixel, bit 7 = rightmost pixel in each row
+ */
+const uint8_t font8x8_basic[128][8] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0000 (nul)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0001
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0002
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0003
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0004
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0005
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0006
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0007
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0008
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0009
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+000A
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+000B
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+000C
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+000D
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+000E
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+000F
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0010
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0011
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0012
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0013
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0014
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0015
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0016
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0017
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0018
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0019
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+001A
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+001B
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+001C
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+001D
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+001E
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+001F
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0020 (space)
+    { 0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00},   // U+0021 (!)
+    { 0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0022 (")
+    { 0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00},   // U+0023 (#)
+    { 0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00},   // U+0024 ($)
+    { 0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00},   // U+0025 (%)
+    { 0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00},   // U+0026 (&)
+    { 0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0027 (')
+    { 0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00},   // U+0028 (()
+    { 0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00},   // U+0029 ())
+    { 0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00},   // U+002A (*)
+    { 0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00},   // U+002B (+)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x06, 0x00},   // U+002C (,)
+    { 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00},   // U+002D (-)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00},   // U+002E (.)
+    { 0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00},   // U+002F (/)
+    { 0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00},   // U+0030 (0)
+    { 0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00},   // U+0031 (1)
+    { 0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00},   // U+0032 (2)
+    { 0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00},   // U+0033 (3)
+    { 0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00},   // U+0034 (4)
+    { 0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00},   // U+0035 (5)
+    { 0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00},   // U+0036 (6)
+    { 0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00},   // U+0037 (7)
+    { 0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00},   // U+0038 (8)
+    { 0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00},   // U+0039 (9)
+    { 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00},   // U+003A (:)
+    { 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x06, 0x00},   // U+003B (;)
+    { 0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00},   // U+003C (<)
+    { 0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00},   // U+003D (=)
+    { 0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00},   // U+003E (>)
+    { 0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00},   // U+003F (?)
+    { 0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00},   // U+0040 (@)
+    { 0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00},   // U+0041 (A)
+    { 0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00},   // U+0042 (B)
+    { 0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00},   // U+0043 (C)
+    { 0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00},   // U+0044 (D)
+    { 0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00},   // U+0045 (E)
+    { 0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00},   // U+0046 (F)
+    { 0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00},   // U+0047 (G)
+    { 0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00},   // U+0048 (H)
+    { 0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},   // U+0049 (I)
+    { 0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00},   // U+004A (J)
+    { 0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00},   // U+004B (K)
+    { 0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00},   // U+004C (L)
+    { 0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00},   // U+004D (M)
+    { 0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00},   // U+004E (N)
+    { 0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00},   // U+004F (O)
+    { 0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00},   // U+0050 (P)
+    { 0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00},   // U+0051 (Q)
+    { 0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00},   // U+0052 (R)
+    { 0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00},   // U+0053 (S)
+    { 0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},   // U+0054 (T)
+    { 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00},   // U+0055 (U)
+    { 0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00},   // U+0056 (V)
+    { 0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00},   // U+0057 (W)
+    { 0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00},   // U+0058 (X)
+    { 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00},   // U+0059 (Y)
+    { 0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00},   // U+005A (Z)
+    { 0x1E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1E, 0x00},   // U+005B ([)
+    { 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00},   // U+005C (\)
+    { 0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x00},   // U+005D (])
+    { 0x08, 0x1C, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00},   // U+005E (^)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF},   // U+005F (_)
+    { 0x0C, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0060 (`)
+    { 0x00, 0x00, 0x1E, 0x30, 0x3E, 0x33, 0x6E, 0x00},   // U+0061 (a)
+    { 0x07, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x3B, 0x00},   // U+0062 (b)
+    { 0x00, 0x00, 0x1E, 0x33, 0x03, 0x33, 0x1E, 0x00},   // U+0063 (c)
+    { 0x38, 0x30, 0x30, 0x3e, 0x33, 0x33, 0x6E, 0x00},   // U+0064 (d)
+    { 0x00, 0x00, 0x1E, 0x33, 0x3f, 0x03, 0x1E, 0x00},   // U+0065 (e)
+    { 0x1C, 0x36, 0x06, 0x0f, 0x06, 0x06, 0x0F, 0x00},   // U+0066 (f)
+    { 0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x1F},   // U+0067 (g)
+    { 0x07, 0x06, 0x36, 0x6E, 0x66, 0x66, 0x67, 0x00},   // U+0068 (h)
+    { 0x0C, 0x00, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},   // U+0069 (i)
+    { 0x30, 0x00, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E},   // U+006A (j)
+    { 0x07, 0x06, 0x66, 0x36, 0x1E, 0x36, 0x67, 0x00},   // U+006B (k)
+    { 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},   // U+006C (l)
+    { 0x00, 0x00, 0x33, 0x7F, 0x7F, 0x6B, 0x63, 0x00},   // U+006D (m)
+    { 0x00, 0x00, 0x1F, 0x33, 0x33, 0x33, 0x33, 0x00},   // U+006E (n)
+    { 0x00, 0x00, 0x1E, 0x33, 0x33, 0x33, 0x1E, 0x00},   // U+006F (o)
+    { 0x00, 0x00, 0x3B, 0x66, 0x66, 0x3E, 0x06, 0x0F},   // U+0070 (p)
+    { 0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x78},   // U+0071 (q)
+    { 0x00, 0x00, 0x3B, 0x6E, 0x66, 0x06, 0x0F, 0x00},   // U+0072 (r)
+    { 0x00, 0x00, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x00},   // U+0073 (s)
+    { 0x08, 0x0C, 0x3E, 0x0C, 0x0C, 0x2C, 0x18, 0x00},   // U+0074 (t)
+    { 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x6E, 0x00},   // U+0075 (u)
+    { 0x00, 0x00, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00},   // U+0076 (v)
+    { 0x00, 0x00, 0x63, 0x6B, 0x7F, 0x7F, 0x36, 0x00},   // U+0077 (w)
+    { 0x00, 0x00, 0x63, 0x36, 0x1C, 0x36, 0x63, 0x00},   // U+0078 (x)
+    { 0x00, 0x00, 0x33, 0x33, 0x33, 0x3E, 0x30, 0x1F},   // U+0079 (y)
+    { 0x00, 0x00, 0x3F, 0x19, 0x0C, 0x26, 0x3F, 0x00},   // U+007A (z)
+    { 0x38, 0x0C, 0x0C, 0x07, 0x0C, 0x0C, 0x38, 0x00},   // U+007B ({)
+    { 0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00},   // U+007C (|)
+    { 0x07, 0x0C, 0x0C, 0x38, 0x0C, 0x0C, 0x07, 0x00},   // U+007D (})
+    { 0x6E, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+007E (~)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}    // U+007F
+};
+
+/**
+ * @brief Expanded glyph rows for the current text colors
+ * @details Each entry holds the 4 RGB565 pixels for one nibble of a font row
+ *          (bit 0 = leftmost pixel), so an 8-pixel row is two table lookups.
+ *          Rebuilt only when the foreground/background pair changes.
+ */
+static union {
+    uint16_t px[16][4];
+    uint32_t pair[16][2];
+} glyph_lut;
+static uint16_t glyph_lut_fg = 0;
+static uint16_t glyph_lut_bg = 0;
+static bool glyph_lut_valid = false;
+
+static void prepareGlyphLut(uint16_t color, uint16_t bg) {
+    if (glyph_lut_valid && glyph_lut_fg == color && glyph_lut_bg == bg) return;
+    for (uint8_t n = 0; n < 16; n++) {
+        for (uint8_t bit = 0; bit < 4; bit++) {
+            glyph_lut.px[n][bit] = (n & (1 << bit)) ? color : bg;
+        }
+    }
+    glyph_lut_fg = color;
+    glyph_lut_bg = bg;
+    glyph_lut_valid = true;
+}
+
+// =============================================================================
+// CANVAS SETUP
+// =============================================================================
+
+FastCanvas::FastCanvas()
+    : pixels(nullptr), buffer_width(0), buffer_height(0), stride(0), row0(0), row1(0),
+      rotation(ROTATION_0), width(0), height(0), clip_x0(0), clip_y0(0), clip_x1(INT16_MAX), clip_y1(INT16_MAX),
+      vis_x0(0), vis_y0(0), vis_x1(0), vis_y1(0), glyph_cache(nullptr), async(false), owned(false) {}
+
+FastCanvas::FastCanvas(uint16_t* buffer, int16_t width, int16_t height, int16_t stride)
+    : FastCanvas() {
+    setBuffer(buffer, width, height, stride);
+}
+
+FastCanvas::~FastCanvas() {
+    end();
+}
+
+/**
+ * @brief Allocate a buffer for the canvas
+ * @implementation Rows are packed (stride == width), so full-width fills and copies
+ *                 of the whole canvas are single runs.
+ */
+bool FastCanvas::begin(int16_t width, int16_t height, uint32_t caps) {
+    end();
+    if (width <= 0 || height <= 0) return false;
+    uint16_t* buffer = (uint16_t*)heap_caps_malloc((size_t)width * height * sizeof(uint16_t), caps);
+    if (!buffer) return false;
+    setBuffer(buffer, width, height);
+    owned = true;
+    return true;
+}
+
+void FastCanvas::end() {
+    if (async) FastDMA::waitIdle();  // Transfers may still target the buffer
+    if (owned) heap_caps_free(pixels);
+    owned = false;
+    setBuffer(nullptr, 0, 0);
+}
+
+void FastCanvas::setBuffer(uint16_t* buffer, int16_t width, int16_t height, int16_t stride) {
+    pixels = buffer;
+    buffer_width = width;
+    buffer_height = height;
+    this->stride = stride > 0 ? stride : width;
+    row0 = 0;
+    row1 = height;
+    setRotation(rotation);
+}
+
+void FastCanvas::setRows(uint16_t* rows, int16_t row0, int16_t row1) {
+    pixels = rows;
+    this->row0 = row0;
+    this->row1 = row1;
+    updateVisible();
+}
+
+/**
+ * @brief Set the canvas rotation
+ * @implementation Updates rotation state and recalculates the logical dimensions.
+ *                 Portrait rotations swap width and height values.
+ */
+void FastCanvas::setRotation(ScreenRotation rotation) {
+    this->rotation = rotation;
+    switch (rotation) {
+        case ROTATION_90:
+        case ROTATION_270:
+            width = buffer_height;
+            height = buffer_width;
+            break;
+        default:
+            width = buffer_width;
+            height = buffer_height;
+            break;
+    }
+    updateVisible();
+}
+
+/**
+ * @brief Enable or disable DMA offloading for this canvas
+ * @implementation Installs the FastDMA driver on first use. Disabling waits for the
+ *                 queue so no transfer outlives async mode.
+ */
+bool FastCanvas::setAsync(bool enable) {
+    if (!enable) {
+        if (async) FastDMA::waitIdle();
+        async = false;
+        return true;
+    }
+    if (!FastDMA::begin()) return false;
+    async = true;
+    return true;
+}
+
+// =============================================================================
+// CLIPPING
+// =============================================================================
+
+void FastCanvas::setClip(int16_t x, int16_t y, int16_t w, int16_t h) {
+    clip_x0 = x;
+    clip_y0 = y;
+    clip_x1 = w > 0 ? x + w : x;
+    clip_y1 = h > 0 ? y + h : y;
+    updateVisible();
+}
+
+void FastCanvas::resetClip() {
+    clip_x0 = 0;
+    clip_y0 = 0;
+    clip_x1 = INT16_MAX;
+    clip_y1 = INT16_MAX;
+    updateVisible();
+}
+
+bool FastCanvas::getClip(int16_t& x, int16_t& y, int16_t& w, int16_t& h) const {
+    x = vis_x0;
+    y = vis_y0;
+    w = vis_x1 > vis_x0 ? vis_x1 - vis_x0 : 0;
+    h = vis_y1 > vis_y0 ? vis_y1 - vis_y0 : 0;
+    return w > 0 && h > 0;
+}
+
+/**
+ * @brief Recompute the visible area
+ * @implementation Buffer row py is logical y in ROTATION_0, H-1-y in 180, x in 90
+ *                 and H-1-x in 270, so the rows [row0, row1) are one logical
+ *                 interval on one axis. The result is kept as one logical
+ *                 rectangle, which is all clip(), outcode() and plot() compare with.
+ */
+void FastCanvas::updateVisible() {
+    int16_t x0 = clip_x0 > 0 ? clip_x0 : 0;
+    int16_t y0 = clip_y0 > 0 ? clip_y0 : 0;
+    int16_t x1 = clip_x1 < width ? clip_x1 : width;
+    int16_t y1 = clip_y1 < height ? clip_y1 : height;
+    
+    switch (rotation) {
+        case ROTATION_90:
+            if (x0 < row0) x0 = row0;
+            if (x1 > row1) x1 = row1;
+            break;
+        case ROTATION_180:
+            if (y0 < buffer_height - row1) y0 = buffer_height - row1;
+            if (y1 > buffer_height - row0) y1 = buffer_height - row0;
+            break;
+        case ROTATION_270:
+            if (x0 < buffer_height - row1) x0 = buffer_height - row1;
+            if (x1 > buffer_height - row0) x1 = buffer_height - row0;
+            break;
+        default:
+            if (y0 < row0) y0 = row0;
+            if (y1 > row1) y1 = row1;
+            break;
+    }
+    
+    // An empty area stays empty in every comparison
+    if (x1 < x0) x1 = x0;
+    if (y1 < y0) y1 = y0;
+    vis_x0 = x0;
+    vis_y0 = y0;
+    vis_x1 = x1;
+    vis_y1 = y1;
+}
+
+/**
+ * @brief Clip a logical rectangle to the visible area
+ * @implementation Four compares against the rectangle kept by updateVisible().
+ */
+bool FastCanvas::clip(int16_t& x0, int16_t& y0, int16_t& x1, int16_t& y1) const {
+    if (x0 < vis_x0) x0 = vis_x0;
+    if (y0 < vis_y0) y0 = vis_y0;
+    if (x1 > vis_x1) x1 = vis_x1;
+    if (y1 > vis_y1) y1 = vis_y1;
+    return x0 < x1 && y0 < y1;
+}
+
+inline uint8_t FastCanvas::outcode(int16_t x, int16_t y) const {
+    return (x < vis_x0 ? 1 : 0) | (x >= vis_x1 ? 2 : 0) | (y < vis_y0 ? 4 : 0) | (y >= vis_y1 ? 8 : 0);
+}
+
+// =============================================================================
+// COORDINATE MAPPING
+// =============================================================================
+
+/**
+ * @brief Transform logical coordinates to buffer coordinates
+ * @implementation Applies rotation matrix transformations to convert from logical
+ *                 canvas coordinates to buffer coordinates (W x H buffer).
+ * @details For each rotation:
+ *          - ROTATION_0: No transformation (x=x, y=y)
+ *          - ROTATION_90: x'=W-1-y, y'=x
+ *          - ROTATION_180: x'=W-1-x, y'=H-1-y
+ *          - ROTATION_270: x'=y, y'=H-1-x
+ */
+void FastCanvas::transformCoordinates(int16_t& x, int16_t& y) const {
+    int16_t temp_x = x;
+    int16_t temp_y = y;
+    
+    switch (rotation) {
+        case ROTATION_0:   // No rotation
+            // x = x, y = y (no change)
+            break;
+            
+        case ROTATION_90:  // 90° clockwise (portrait)
+            x = buffer_width - 1 - temp_y;
+            y = temp_x;
+            break;
+            
+        case ROTATION_180: // 180° (landscape flipped)
+            x = buffer_width - 1 - temp_x;
+            y = buffer_height - 1 - temp_y;
+            break;
+            
+        case ROTATION_270: // 270° clockwise (portrait flipped)
+            x = temp_y;
+            y = buffer_height - 1 - temp_x;
+            break;
+    }
+}
+
+/**
+ * @brief Transform a logical rectangle to its buffer rectangle
+ * @implementation Same mapping as transformCoordinates() applied to the rectangle's
+ *                 extent. Portrait rotations swap width and height.
+ * @details For each rotation:
+ *          - ROTATION_0: No transformation
+ *          - ROTATION_90: x'=W-y-h, y'=x, w'=h, h'=w
+ *          - ROTATION_180: x'=W-x-w, y'=H-y-h
+ *          - ROTATION_270: x'=y, y'=H-x-w, w'=h, h'=w
+ */
+void FastCanvas::transformRect(int16_t& x, int16_t& y, int16_t& w, int16_t& h) const {
+    int16_t temp_x = x;
+    int16_t temp_y = y;
+    int16_t temp_w = w;
+    
+    switch (rotation) {
+        case ROTATION_0:   // No rotation
+            break;
+            
+        case ROTATION_90:  // 90° clockwise (portrait)
+            x = buffer_width - temp_y - h;
+            y = temp_x;
+            w = h;
+            h = temp_w;
+            break;
+            
+        case ROTATION_180: // 180° (landscape flipped)
+            x = buffer_width - temp_x - w;
+            y = buffer_height - temp_y - h;
+            break;
+            
+        case ROTATION_270: // 270° clockwise (portrait flipped)
+            x = temp_y;
+            y = buffer_height - temp_x - w;
+            w = h;
+            h = temp_w;
+            break;
+    }
+}
+
+/**
+ * @brief Get the buffer address of a logical pixel and the rotation steps
+ * @implementation Folds transformCoordinates() into an address plus two strides:
+ *                 moving +1 in logical x or y always moves a fixed number of
+ *                 pixels in the buffer, whatever the rotation.
+ */
+uint16_t* FastCanvas::physicalAddress(int16_t x, int16_t y, int32_t& step_x, int32_t& step_y) const {
+    switch (rotation) {
+        case ROTATION_90:  step_x = stride;  step_y = -1;      break;
+        case ROTATION_180: step_x = -1;      step_y = -stride; break;
+        case ROTATION_270: step_x = -stride; step_y = 1;       break;
+        default:           step_x = 1;       step_y = stride;  break;
+    }
+    transformCoordinates(x, y);
+    return &pixels[(int32_t)(y - row0) * stride + x];
+}
+
+/**
+ * @brief Wait for DMA transfers overlapping a logical rectangle
+ * @implementation Tests the buffer byte range from the first to the last pixel of
+ *                 the rectangle's buffer bounding box, so disjoint rows never wait.
+ */
+void FastCanvas::dmaFence(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (!async || !FastDMA::isBusy()) return;
+    int16_t x1 = x + w, y1 = y + h;
+    if (!clip(x, y, x1, y1)) return;
+    w = x1 - x;
+    h = y1 - y;
+    transformRect(x, y, w, h);
+    FastDMA::waitFor(&pixels[(int32_t)(y - row0) * stride + x],
+                     ((size_t)(h - 1) * stride + w) * sizeof(uint16_t));
+}
+
+// =============================================================================
+// DRAWING FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Division rounded towards minus / plus infinity (d > 0)
+ */
+static inline int64_t floorDiv(int64_t n, int64_t d) { return n >= 0 ? n / d : -((d - 1 - n) / d); }
+static inline int64_t ceilDiv(int64_t n, int64_t d) { return n >= 0 ? (n + d - 1) / d : -(-n / d); }
+
+
+/**
+ * @brief Draw a single pixel with bounds checking and rotation
+ * @implementation One check against the visible area, which already accounts for
+ *                 the rows held and the clip rectangle, then the transformation.
+ * @performance O(1) operation with minimal overhead for bounds checking
+ */
+inline void FastCanvas::plot(int16_t x, int16_t y, uint16_t color) {
+    if (x >= vis_x0 && x < vis_x1 && y >= vis_y0 && y < vis_y1) {
+        transformCoordinates(x, y);
+        pixels[(int32_t)(y - row0) * stride + x] = color;
+        FG_PROFILE_PIXELS(1);
+    }
+}
+
+void FastCanvas::pixel(int16_t x, int16_t y, uint16_t color) {
+    dmaFence(x, y, 1, 1);
+    plot(x, y, color);
+}
+
+void FastCanvas::clear(uint16_t color) {
+    fillRect(0, 0, width, height, color);
+}
+
+/**
+ * @brief Draw a filled rectangle
+ * @implementation Clips against the visible area, maps the logical rectangle to
+ *                 its buffer rectangle once, then fills row by row. All four
+ *                 rotations map an axis-aligned rectangle to an axis-aligned
+ *                 rectangle, so no per-pixel transformation or bounds check is
+ *                 needed. In async mode large rectangles are queued to FastDMA.
+ * @performance ~O(w*h/8) with 128-bit stores on ESP32-S3, independent of rotation
+ */
+void FastCanvas::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w <= 0 || h <= 0) return;
+    
+    // Clip to the canvas, the rows held (a band during replay) and the clip rectangle
+    int16_t x1 = x + w, y1 = y + h;
+    if (!clip(x, y, x1, y1)) return;
+    w = x1 - x;
+    h = y1 - y;
+    
+    // Rotate the rectangle instead of every pixel
+    transformRect(x, y, w, h);
+    FG_PROFILE_PIXELS((uint32_t)w * h);
+    
+    // Direct buffer access on the physical rectangle
+    uint16_t* ptr = &pixels[(int32_t)(y - row0) * stride + x];
+    if (async) {
+        if ((uint32_t)w * h >= FG_DMA_MIN_PIXELS) {
+            // Queued behind earlier transfers, the CPU returns right away
+            if (w == stride) {
+                FastDMA::fill16(ptr, color, (size_t)w * h);
+                return;
+            }
+            for (int16_t row = 0; row < h; row++) {
+                FastDMA::fill16(ptr, color, w);
+                ptr += stride;
+            }
+            return;
+        }
+        FastDMA::waitFor(ptr, ((size_t)(h - 1) * stride + w) * sizeof(uint16_t));
+    }
+    if (w == stride) {
+        // Full-width rows are contiguous - one long run
+        FastKernels::fill16(ptr, color, (size_t)w * h);
+        return;
+    }
+    for (int16_t row = 0; row < h; row++) {
+        FastKernels::fill16(ptr, color, w);
+        ptr += stride;
+    }
+}
+
+/**
+ * @brief Draw a rectangle outline
+ * @implementation Draws four separate lines to form rectangle outline.
+ */
+void FastCanvas::rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    line(x, y, x + w - 1, y, color);                    // Top
+    line(x, y + h - 1, x + w - 1, y + h - 1, color);   // Bottom
+    line(x, y, x, y + h - 1, color);                    // Left
+    line(x + w - 1, y, x + w - 1, y + h - 1, color);   // Right
+}
+
+/**
+ * @brief Draw a line between two points
+ * @implementation Horizontal and vertical lines are rectangle fills. Diagonal lines
+ *                 are Bresenham in closed form: step t along the major axis puts
+ *                 the minor coordinate at floor((2*t*d + n - 1) / (2*n)), which is
+ *                 exactly the error-term walk. Cohen-Sutherland outcodes reject
+ *                 lines beyond one edge and accept lines fully inside; others are
+ *                 clipped once in step space (major range directly, minor range by
+ *                 solving the formula), so the visible pixels are exactly those of
+ *                 the unclipped line. The loop then writes through the rotation
+ *                 steps without bounds checks.
+ * @performance Horizontal/Vertical: O(1) using fillRect
+ *              Diagonal: O(visible length), one store and one add per pixel
+ */
+void FastCanvas::line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    if (y0 == y1) {
+        if (x0 > x1) { int16_t temp = x0; x0 = x1; x1 = temp; }
+        fillRect(x0, y0, x1 - x0 + 1, 1, color);
+        return;
+    }
+    if (x0 == x1) {
+        if (y0 > y1) { int16_t temp = y0; y0 = y1; y1 = temp; }
+        fillRect(x0, y0, 1, y1 - y0 + 1, color);
+        return;
+    }
+    
+    uint8_t code0 = outcode(x0, y0), code1 = outcode(x1, y1);
+    if (code0 & code1) return;      // Both ends beyond the same edge
+    
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    int32_t maj0 = steep ? y0 : x0, min0 = steep ? x0 : y0;
+    int32_t maj_dir = (steep ? y1 > y0 : x1 > x0) ? 1 : -1;
+    int32_t min_dir = (steep ? x1 > x0 : y1 > y0) ? 1 : -1;
+    int32_t n = steep ? abs(y1 - y0) : abs(x1 - x0);    // Major axis steps
+    int32_t d = steep ? abs(x1 - x0) : abs(y1 - y0);    // Minor axis distance
+    
+    int32_t t0 = 0, t1 = n;
+    if (code0 | code1) {
+        int32_t maj_lo = steep ? vis_y0 : vis_x0, maj_hi = steep ? vis_y1 : vis_x1;
+        int32_t min_lo = steep ? vis_x0 : vis_y0, min_hi = steep ? vis_x1 : vis_y1;
+        
+        // Major axis: maj0 + maj_dir * t in [maj_lo, maj_hi)
+        int32_t first = maj_dir > 0 ? maj_lo - maj0 : maj0 - (maj_hi - 1);
+        int32_t last = maj_dir > 0 ? maj_hi - 1 - maj0 : maj0 - maj_lo;
+        if (first > t0) t0 = first;
+        if (last < t1) t1 = last;
+        
+        // Minor axis: offset m(t) in [m_lo, m_hi]
+        int32_t m_lo = min_dir > 0 ? min_lo - min0 : min0 - (min_hi - 1);
+        int32_t m_hi = min_dir > 0 ? min_hi - 1 - min0 : min0 - min_lo;
+        int64_t t_lo = ceilDiv(2LL * n * m_lo - n + 1, 2LL * d);
+        int64_t t_hi = floorDiv(2LL * n * (m_hi + 1) - n, 2LL * d);
+        if (t_lo > t0) t0 = (int32_t)t_lo;
+        if (t_hi < t1) t1 = (int32_t)t_hi;
+        if (t0 > t1) return;
+    }
+    dmaFence(x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1, abs(x1 - x0) + 1, abs(y1 - y0) + 1);
+    
+    // Error term at the first visible step
+    int64_t numerator = 2LL * t0 * d + n - 1;
+    int32_t m = (int32_t)floorDiv(numerator, 2LL * n);
+    int32_t error = (int32_t)(numerator - (int64_t)m * 2 * n);
+    int32_t maj = maj0 + maj_dir * t0, mn = min0 + min_dir * m;
+    
+    int32_t step_x, step_y;
+    uint16_t* ptr = physicalAddress(steep ? mn : maj, steep ? maj : mn, step_x, step_y);
+    int32_t step_maj = (steep ? step_y : step_x) * maj_dir;
+    int32_t step_min = (steep ? step_x : step_y) * min_dir;
+    FG_PROFILE_PIXELS(t1 - t0 + 1);
+    
+    for (int32_t t = t0; t <= t1; t++) {
+        *ptr = color;
+        ptr += step_maj;
+        error += 2 * d;
+        if (error >= 2 * n) {
+            error -= 2 * n;
+            ptr += step_min;
+        }
+    }
+}
+
+/**
+ * @brief Draw a circle outline
+ * @implementation Uses midpoint circle algorithm with 8-way symmetry for efficiency.
+ *                 Only calculates 1/8 of circle and mirrors to other octants.
+ *                 The bounding box is tested against the visible area once: circles
+ *                 outside are rejected, circles inside are written through offsets
+ *                 from the center address without bounds checks, and only circles
+ *                 crossing the edge check each pixel.
+ * @performance O(r) where r is radius - very efficient
+ */
+void FastCanvas::circle(int16_t x0, int16_t y0, int16_t radius, uint16_t color) {
+    if (radius <= 0) return;
+    int16_t bx0 = x0 - radius, by0 = y0 - radius, bx1 = x0 + radius + 1, by1 = y0 + radius + 1;
+    if (bx1 <= vis_x0 || by1 <= vis_y0 || bx0 >= vis_x1 || by0 >= vis_y1) return;
+    bool inside = bx0 >= vis_x0 && by0 >= vis_y0 && bx1 <= vis_x1 && by1 <= vis_y1;
+    dmaFence(bx0, by0, 2 * radius + 1, 2 * radius + 1);
+    
+    int32_t sx = 0, sy = 0;
+    uint16_t* center = inside ? physicalAddress(x0, y0, sx, sy) : nullptr;
+    int16_t x = 0, y = radius;
+    int16_t decision = 1 - radius;
+    
+    while (x <= y) {
+        // Draw all 8 octants using symmetry
+        if (inside) {
+            center[x * sx + y * sy] = color; center[-x * sx + y * sy] = color;
+            center[x * sx - y * sy] = color; center[-x * sx - y * sy] = color;
+            center[y * sx + x * sy] = color; center[-y * sx + x * sy] = color;
+            center[y * sx - x * sy] = color; center[-y * sx - x * sy] = color;
+            FG_PROFILE_PIXELS(8);
+        } else {
+            plot(x0 + x, y0 + y, color); plot(x0 - x, y0 + y, color);
+            plot(x0 + x, y0 - y, color); plot(x0 - x, y0 - y, color);
+            plot(x0 + y, y0 + x, color); plot(x0 - y, y0 + x, color);
+            plot(x0 + y, y0 - x, color); plot(x0 - y, y0 - x, color);
+        }
+        
+        if (decision < 0) {
+            decision += 2 * x + 3;
+        } else {
+            decision += 2 * (x - y) + 5;
+            y--;
+        }
+        x++;
+    }
+}
+
+/**
+ * @brief Draw a filled circle
+ * @implementation Uses optimized midpoint circle algorithm with horizontal line fills.
+ *                 Draws filled lines instead of individual pixels for performance.
+ *                 Circles missing the visible area are rejected up front; each span
+ *                 is clipped once by fillRect().
+ * @performance O(r) where r is radius - very efficient due to 8-way symmetry
+ * @algorithm Modified Bresenham circle algorithm optimized for filled circles
+ */
+void FastCanvas::fillCircle(int16_t x0, int16_t y0, int16_t radius, uint16_t color) {
+    if (radius <= 0) return;
+    if (x0 + radius < vis_x0 || y0 + radius < vis_y0 || x0 - radius >= vis_x1 || y0 - radius >= vis_y1) return;
+    
+    int16_t x = 0;
+    int16_t y = radius;
+    int16_t decision = 1 - radius;
+    
+    // Draw center line
+    fillRect(x0 - radius, y0, 2 * radius + 1, 1, color);
+    
+    while (x < y) {
+        if (decision < 0) {
+            decision += 2 * x + 3;
+        } else {
+            decision += 2 * (x - y) + 5;
+            // Draw horizontal lines for filled circle
+            fillRect(x0 - x, y0 + y, 2 * x + 1, 1, color);
+            fillRect(x0 - x, y0 - y, 2 * x + 1, 1, color);
+            y--;
+        }
+        x++;
+        if (x <= y) {
+            fillRect(x0 - y, y0 + x, 2 * y + 1, 1, color);
+            fillRect(x0 - y, y0 - x, 2 * y + 1, 1, color);
+        }
+    }
+}
+
+/**
+ * @brief Draw a single character at specified position
+ * @implementation Clips once per glyph. A glyph fully inside the canvas is written
+ *                 straight to the buffer: at size 1 each font row is expanded to 8
+ *                 pixels from a nibble lookup table (landscape) or stepped through
+ *                 with the rotation strides; scaled glyphs are drawn as one fillRect
+ *                 per run of equal bits instead of one per bit. Size 1 glyphs
+ *                 crossing the edge of the visible area are cut to their visible
+ *                 columns and rows once and written without per-pixel checks.
+ *                 With a glyph cache, scaled opaque glyphs are copied from their
+ *                 pre-rendered tile instead.
+ * @performance Size 1: 8 row writes, no per-pixel bounds checks or transforms
+ *              Size >1: O(runs) rectangle fills, typically 2-4 per row; cached:
+ *              one row copy per line
+ */
+void FastCanvas::drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+    if (c < 0 || c > 127) return;
+    
+    const uint8_t* char_data = font8x8_basic[(uint8_t)c];
+    int16_t glyph_size = size * 8;
+    bool opaque = bg != color;  // bg == color means transparent background
+    
+    // Trivially reject glyphs entirely outside the visible area
+    if (x >= vis_x1 || y >= vis_y1 || x + glyph_size <= vis_x0 || y + glyph_size <= vis_y0) return;
+    
+    if (glyph_cache && opaque && size >= FG_GLYPH_CACHE_MIN_SIZE) {
+        const uint16_t* tile = glyph_cache->get(c, size, color, bg);
+        if (tile) {
+            copyPixels(x, y, tile, glyph_size, glyph_size, glyph_size, false, 0, 255);
+            return;
+        }
+    }
+    dmaFence(x, y, glyph_size, glyph_size);
+    
+    if (size > 1) {
+        // Horizontal runs of equal bits, scaled to size x size blocks.
+        // fillRect() clips, so partially visible glyphs need no special case.
+        for (int8_t row = 0; row < 8; row++) {
+            uint8_t line = char_data[row];
+            int8_t col = 0;
+            while (col < 8) {
+                bool set = line & (1 << col);
+                int8_t run = 1;
+                while (col + run < 8 && (bool)(line & (1 << (col + run))) == set) run++;
+                if (set || opaque) {
+                    fillRect(x + col * size, y + row * size, run * size, size, set ? color : bg);
+                }
+                col += run;
+            }
+        }
+    } else if (x < vis_x0 || y < vis_y0 || x + 8 > vis_x1 || y + 8 > vis_y1) {
+        // Partially visible: only the visible columns and rows
+        int8_t first_col = x < vis_x0 ? vis_x0 - x : 0, end_col = x + 8 > vis_x1 ? vis_x1 - x : 8;
+        int8_t first_row = y < vis_y0 ? vis_y0 - y : 0, end_row = y + 8 > vis_y1 ? vis_y1 - y : 8;
+        int32_t step_x, step_y;
+        uint16_t* row_ptr = physicalAddress(x + first_col, y + first_row, step_x, step_y);
+        for (int8_t row = first_row; row < end_row; row++) {
+            uint8_t line = char_data[row];
+            uint16_t* ptr = row_ptr;
+            for (int8_t col = first_col; col < end_col; col++) {
+                if (line & (1 << col)) {
+                    *ptr = color;
+                    FG_PROFILE_PIXELS(1);
+                } else if (opaque) {
+                    *ptr = bg;
+                    FG_PROFILE_PIXELS(1);
+                }
+                ptr += step_x;
+            }
+            row_ptr += step_y;
+        }
+    } else {
+        int32_t step_x, step_y;
+        uint16_t* row_ptr = physicalAddress(x, y, step_x, step_y);
+        
+        if (opaque && step_x == 1) {
+            // Landscape: expand each font row to 8 pixels from the nibble table
+            prepareGlyphLut(color, bg);
+            FG_PROFILE_PIXELS(64);
+            // Rows stay aligned if the stride is even
+            bool aligned = ((uintptr_t)row_ptr & 3) == 0 && (stride & 1) == 0;
+            for (int8_t row = 0; row < 8; row++) {
+                uint8_t line = char_data[row];
+                const uint8_t lo = line & 0x0F, hi = line >> 4;
+                if (aligned) {
+                    uint32_t* dst = (uint32_t*)row_ptr;
+                    dst[0] = glyph_lut.pair[lo][0]; dst[1] = glyph_lut.pair[lo][1];
+                    dst[2] = glyph_lut.pair[hi][0]; dst[3] = glyph_lut.pair[hi][1];
+                } else {
+                    row_ptr[0] = glyph_lut.px[lo][0]; row_ptr[1] = glyph_lut.px[lo][1];
+                    row_ptr[2] = glyph_lut.px[lo][2]; row_ptr[3] = glyph_lut.px[lo][3];
+                    row_ptr[4] = glyph_lut.px[hi][0]; row_ptr[5] = glyph_lut.px[hi][1];
+                    row_ptr[6] = glyph_lut.px[hi][2]; row_ptr[7] = glyph_lut.px[hi][3];
+                }
+                row_ptr += step_y;
+            }
+        } else if (opaque) {
+            // Rotated: step through the glyph with the rotation strides
+            FG_PROFILE_PIXELS(64);
+            for (int8_t row = 0; row < 8; row++) {
+                uint8_t line = char_data[row];
+                uint16_t* ptr = row_ptr;
+                for (int8_t col = 0; col < 8; col++) {
+                    *ptr = (line & (1 << col)) ? color : bg;
+                    ptr += step_x;
+                }
+                row_ptr += step_y;
+            }
+        } else {
+            // Transparent background: visit set bits only
+            for (int8_t row = 0; row < 8; row++) {
+                uint8_t line = char_data[row];
+                FG_PROFILE_PIXELS(__builtin_popcount(line));
+                while (line) {
+                    int col = __builtin_ctz(line);
+                    row_ptr[col * step_x] = color;
+                    line &= line - 1;
+                }
+                row_ptr += step_y;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Draw text at specified position
+ * @implementation Renders string character by character, handling newlines and
+ *                 carriage returns.
+ */
+void FastCanvas::text(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
+    int16_t cursor_x = x, cursor_y = y;
+    
+    while (*str) {
+        if (*str == '\n') {
+            cursor_y += size * 8;
+            cursor_x = x;
+        } else if (*str != '\r') {
+            drawChar(cursor_x, cursor_y, *str, color, bg, size);
+            cursor_x += size * 8;
+        }
+        str++;
+    }
+}
+
+/**
+ * @brief Draw one glyph of a proportional font
+ * @implementation The glyph is found by index (code - first). Its box is clipped
+ *                 once, then the packed bit stream is read from the first visible
+ *                 pixel of each row while the buffer is walked with the rotation
+ *                 strides. Anti-aliased coverage is scaled to 0-255 by one multiply;
+ *                 empty pixels are skipped and solid ones stored without blending.
+ * @performance O(visible box) bit extractions, blending only on glyph edges
+ */
+int16_t FastCanvas::drawGlyph(int16_t x, int16_t y, const GFXfont* font, uint8_t bpp, uint16_t c, uint16_t color) {
+    if (!font || c < font->first || c > font->last) return 0;
+    if (bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8) return 0;
+    const GFXglyph& glyph = font->glyph[c - font->first];
+    int16_t w = glyph.width, h = glyph.height;
+    x += glyph.xOffset;
+    y += glyph.yOffset;
+    int16_t x0 = x, y0 = y, x1 = x + w, y1 = y + h;
+    if (w == 0 || h == 0 || !clip(x0, y0, x1, y1)) return glyph.xAdvance;
+    int16_t cols = x1 - x0, rows = y1 - y0;
+    dmaFence(x0, y0, cols, rows);
+    FG_PROFILE_PIXELS((uint32_t)cols * rows);
+    
+    const uint8_t* bits = font->bitmap + glyph.bitmapOffset;
+    const uint8_t max = (1 << bpp) - 1;
+    const uint8_t scale = 255 / max;    // Exact for 1, 2, 4 and 8 bits
+    uint32_t row_bit = ((uint32_t)(y0 - y) * w + (x0 - x)) * bpp;
+    int32_t step_x, step_y;
+    uint16_t* dst = physicalAddress(x0, y0, step_x, step_y);
+    for (int16_t row = 0; row < rows; row++) {
+        uint32_t bit = row_bit;
+        uint16_t* d = dst;
+        for (int16_t col = 0; col < cols; col++) {
+            uint8_t value = (bits[bit >> 3] >> (8 - bpp - (bit & 7))) & max;
+            if (value == max) {
+                *d = color;
+            } else if (value) {
+                *d = FastKernels::blendPixel(*d, color, value * scale);
+            }
+            bit += bpp;
+            d += step_x;
+        }
+        row_bit += (uint32_t)w * bpp;
+        dst += step_y;
+    }
+    return glyph.xAdvance;
+}
+
+// =============================================================================
+// ANTI-ALIASED DRAWING
+// =============================================================================
+
+/**
+ * @brief sin() in Q14 for 0-90 degrees
+ */
+static const int16_t sin_q14[91] = {
+        0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,
+     2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+     5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+     8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384
+};
+
+/**
+ * @brief sin() of whole degrees in Q14 (16384 = 1.0)
+ */
+static int32_t sinQ14(int32_t degrees) {
+    degrees %= 360;
+    if (degrees < 0) degrees += 360;
+    if (degrees <= 90) return sin_q14[degrees];
+    if (degrees <= 180) return sin_q14[180 - degrees];
+    if (degrees <= 270) return -sin_q14[degrees - 180];
+    return -sin_q14[360 - degrees];
+}
+
+/**
+ * @brief Integer square root, rounded down
+ * @implementation Bit-by-bit method: 16 iterations of shifts and subtractions.
+ */
+static uint32_t isqrt32(uint32_t n) {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > n) bit >>= 2;
+    while (bit) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+/**
+ * @brief Draw color over a pixel with a coverage of 0-255 (clamped)
+ */
+static inline void blendCoverage(uint16_t* p, uint16_t color, int32_t coverage) {
+    if (coverage >= 255) {
+        *p = color;
+    } else if (coverage > 0) {
+        *p = FastKernels::blendPixel(*p, color, (uint8_t)coverage);
+    }
+}
+
+/**
+ * @brief Draw an anti-aliased line, 1 pixel wide
+ * @implementation Xiaolin Wu's algorithm in 16.16 fixed point: one step per pixel
+ *                 along the major axis, the minor position splits the coverage
+ *                 between the two pixels it falls between. The step range is
+ *                 clipped against the canvas and the rows held once, up front, so
+ *                 the loop only guards the minor pixel pair at the clip edges and
+ *                 walks the buffer with the rotation steps.
+ * @performance Two packed blends per major-axis pixel, no division in the loop
+ */
+void FastCanvas::lineAA(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    if (x0 == x1 || y0 == y1) {
+        line(x0, y0, x1, y1, color);    // Axis-aligned lines have no edges to smooth
+        return;
+    }
+    int16_t cx0 = 0, cy0 = 0, cx1 = width, cy1 = height;
+    if (!clip(cx0, cy0, cx1, cy1)) return;
+
+    // Major axis increasing from maj0 to maj1, minor position follows
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    int32_t maj0 = steep ? y0 : x0, min0 = steep ? x0 : y0;
+    int32_t maj1 = steep ? y1 : x1, min1 = steep ? x1 : y1;
+    if (maj0 > maj1) {
+        int32_t temp = maj0; maj0 = maj1; maj1 = temp;
+        temp = min0; min0 = min1; min1 = temp;
+    }
+    int32_t maj_lo = steep ? cy0 : cx0, maj_hi = steep ? cy1 : cx1;    // Clip range [lo, hi)
+    int32_t min_lo = steep ? cx0 : cy0, min_hi = steep ? cx1 : cy1;
+    int32_t steps = maj1 - maj0;
+    int32_t gradient = (int32_t)((int64_t)(min1 - min0) * 65536 / steps);  // Minor step per major step, 16.16
+    int32_t start = min0 * 65536;
+
+    // Steps on the canvas along the major axis...
+    int32_t t0 = maj_lo - maj0 > 0 ? maj_lo - maj0 : 0;
+    int32_t t1 = maj_hi - 1 - maj0 < steps ? maj_hi - 1 - maj0 : steps;
+    // ...whose pixel pair (m, m + 1) touches it: min_lo - 1 <= m < min_hi
+    int64_t lo = (int64_t)(min_lo - 1) * 65536, hi = (int64_t)min_hi * 65536 - 1;
+    int64_t first, last;
+    if (gradient > 0) {
+        first = ceilDiv(lo - start, gradient);
+        last = floorDiv(hi - start, gradient);
+    } else {
+        first = ceilDiv(start - hi, -gradient);
+        last = floorDiv(start - lo, -gradient);
+    }
+    if (first > t0) t0 = (int32_t)first;
+    if (last < t1) t1 = (int32_t)last;
+    if (t0 > t1) return;
+
+    dmaFence(x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1, abs(x1 - x0) + 1, abs(y1 - y0) + 1);
+    int32_t step_x, step_y;
+    uint16_t* corner = physicalAddress(cx0, cy0, step_x, step_y);
+    int32_t step_maj = steep ? step_y : step_x;
+    int32_t step_min = steep ? step_x : step_y;
+    FG_PROFILE_PIXELS(2 * (t1 - t0 + 1));
+
+    int32_t m = start + t0 * gradient;
+    for (int32_t t = t0; t <= t1; t++, m += gradient) {
+        int32_t mi = m >> 16;                   // Arithmetic shift: floor
+        int32_t coverage = (m >> 8) & 0xFF;     // Share of pixel mi + 1
+        int32_t offset = (maj0 + t - maj_lo) * step_maj + (mi - min_lo) * step_min;
+        if (mi >= min_lo) blendCoverage(corner + offset, color, 255 - coverage);
+        if (mi + 1 < min_hi) blendCoverage(corner + offset + step_min, color, coverage);
+    }
+}
+
+/**
+ * @brief Draw an anti-aliased line with round caps
+ * @implementation Signed distance to the segment, a capsule: pixels alongside the
+ *                 segment use the perpendicular distance, the cross product of the
+ *                 pixel offset with the direction times a precomputed 1/length, and
+ *                 only the cap pixels past either end take an integer square root.
+ *                 Each row visits just the band where the cross product can reach
+ *                 the edge, found with one division per row; cross and dot product
+ *                 are stepped incrementally along it.
+ * @performance O(length x thickness) pixels, one multiply per pixel inside
+ */
+void FastCanvas::thickLineAA(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t thickness, uint16_t color) {
+    if (thickness <= 1) {
+        lineAA(x0, y0, x1, y1, color);
+        return;
+    }
+    int32_t half16 = thickness * 8;     // Half width in 1/16 pixel
+    int32_t vx = x1 - x0, vy = y1 - y0;
+    int32_t length2 = vx * vx + vy * vy;
+    if (length2 == 0) {
+        ringAA(x0, y0, half16, -8, 0, 0, true, color);
+        return;
+    }
+
+    int16_t reach = (half16 + 8 + 15) >> 4;
+    int16_t cx0 = (x0 < x1 ? x0 : x1) - reach, cy0 = (y0 < y1 ? y0 : y1) - reach;
+    int16_t cx1 = (x0 > x1 ? x0 : x1) + reach + 1, cy1 = (y0 > y1 ? y0 : y1) + reach + 1;
+    if (!clip(cx0, cy0, cx1, cy1)) return;
+    dmaFence(cx0, cy0, cx1 - cx0, cy1 - cy0);
+
+    int32_t length16 = isqrt32((uint32_t)length2 << 8);             // Length in 1/16 pixel
+    int32_t inverse = ((1L << 24) + length16 / 2) / length16;       // |cross| * inverse >> 16 = distance16
+    int32_t band = (((half16 + 8) * length16) >> 8) + 1;            // |cross| with any coverage
+    int32_t step_x, step_y;
+    uint16_t* corner = physicalAddress(cx0, cy0, step_x, step_y);
+
+    for (int16_t y = cy0; y < cy1; y++) {
+        int32_t wy = y - y0;
+
+        // cross = (x - x0) * vy - wy * vx is linear in x: keep |cross| <= band
+        int32_t xa = cx0, xb = cx1 - 1;
+        if (vy != 0) {
+            int32_t c = wy * vx;
+            int32_t first = (int32_t)(vy > 0 ? ceilDiv(c - band, vy) : ceilDiv(-(c + band), -vy));
+            int32_t last = (int32_t)(vy > 0 ? floorDiv(c + band, vy) : floorDiv(band - c, -vy));
+            if (x0 + first > xa) xa = x0 + first;
+            if (x0 + last < xb) xb = x0 + last;
+        }
+        if (xa > xb) continue;
+        FG_PROFILE_PIXELS(xb - xa + 1);
+
+        int32_t wx = xa - x0;
+        int32_t cross = wx * vy - wy * vx;
+        int32_t dot = wx * vx + wy * vy;
+        uint16_t* ptr = corner + (int32_t)(y - cy0) * step_y + (xa - cx0) * step_x;
+        for (int32_t x = xa; x <= xb; x++, wx++, cross += vy, dot += vx, ptr += step_x) {
+            int32_t distance16;
+            if (dot < 0) {
+                distance16 = isqrt32((uint32_t)(wx * wx + wy * wy) << 8);
+            } else if (dot > length2) {
+                int32_t ex = wx - vx, ey = wy - vy;
+                distance16 = isqrt32((uint32_t)(ex * ex + ey * ey) << 8);
+            } else {
+                distance16 = ((cross < 0 ? -cross : cross) * inverse) >> 16;
+            }
+            blendCoverage(ptr, color, (half16 + 8 - distance16) * 16);
+        }
+    }
+}
+
+void FastCanvas::circleAA(int16_t x0, int16_t y0, int16_t radius, uint16_t color) {
+    if (radius <= 0) return;
+    ringAA(x0, y0, radius * 16 + 8, radius * 16 - 8, 0, 0, true, color);
+}
+
+void FastCanvas::fillCircleAA(int16_t x0, int16_t y0, int16_t radius, uint16_t color) {
+    if (radius <= 0) return;
+    ringAA(x0, y0, radius * 16 + 8, -8, 0, 0, true, color);
+}
+
+void FastCanvas::arcAA(int16_t x0, int16_t y0, int16_t radius, int16_t start_angle, int16_t end_angle,
+                       uint8_t thickness, uint16_t color) {
+    if (radius <= 0 || thickness == 0) return;
+    int32_t span = end_angle - start_angle;
+    ringAA(x0, y0, radius * 16 + thickness * 8, radius * 16 - thickness * 8,
+           start_angle, end_angle, span >= 360 || span <= -360, color);
+}
+
+/**
+ * @brief Draw an anti-aliased ring, disc or arc
+ * @implementation Coverage is the distance to the nearest edge in 1/16 pixel,
+ *                 mapped linearly over one pixel. Per row, integer square roots
+ *                 of exact squared radii give the extent of the ring, the hole and
+ *                 the fully covered spans, so only edge pixels compute their own
+ *                 distance (one isqrt32()); covered spans of complete rings are
+ *                 plain fills. Arc ends are two half planes through the centre:
+ *                 the signed distance to each is a cross product with the Q14 unit
+ *                 direction, intersected for spans up to 180 degrees and united
+ *                 beyond.
+ * @performance Full rings and discs: O(r) edge pixels with a square root plus
+ *              span fills; arcs: one cross product pair per pixel
+ */
+void FastCanvas::ringAA(int16_t x0, int16_t y0, int32_t outer16, int32_t inner16,
+                        int16_t start_angle, int16_t end_angle, bool full, uint16_t color) {
+    if (outer16 <= 0 || inner16 >= outer16) return;
+
+    int16_t reach = (outer16 + 8 + 15) >> 4;
+    int16_t cx0 = x0 - reach, cy0 = y0 - reach, cx1 = x0 + reach + 1, cy1 = y0 + reach + 1;
+    if (!clip(cx0, cy0, cx1, cy1)) return;
+
+    // Arc end directions, 0 degrees = up, clockwise on screen
+    int32_t ax = 0, ay = 0, bx = 0, by = 0;
+    bool wide = false;
+    if (!full) {
+        int32_t span = (end_angle - start_angle) % 360;
+        if (span < 0) span += 360;
+        if (span == 0) return;
+        wide = span > 180;
+        ax = sinQ14(start_angle); ay = -sinQ14(start_angle + 90);
+        bx = sinQ14(end_angle);   by = -sinQ14(end_angle + 90);
+    }
+    dmaFence(cx0, cy0, cx1 - cx0, cy1 - cy0);
+
+    // Squared edge radii in 1/256 pixel^2, compared with d^2 * 256
+    int32_t outer_any = (outer16 + 8) * (outer16 + 8);                          // d < outer + 1/2
+    int32_t outer_full = outer16 > 8 ? (outer16 - 8) * (outer16 - 8) : -1;      // d <= outer - 1/2
+    bool inner_edge = inner16 > -8;
+    int32_t inner_none = inner16 > 8 ? (inner16 - 8) * (inner16 - 8) : -1;      // d <= inner - 1/2
+    int32_t inner_full = inner_edge ? (inner16 + 8) * (inner16 + 8) : 0;        // d >= inner + 1/2
+
+    int32_t step_x, step_y;
+    uint16_t* corner = physicalAddress(cx0, cy0, step_x, step_y);
+
+    for (int16_t y = cy0; y < cy1; y++) {
+        int32_t dy = y - y0;
+        int32_t dy2 = dy * dy * 256;
+        if (dy2 >= outer_any) continue;
+
+        // |dx| limits on this row: any coverage, inside the outer edge, in the hole
+        int32_t reach_x = isqrt32((outer_any - dy2 + 255) / 256 - 1);
+        int32_t outer_x = outer_full >= dy2 ? (int32_t)isqrt32((outer_full - dy2) / 256) : -1;
+        int32_t hole_x = inner_none >= dy2 ? (int32_t)isqrt32((inner_none - dy2) / 256) : -1;
+        int32_t inner_x = 0;    // First |dx| past the inner edge
+        if (inner_full > dy2) {
+            uint32_t q = (inner_full - dy2 + 255) / 256;
+            inner_x = isqrt32(q);
+            if ((uint32_t)(inner_x * inner_x) < q) inner_x++;
+        }
+
+        int32_t xa = x0 - reach_x > cx0 ? x0 - reach_x : cx0;
+        int32_t xb = x0 + reach_x < cx1 - 1 ? x0 + reach_x : cx1 - 1;
+        uint16_t* row = corner + (int32_t)(y - cy0) * step_y;
+        int32_t x = xa;
+        while (x <= xb) {
+            int32_t dx = x - x0;
+            int32_t adx = dx < 0 ? -dx : dx;
+            if (adx <= hole_x) {
+                x = x0 + hole_x + 1;    // Skip the hole
+                continue;
+            }
+            bool covered = adx >= inner_x && adx <= outer_x;
+            if (covered && full) {
+                // Solid span up to the next edge (through the centre of a disc)
+                int32_t end = (dx < 0 && inner_x > 0) ? x0 - inner_x : x0 + outer_x;
+                if (end > xb) end = xb;
+                int32_t count = end - x + 1;
+                uint16_t* ptr = row + (x - cx0) * step_x;
+                if (step_x == 1) {
+                    FastKernels::fill16(ptr, color, count);
+                } else if (step_x == -1) {
+                    FastKernels::fill16(ptr - (count - 1), color, count);
+                } else {
+                    for (int32_t i = 0; i < count; i++, ptr += step_x) *ptr = color;
+                }
+                FG_PROFILE_PIXELS(count);
+                x = end + 1;
+                continue;
+            }
+
+            int32_t coverage = 255;
+            if (!covered) {
+                int32_t distance16 = isqrt32(dx * dx * 256 + dy2);
+                coverage = (outer16 + 8 - distance16) * 16;
+                if (inner_edge) {
+                    int32_t inner = (distance16 - inner16 + 8) * 16;
+                    if (inner < coverage) coverage = inner;
+                }
+            }
+            if (!full) {
+                int32_t side0 = (ax * dy - ay * dx) >> 6;     // Past the start, 1/256 pixel
+                int32_t side1 = (dx * by - dy * bx) >> 6;     // Before the end
+                int32_t angular = (wide ? (side0 > side1 ? side0 : side1)
+                                        : (side0 < side1 ? side0 : side1)) + 128;
+                if (angular < coverage) coverage = angular;
+            }
+            blendCoverage(row + (x - cx0) * step_x, color, coverage);
+            FG_PROFILE_PIXELS(1);
+            x++;
+        }
+    }
+}
+
+// =============================================================================
+// IMAGE FUNCTIONS
+// =============================================================================
+
+void FastCanvas::drawImage(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h) {
+    blit(x, y, image, w, h, 0, 0, w, h);
+}
+
+void FastCanvas::drawImage(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h, uint16_t transparent) {
+    blit(x, y, image, w, h, 0, 0, w, h, transparent);
+}
+
+/**
+ * @brief Draw part of an RGB565 image
+ * @implementation Parts of the source rectangle outside the image move the
+ *                 destination along, so the visible pixels stay where they would be.
+ */
+void FastCanvas::blit(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                      int16_t sx, int16_t sy, int16_t sw, int16_t sh) {
+    if (!image) return;
+    if (sx < 0) { x -= sx; sw += sx; sx = 0; }
+    if (sy < 0) { y -= sy; sh += sy; sy = 0; }
+    if (sx + sw > image_w) sw = image_w - sx;
+    if (sy + sh > image_h) sh = image_h - sy;
+    if (sw <= 0 || sh <= 0) return;
+    copyPixels(x, y, image + (int32_t)sy * image_w + sx, image_w, sw, sh, false, 0, 255);
+}
+
+void FastCanvas::blit(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                      int16_t sx, int16_t sy, int16_t sw, int16_t sh, uint16_t transparent) {
+    if (!image) return;
+    if (sx < 0) { x -= sx; sw += sx; sx = 0; }
+    if (sy < 0) { y -= sy; sh += sy; sy = 0; }
+    if (sx + sw > image_w) sw = image_w - sx;
+    if (sy + sh > image_h) sh = image_h - sy;
+    if (sw <= 0 || sh <= 0) return;
+    copyPixels(x, y, image + (int32_t)sy * image_w + sx, image_w, sw, sh, true, transparent, 255);
+}
+
+void FastCanvas::drawCanvas(int16_t x, int16_t y, const FastCanvas& source) {
+    copyPixels(x, y, source.pixels, source.stride, source.buffer_width, source.row1 - source.row0, false, 0, 255);
+}
+
+void FastCanvas::drawCanvas(int16_t x, int16_t y, const FastCanvas& source, uint16_t transparent) {
+    copyPixels(x, y, source.pixels, source.stride, source.buffer_width, source.row1 - source.row0, true, transparent, 255);
+}
+
+/**
+ * @brief Copy RGB565 pixels
+ * @implementation Clips once, then walks the buffer with the rotation strides from
+ *                 physicalAddress(). Landscape rotations write buffer rows in source
+ *                 row order - a plain copy16() (blendCopy16() when translucent) per
+ *                 row in ROTATION_0 without color key. Portrait rotations walk the source by columns instead,
+ *                 because a source column is what lands on one buffer row: PSRAM
+ *                 writes stay sequential and only the source reads are strided.
+ *                 In async mode large unkeyed ROTATION_0 copies go to FastDMA.
+ * @performance ROTATION_0: one memcpy/PIE copy per row; other rotations: one load
+ *              and one store per pixel, no transforms or bounds checks
+ */
+void FastCanvas::copyPixels(int16_t x, int16_t y, const uint16_t* src, int16_t src_stride, int16_t w, int16_t h,
+                            bool keyed, uint16_t key, uint8_t alpha) {
+    if (!src || alpha < 4) return;  // Below one blend level
+    bool opaque = alpha >= 252;
+    int16_t x0 = x, y0 = y, x1 = x + w, y1 = y + h;
+    if (!clip(x0, y0, x1, y1)) return;
+    src += (int32_t)(y0 - y) * src_stride + (x0 - x);
+    w = x1 - x0;
+    h = y1 - y0;
+    FG_PROFILE_PIXELS((uint32_t)w * h);
+    
+    int32_t step_x, step_y;
+    uint16_t* dst = physicalAddress(x0, y0, step_x, step_y);
+    bool use_dma = async && step_x == 1 && !keyed && opaque && (uint32_t)w * h >= FG_DMA_MIN_PIXELS;
+    if (!use_dma) dmaFence(x0, y0, w, h);
+    
+    if (use_dma) {
+        for (int16_t row = 0; row < h; row++) {
+            FastDMA::copy16(dst, src, w);
+            dst += step_y;
+            src += src_stride;
+        }
+    } else if (step_x == 1 && !keyed) {
+        for (int16_t row = 0; row < h; row++) {
+            if (opaque) {
+                FastKernels::copy16(dst, src, w);
+            } else {
+                FastKernels::blendCopy16(dst, src, alpha, w);
+            }
+            dst += step_y;
+            src += src_stride;
+        }
+    } else if (step_x == 1 || step_x == -1) {
+        // Landscape: a source row is a buffer row (reversed in ROTATION_180)
+        for (int16_t row = 0; row < h; row++) {
+            uint16_t* d = dst;
+            for (int16_t col = 0; col < w; col++) {
+                uint16_t c = src[col];
+                if (!keyed || c != key) *d = opaque ? c : FastKernels::blendPixel(*d, c, alpha);
+                d += step_x;
+            }
+            dst += step_y;
+            src += src_stride;
+        }
+    } else {
+        // Portrait: a source column is a buffer row
+        for (int16_t col = 0; col < w; col++) {
+            uint16_t* d = dst;
+            const uint16_t* s = src + col;
+            for (int16_t row = 0; row < h; row++) {
+                uint16_t c = *s;
+                if (!keyed || c != key) *d = opaque ? c : FastKernels::blendPixel(*d, c, alpha);
+                d += step_y;
+                s += src_stride;
+            }
+            dst += step_x;
+        }
+    }
+}
+
+/**
+ * @brief Draw a 1-bit bitmap
+ * @implementation The two colors form a 2-entry palette for drawPacked().
+ */
+void FastCanvas::drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                            uint16_t color, uint16_t bg) {
+    uint16_t palette[2] = { bg, color };
+    drawPacked(x, y, bitmap, w, h, 1, palette, bg == color ? 0 : -1);
+}
+
+void FastCanvas::drawBitmap4(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                             const uint16_t* palette, int16_t transparent) {
+    if (!palette) return;
+    drawPacked(x, y, bitmap, w, h, 4, palette, transparent);
+}
+
+void FastCanvas::drawCompressed(int16_t x, int16_t y, const uint8_t* image) {
+    if (!FastImage::valid(image)) return;
+    blitCompressed(x, y, image, 0, 0, FastImage::getWidth(image), FastImage::getHeight(image));
+}
+
+/**
+ * @brief Draw part of a compressed image
+ * @implementation Clips source and destination like blit(), then decodes each visible
+ *                 row straight into the buffer with the rotation's x step, so
+ *                 nothing is buffered and rows outside the visible area (another
+ *                 band, a clip) are never decoded.
+ * @performance Landscape rows are written sequentially with runs filled by
+ *              FastKernels::fill16(); portrait writes one pixel per buffer row
+ */
+void FastCanvas::blitCompressed(int16_t x, int16_t y, const uint8_t* image, int16_t sx, int16_t sy,
+                                int16_t sw, int16_t sh) {
+    if (!FastImage::valid(image)) return;
+    if (sx < 0) { x -= sx; sw += sx; sx = 0; }
+    if (sy < 0) { y -= sy; sh += sy; sy = 0; }
+    if (sx + sw > FastImage::getWidth(image)) sw = FastImage::getWidth(image) - sx;
+    if (sy + sh > FastImage::getHeight(image)) sh = FastImage::getHeight(image) - sy;
+    if (sw <= 0 || sh <= 0) return;
+    int16_t x0 = x, y0 = y, x1 = x + sw, y1 = y + sh;
+    if (!clip(x0, y0, x1, y1)) return;
+    sx += x0 - x;
+    sy += y0 - y;
+    FG_PROFILE_PIXELS((uint32_t)(x1 - x0) * (y1 - y0));
+    dmaFence(x0, y0, x1 - x0, y1 - y0);
+
+    int32_t step_x, step_y;
+    uint16_t* dst = physicalAddress(x0, y0, step_x, step_y);
+    for (int16_t row = 0; row < y1 - y0; row++) {
+        FastImage::decodeRow(image, sy + row, sx, x1 - x0, dst, step_x);
+        dst += step_y;
+    }
+}
+
+/**
+ * @brief Draw a 1-bit or 4-bit bitmap
+ * @implementation Clips once, then expands each row through the palette, which
+ *                 serves as the lookup table from pixel value to RGB565, stepping
+ *                 through the buffer with the rotation strides.
+ * @performance One shift, mask and table load per pixel
+ */
+void FastCanvas::drawPacked(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                            uint8_t bpp, const uint16_t* palette, int16_t transparent) {
+    if (!bitmap || w <= 0 || h <= 0) return;
+    int16_t x0 = x, y0 = y, x1 = x + w, y1 = y + h;
+    if (!clip(x0, y0, x1, y1)) return;
+    FG_PROFILE_PIXELS((uint32_t)(x1 - x0) * (y1 - y0));
+    dmaFence(x0, y0, x1 - x0, y1 - y0);
+    
+    int32_t row_bytes = ((int32_t)w * bpp + 7) / 8;
+    uint8_t mask = (1 << bpp) - 1;
+    int32_t step_x, step_y;
+    uint16_t* dst = physicalAddress(x0, y0, step_x, step_y);
+    const uint8_t* row = bitmap + (int32_t)(y0 - y) * row_bytes;
+    
+    for (int16_t py = y0; py < y1; py++) {
+        uint16_t* d = dst;
+        for (int16_t px = x0 - x; px < x1 - x; px++) {
+            int32_t bit = (int32_t)px * bpp;
+            uint8_t index = (row[bit >> 3] >> (8 - bpp - (bit & 7))) & mask;
+            if (index != transparent) *d = palette[index];
+            d += step_x;
+        }
+        dst += step_y;
+        row += row_bytes;
+    }
+}
+
+// =============================================================================
+// ALPHA BLENDING
+// =============================================================================
+
+uint16_t* FastCanvas::lockRect(int16_t& x, int16_t& y, int16_t& w, int16_t& h) {
+    if (w <= 0 || h <= 0) return nullptr;
+    int16_t x1 = x + w, y1 = y + h;
+    if (!clip(x, y, x1, y1)) return nullptr;
+    w = x1 - x;
+    h = y1 - y;
+    dmaFence(x, y, w, h);
+    transformRect(x, y, w, h);
+    FG_PROFILE_PIXELS((uint32_t)w * h);
+    return &pixels[(int32_t)(y - row0) * stride + x];
+}
+
+void FastCanvas::blendPixel(int16_t x, int16_t y, uint16_t color, uint8_t alpha) {
+    if (x < vis_x0 || x >= vis_x1 || y < vis_y0 || y >= vis_y1) return;
+    dmaFence(x, y, 1, 1);
+    int32_t step_x, step_y;
+    uint16_t* p = physicalAddress(x, y, step_x, step_y);
+    *p = FastKernels::blendPixel(*p, color, alpha);
+    FG_PROFILE_PIXELS(1);
+}
+
+/**
+ * @brief Blend a color over a rectangle
+ * @implementation Same clipping and rotation as fillRect(); whole buffer rows are
+ *                 blended as one run each, contiguous rows as a single run.
+ * @performance One multiply per pixel, two pixels per 32-bit access
+ */
+void FastCanvas::fillRectAlpha(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, uint8_t alpha) {
+    uint16_t* ptr = lockRect(x, y, w, h);
+    if (!ptr) return;
+    if (w == stride) {
+        FastKernels::blend16(ptr, color, alpha, (size_t)w * h);
+        return;
+    }
+    for (int16_t row = 0; row < h; row++) {
+        FastKernels::blend16(ptr, color, alpha, w);
+        ptr += stride;
+    }
+}
+
+/**
+ * @brief Darken a rectangle
+ * @implementation As fillRectAlpha() with FastKernels::dim16(): no multiply at all,
+ *                 for dimming the screen behind a modal dialog in one pass.
+ * @performance One shift and mask per two pixels
+ */
+void FastCanvas::dimRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t level) {
+    if (level == 0) return;
+    uint16_t* ptr = lockRect(x, y, w, h);
+    if (!ptr) return;
+    if (w == stride) {
+        FastKernels::dim16(ptr, level, (size_t)w * h);
+        return;
+    }
+    for (int16_t row = 0; row < h; row++) {
+        FastKernels::dim16(ptr, level, w);
+        ptr += stride;
+    }
+}
+
+void FastCanvas::drawImageAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h, uint8_t alpha) {
+    blitAlpha(x, y, image, w, h, 0, 0, w, h, alpha);
+}
+
+void FastCanvas::drawImageAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h, uint8_t alpha,
+                                uint16_t transparent) {
+    blitAlpha(x, y, image, w, h, 0, 0, w, h, alpha, transparent);
+}
+
+/**
+ * @brief Blend part of an RGB565 image
+ * @implementation Source clipping as blit(), then copyPixels() in blend mode.
+ */
+void FastCanvas::blitAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                           int16_t sx, int16_t sy, int16_t sw, int16_t sh, uint8_t alpha) {
+    if (!image) return;
+    if (sx < 0) { x -= sx; sw += sx; sx = 0; }
+    if (sy < 0) { y -= sy; sh += sy; sy = 0; }
+    if (sx + sw > image_w) sw = image_w - sx;
+    if (sy + sh > image_h) sh = image_h - sy;
+    if (sw <= 0 || sh <= 0) return;
+    copyPixels(x, y, image + (int32_t)sy * image_w + sx, image_w, sw, sh, false, 0, alpha);
+}
+
+void FastCanvas::blitAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                           int16_t sx, int16_t sy, int16_t sw, int16_t sh, uint8_t alpha, uint16_t transparent) {
+    if (!image) return;
+    if (sx < 0) { x -= sx; sw += sx; sx = 0; }
+    if (sy < 0) { y -= sy; sh += sy; sy = 0; }
+    if (sx + sw > image_w) sw = image_w - sx;
+    if (sy + sh > image_h) sh = image_h - sy;
+    if (sw <= 0 || sh <= 0) return;
+    copyPixels(x, y, image + (int32_t)sy * image_w + sx, image_w, sw, sh, true, transparent, alpha);
+}
+
+/**
+ * @brief Draw a color through an 8-bit coverage mask
+ * @implementation Clips once and walks the buffer with the rotation strides, in
+ *                 mask row order. Zero coverage is skipped and full coverage is a
+ *                 plain store, so only the edges of a glyph or icon are blended.
+ * @performance At most one multiply per pixel, no bounds checks
+ */
+void FastCanvas::drawMask(int16_t x, int16_t y, const uint8_t* mask, int16_t w, int16_t h, uint16_t color) {
+    if (!mask || w <= 0 || h <= 0) return;
+    int16_t x0 = x, y0 = y, x1 = x + w, y1 = y + h;
+    if (!clip(x0, y0, x1, y1)) return;
+    const uint8_t* src = mask + (int32_t)(y0 - y) * w + (x0 - x);
+    int16_t cols = x1 - x0, rows = y1 - y0;
+    dmaFence(x0, y0, cols, rows);
+    FG_PROFILE_PIXELS((uint32_t)cols * rows);
+    
+    int32_t step_x, step_y;
+    uint16_t* dst = physicalAddress(x0, y0, step_x, step_y);
+    for (int16_t row = 0; row < rows; row++) {
+        uint16_t* d = dst;
+        for (int16_t col = 0; col < cols; col++) {
+            blendCoverage(d, color, src[col]);
+            d += step_x;
+        }
+        dst += step_y;
+        src += w;
+    }
+}
+
+// =============================================================================
+// SCROLLING
+// =============================================================================
+
+/**
+ * @brief Scroll the content of a rectangle upwards
+ * @implementation Maps the rectangle to buffer coordinates once. Logical "up" is
+ *                 buffer up (ROTATION_0), down (180), right (90) or left (270):
+ *                 the first two copy whole row spans between rows, the portrait
+ *                 cases memmove within each buffer row. Rectangles spanning
+ *                 contiguous rows move with a single memmove. Only the exposed
+ *                 strip is filled.
+ * @performance O(w*h) memory moves, no per-pixel work
+ */
+void FastCanvas::scrollRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dy, uint16_t color) {
+    if (async) FastDMA::waitIdle();
+    if (w <= 0 || h <= 0 || dy <= 0) return;
+    
+    // Only the visible part of the rectangle scrolls
+    int16_t x1 = x + w, y1 = y + h;
+    if (!clip(x, y, x1, y1)) return;
+    w = x1 - x;
+    h = y1 - y;
+    
+    if (dy < h) {
+        int16_t px = x, py = y, pw = w, ph = h;
+        transformRect(px, py, pw, ph);
+        uint16_t* base = &pixels[(int32_t)(py - row0) * stride + px];
+        
+        switch (rotation) {
+            case ROTATION_0:   // Rows move up
+                if (pw == stride) {
+                    memmove(base, base + dy * stride, (size_t)(ph - dy) * stride * sizeof(uint16_t));
+                } else {
+                    for (int16_t row = 0; row < ph - dy; row++) {
+                        FastKernels::copy16(base + row * stride, base + (row + dy) * stride, pw);
+                    }
+                }
+                break;
+                
+            case ROTATION_180: // Rows move down
+                if (pw == stride) {
+                    memmove(base + dy * stride, base, (size_t)(ph - dy) * stride * sizeof(uint16_t));
+                } else {
+                    for (int16_t row = ph - 1; row >= dy; row--) {
+                        FastKernels::copy16(base + row * stride, base + (row - dy) * stride, pw);
+                    }
+                }
+                break;
+                
+            case ROTATION_90:  // Spans move right within each row
+                for (int16_t row = 0; row < ph; row++) {
+                    uint16_t* ptr = base + row * stride;
+                    memmove(ptr + dy, ptr, (size_t)(pw - dy) * sizeof(uint16_t));
+                }
+                break;
+                
+            case ROTATION_270: // Spans move left within each row
+                for (int16_t row = 0; row < ph; row++) {
+                    uint16_t* ptr = base + row * stride;
+                    memmove(ptr, ptr + dy, (size_t)(pw - dy) * sizeof(uint16_t));
+                }
+                break;
+        }
+    } else {
+        dy = h;
+    }
+    
+    // Clear only the newly exposed rows
+    fillRect(x, y + h - dy, w, dy, color);
+}
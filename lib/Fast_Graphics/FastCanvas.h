@@ -0,0 +1,562 @@
+// FastCanvas.h - Drawing surface for FastGraphics
+// Any RGB565 buffer with its own size, stride and rotation: the screen or offscreen
+
+#ifndef FAST_CANVAS_H
+#define FAST_CANVAS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_heap_caps.h"  // For the allocation capabilities in begin()
+#include "FastFont.h"
+
+class FastGlyphCache;
+
+// =============================================================================
+// CANVAS CONFIGURATION
+// =============================================================================
+
+// Async DMA drawing (see setAsync())
+#ifndef FG_DMA_MIN_PIXELS
+#define FG_DMA_MIN_PIXELS 4096      /**< Smaller fills/copies stay on the CPU */
+#endif
+
+// Profiling build mode (see FastGraphics::getFrameStats()), adds a cycle counter read per primitive call
+#ifndef FG_PROFILE
+#define FG_PROFILE 0
+#endif
+
+/**
+ * @enum ScreenRotation
+ * @brief Screen rotation options for display orientation
+ * @details Defines the four possible screen orientations. ROTATION_0 and ROTATION_180
+ *          maintain landscape orientation, while ROTATION_90 and ROTATION_270 switch to portrait.
+ */
+enum ScreenRotation {
+    ROTATION_0   = 0,  /**< Landscape (default): 800x480 */
+    ROTATION_90  = 1,  /**< Portrait: 480x800 */
+    ROTATION_180 = 2,  /**< Landscape flipped: 800x480 */
+    ROTATION_270 = 3   /**< Portrait flipped: 480x800 */
+};
+
+/**
+ * @brief Built-in 8x8 font, ASCII 0-127
+ * @details 8 bytes per character, one per row, bit 0 = leftmost pixel. Defined in
+ *          FastCanvas.cpp and shared by FastCanvas and FixedCanvas.
+ */
+extern const uint8_t font8x8_basic[128][8];
+
+// =============================================================================
+// FASTCANVAS CLASS
+// =============================================================================
+
+/**
+ * @class FastCanvas
+ * @brief RGB565 drawing surface with its own buffer, size, stride and rotation
+ * @details Runs every FastGraphics primitive on any buffer: the screen framebuffer
+ *          (FastGraphics draws through a canvas of its own), a replay band, or an
+ *          offscreen surface in internal SRAM that is drawn once and then copied to
+ *          the screen with FastGraphics::drawCanvas(). The buffer holds
+ *          buffer width x buffer height pixels, stride pixels apart per row; the
+ *          rotation maps logical coordinates onto it exactly like the screen's.
+ *
+ *          There is no dirty tracking, recording or text cursor here: a canvas only
+ *          writes pixels. FastGraphics adds those on top for the screen.
+ *
+ * @note The 8x8 font and the glyph lookup table are shared by all canvases
+ * @note Not thread-safe per canvas; separate canvases can be drawn from separate tasks
+ *
+ * @example
+ * @code
+ * static FastCanvas gauge;
+ * gauge.begin(200, 200);                           // 80 KB in internal SRAM
+ * gauge.clear(COLOR_BLACK);
+ * gauge.circle(100, 100, 98, COLOR_WHITE);         // Expensive face, drawn once
+ * gauge.text(70, 150, "km/h", COLOR_GRAY, COLOR_BLACK, 2);
+ *
+ * void loop() {
+ *     FastGraphics::drawCanvas(300, 140, gauge);   // One row copy per line
+ *     FastGraphics::line(400, 240, needle_x, needle_y, COLOR_RED);
+ *     FastGraphics::flush();
+ * }
+ * @endcode
+ */
+class FastCanvas {
+public:
+    // =============================================================================
+    // CANVAS SETUP
+    // =============================================================================
+
+    /**
+     * @brief Create an empty canvas
+     * @details Draws nothing until begin() or setBuffer() gave it pixels.
+     */
+    FastCanvas();
+
+    /**
+     * @brief Create a canvas on an existing buffer
+     * @param buffer RGB565 pixels, at least stride * height
+     * @param width Buffer width in pixels
+     * @param height Buffer height in pixels
+     * @param stride Pixels from one row to the next (default: 0, same as width)
+     */
+    FastCanvas(uint16_t* buffer, int16_t width, int16_t height, int16_t stride = 0);
+
+    /**
+     * @brief Free the buffer if begin() allocated it
+     */
+    ~FastCanvas();
+
+    FastCanvas(const FastCanvas&) = delete;
+    FastCanvas& operator=(const FastCanvas&) = delete;
+
+    /**
+     * @brief Allocate a buffer for the canvas
+     * @details Internal SRAM by default, which is several times faster to draw into
+     *          and to copy from than PSRAM. The content is undefined until drawn.
+     *
+     * @param width Canvas width in pixels
+     * @param height Canvas height in pixels
+     * @param caps heap_caps_malloc() capabilities (MALLOC_CAP_SPIRAM for large canvases)
+     * @return false if the allocation failed
+     *
+     * @note A previously allocated buffer is freed first
+     */
+    bool begin(int16_t width, int16_t height, uint32_t caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+
+    /**
+     * @brief Free the buffer allocated by begin() and detach from any buffer
+     */
+    void end();
+
+    /**
+     * @brief Point the canvas at an existing buffer
+     * @details Keeps the rotation; the logical size follows the new buffer.
+     *
+     * @param buffer RGB565 pixels, at least stride * height
+     * @param width Buffer width in pixels
+     * @param height Buffer height in pixels
+     * @param stride Pixels from one row to the next (default: 0, same as width)
+     */
+    void setBuffer(uint16_t* buffer, int16_t width, int16_t height, int16_t stride = 0);
+
+    /**
+     * @brief Keep only some buffer rows in memory
+     * @details The canvas still covers the whole buffer size, but only rows
+     *          [row0, row1) exist, starting at rows; drawing elsewhere is clipped.
+     *          This is how replay bands render a strip of a larger frame.
+     *
+     * @param rows Pixels of row row0
+     * @param row0 First row held (inclusive)
+     * @param row1 Last row held (exclusive)
+     */
+    void setRows(uint16_t* rows, int16_t row0, int16_t row1);
+
+    /**
+     * @brief Set the canvas rotation
+     * @details Portrait rotations swap the logical width and height.
+     */
+    void setRotation(ScreenRotation rotation);
+
+    /**
+     * @brief Get the canvas rotation
+     */
+    ScreenRotation getRotation() const { return rotation; }
+
+    /**
+     * @brief Get the logical width in the current rotation
+     */
+    int16_t getWidth() const { return width; }
+
+    /**
+     * @brief Get the logical height in the current rotation
+     */
+    int16_t getHeight() const { return height; }
+
+    /**
+     * @brief Get the buffer (row 0, or the first row held after setRows())
+     */
+    uint16_t* getBuffer() const { return pixels; }
+
+    /**
+     * @brief Get the buffer width in pixels, independent of rotation
+     */
+    int16_t getBufferWidth() const { return buffer_width; }
+
+    /**
+     * @brief Get the buffer height in pixels, independent of rotation
+     */
+    int16_t getBufferHeight() const { return buffer_height; }
+
+    /**
+     * @brief Get the row stride in pixels
+     */
+    int16_t getStride() const { return stride; }
+
+    /**
+     * @brief Queue large fills and copies to FastDMA
+     * @details Same behaviour as FastGraphics::setAsync() for this canvas: CPU
+     *          drawing waits only for transfers overlapping its pixels.
+     * @return false if the DMA driver could not be installed
+     */
+    bool setAsync(bool enable);
+
+    /**
+     * @brief Check whether large writes go to FastDMA
+     */
+    bool getAsync() const { return async; }
+
+    /**
+     * @brief Draw scaled opaque text from a glyph cache
+     * @param cache Cache to copy glyphs from, nullptr to rasterise every glyph
+     * @note The cache is not owned and may be shared by canvases drawn from one task
+     */
+    void setGlyphCache(FastGlyphCache* cache) { glyph_cache = cache; }
+
+    /**
+     * @brief Get the glyph cache in use, nullptr if none
+     */
+    FastGlyphCache* getGlyphCache() const { return glyph_cache; }
+
+    // =============================================================================
+    // CLIPPING
+    // =============================================================================
+
+    /**
+     * @brief Restrict drawing to a logical rectangle
+     * @details Every primitive draws only inside the visible area: the canvas, the
+     *          rows held and this rectangle. The area is intersected once per call
+     *          (or per span), never per pixel. Stays set across setBuffer(),
+     *          setRows() and setRotation() (in logical coordinates).
+     * @see FastGraphics::pushClip()
+     */
+    void setClip(int16_t x, int16_t y, int16_t w, int16_t h);
+
+    /**
+     * @brief Draw on the whole canvas again
+     */
+    void resetClip();
+
+    /**
+     * @brief Get the visible area: canvas, rows held and clip rectangle intersected
+     * @return false if nothing is visible
+     */
+    bool getClip(int16_t& x, int16_t& y, int16_t& w, int16_t& h) const;
+
+    // =============================================================================
+    // DRAWING FUNCTIONS
+    // =============================================================================
+
+    /**
+     * @brief Fill the whole canvas
+     */
+    void clear(uint16_t color);
+
+    /**
+     * @brief Draw a single pixel (clipped)
+     */
+    void pixel(int16_t x, int16_t y, uint16_t color);
+
+    /**
+     * @brief Draw a filled rectangle
+     * @details Clips once and fills whole buffer rows with FastKernels::fill16() in
+     *          every rotation; a rectangle spanning contiguous rows is one run.
+     */
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+    /**
+     * @brief Draw a rectangle outline
+     */
+    void rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+    /**
+     * @brief Draw a line (horizontal and vertical lines are rectangle fills)
+     */
+    void line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+
+    /**
+     * @brief Draw a circle outline
+     */
+    void circle(int16_t x0, int16_t y0, int16_t radius, uint16_t color);
+
+    /**
+     * @brief Draw a filled circle
+     */
+    void fillCircle(int16_t x0, int16_t y0, int16_t radius, uint16_t color);
+
+    /**
+     * @brief Draw an anti-aliased line, 1 pixel wide
+     * @see FastGraphics::lineAA()
+     */
+    void lineAA(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+
+    /**
+     * @brief Draw an anti-aliased line with round caps
+     * @see FastGraphics::thickLineAA()
+     */
+    void thickLineAA(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t thickness, uint16_t color);
+
+    /**
+     * @brief Draw an anti-aliased circle outline, 1 pixel wide
+     * @see FastGraphics::circleAA()
+     */
+    void circleAA(int16_t x0, int16_t y0, int16_t radius, uint16_t color);
+
+    /**
+     * @brief Draw an anti-aliased filled circle
+     * @see FastGraphics::fillCircleAA()
+     */
+    void fillCircleAA(int16_t x0, int16_t y0, int16_t radius, uint16_t color);
+
+    /**
+     * @brief Draw an anti-aliased arc
+     * @see FastGraphics::arcAA()
+     */
+    void arcAA(int16_t x0, int16_t y0, int16_t radius, int16_t start_angle, int16_t end_angle,
+               uint8_t thickness, uint16_t color);
+
+    /**
+     * @brief Draw one character of the built-in 8x8 font
+     * @param c Character (ASCII 0-127, others are ignored)
+     * @param color RGB565 foreground color
+     * @param bg RGB565 background color (same as color: transparent background)
+     * @param size Scaling factor
+     */
+    void drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size = 1);
+
+    /**
+     * @brief Draw a string, '\n' starts a new line at x
+     */
+    void text(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size = 1);
+
+    /**
+     * @brief Draw one glyph of a proportional font, transparent background
+     * @param x, y Pen position on the baseline
+     * @param font Font table (see FastFont.h)
+     * @param bpp Bits per pixel of the table: 1, or 2, 4 or 8 for anti-aliased glyphs
+     * @param c Character code
+     * @return Pen advance in pixels, 0 if the font has no glyph for c
+     */
+    int16_t drawGlyph(int16_t x, int16_t y, const GFXfont* font, uint8_t bpp, uint16_t c, uint16_t color);
+
+    /**
+     * @brief Draw an RGB565 image, optionally with a transparent color key
+     * @see FastGraphics::drawImage()
+     */
+    void drawImage(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h);
+    void drawImage(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h, uint16_t transparent);
+
+    /**
+     * @brief Draw part of an RGB565 image, optionally with a transparent color key
+     * @see FastGraphics::blit()
+     */
+    void blit(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+              int16_t sx, int16_t sy, int16_t sw, int16_t sh);
+    void blit(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+              int16_t sx, int16_t sy, int16_t sw, int16_t sh, uint16_t transparent);
+
+    /**
+     * @brief Copy another canvas' buffer to (x, y)
+     * @details The source is copied as stored, so it should be drawn in ROTATION_0.
+     */
+    void drawCanvas(int16_t x, int16_t y, const FastCanvas& source);
+    void drawCanvas(int16_t x, int16_t y, const FastCanvas& source, uint16_t transparent);
+
+    /**
+     * @brief Draw a 1-bit bitmap (bg == color: clear bits are transparent)
+     * @see FastGraphics::drawBitmap()
+     */
+    void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                    uint16_t color, uint16_t bg);
+
+    /**
+     * @brief Draw a 4-bit paletted bitmap
+     * @see FastGraphics::drawBitmap4()
+     */
+    void drawBitmap4(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                     const uint16_t* palette, int16_t transparent = -1);
+
+    /**
+     * @brief Draw a compressed image (see FastImage.h)
+     * @see FastGraphics::drawCompressed()
+     */
+    void drawCompressed(int16_t x, int16_t y, const uint8_t* image);
+
+    /**
+     * @brief Draw part of a compressed image, decoding only the rows it covers
+     * @see FastGraphics::blitCompressed()
+     */
+    void blitCompressed(int16_t x, int16_t y, const uint8_t* image, int16_t sx, int16_t sy, int16_t sw, int16_t sh);
+
+    /**
+     * @brief Scroll the content of a rectangle up by dy pixels
+     * @see FastGraphics::scrollRect()
+     */
+    void scrollRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dy, uint16_t color);
+
+    // =============================================================================
+    // ALPHA BLENDING
+    // =============================================================================
+
+    /**
+     * @brief Blend a color over a single pixel (clipped)
+     * @see FastGraphics::blendPixel()
+     */
+    void blendPixel(int16_t x, int16_t y, uint16_t color, uint8_t alpha);
+
+    /**
+     * @brief Blend a color over a rectangle
+     * @details Clipped and mapped once like fillRect(), then blended row by row with
+     *          FastKernels::blend16().
+     * @see FastGraphics::fillRectAlpha()
+     */
+    void fillRectAlpha(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, uint8_t alpha);
+
+    /**
+     * @brief Darken a rectangle by a power of two per channel
+     * @see FastGraphics::dimRect()
+     */
+    void dimRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t level = 1);
+
+    /**
+     * @brief Blend an RGB565 image with constant opacity, optionally color keyed
+     * @see FastGraphics::drawImageAlpha()
+     */
+    void drawImageAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h, uint8_t alpha);
+    void drawImageAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h, uint8_t alpha,
+                        uint16_t transparent);
+
+    /**
+     * @brief Blend part of an RGB565 image with constant opacity, optionally color keyed
+     * @see FastGraphics::blitAlpha()
+     */
+    void blitAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                   int16_t sx, int16_t sy, int16_t sw, int16_t sh, uint8_t alpha);
+    void blitAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                   int16_t sx, int16_t sy, int16_t sw, int16_t sh, uint8_t alpha, uint16_t transparent);
+
+    /**
+     * @brief Draw a color through an 8-bit coverage mask
+     * @see FastGraphics::drawMask()
+     */
+    void drawMask(int16_t x, int16_t y, const uint8_t* mask, int16_t w, int16_t h, uint16_t color);
+
+    // =============================================================================
+    // COORDINATE MAPPING
+    // =============================================================================
+
+    /**
+     * @brief Transform logical coordinates to buffer coordinates
+     * @param x Reference to X coordinate (modified in-place)
+     * @param y Reference to Y coordinate (modified in-place)
+     */
+    void transformCoordinates(int16_t& x, int16_t& y) const;
+
+    /**
+     * @brief Transform a logical rectangle to its buffer rectangle
+     * @details Every rotation maps an axis-aligned rectangle to an axis-aligned
+     *          rectangle, so only the origin moves and width/height may swap.
+     * @note The rectangle must already be clipped to the logical canvas
+     */
+    void transformRect(int16_t& x, int16_t& y, int16_t& w, int16_t& h) const;
+
+    /**
+     * @brief Clip a logical rectangle to the visible area (canvas, rows held, clip)
+     * @param x0, y0 Top-left corner (inclusive), adjusted in place
+     * @param x1, y1 Bottom-right corner (exclusive), adjusted in place
+     * @return false if nothing is left
+     */
+    bool clip(int16_t& x0, int16_t& y0, int16_t& x1, int16_t& y1) const;
+
+    /**
+     * @brief Get the buffer address of a logical pixel and the rotation steps
+     * @details Returns where logical (x, y) lives in the buffer plus how far the
+     *          address moves for +1 in logical x and +1 in logical y. Lets inner loops
+     *          walk rotated shapes with pointer increments only.
+     *
+     * @param x Logical X coordinate (must be on the canvas, in a row held)
+     * @param y Logical Y coordinate (must be on the canvas, in a row held)
+     * @param step_x Receives the address step for x + 1
+     * @param step_y Receives the address step for y + 1
+     */
+    uint16_t* physicalAddress(int16_t x, int16_t y, int32_t& step_x, int32_t& step_y) const;
+
+#if FG_PROFILE
+    static uint32_t pixels_written;     /**< Pixels written by all canvases, read by the profiler */
+#endif
+
+private:
+    uint16_t* pixels;           /**< First row held */
+    int16_t buffer_width;       /**< Buffer width (rotation independent) */
+    int16_t buffer_height;      /**< Buffer height (rotation independent) */
+    int16_t stride;             /**< Pixels between rows */
+    int16_t row0, row1;         /**< Buffer rows held, end-exclusive */
+    ScreenRotation rotation;    /**< Logical to buffer mapping */
+    int16_t width, height;      /**< Logical size in the current rotation */
+    int16_t clip_x0, clip_y0;   /**< Clip rectangle, logical (inclusive) */
+    int16_t clip_x1, clip_y1;   /**< Clip rectangle, logical (exclusive) */
+    int16_t vis_x0, vis_y0;     /**< Visible area: canvas, rows held and clip (inclusive) */
+    int16_t vis_x1, vis_y1;     /**< Visible area (exclusive) */
+    FastGlyphCache* glyph_cache; /**< Tiles for scaled opaque text, nullptr for none */
+    bool async;                 /**< Large writes go to FastDMA */
+    bool owned;                 /**< Buffer allocated by begin() */
+
+    /**
+     * @brief Recompute the visible area after a change of buffer, rows, rotation or clip
+     */
+    void updateVisible();
+
+    /**
+     * @brief Cohen-Sutherland outcode of a point against the visible area
+     * @return Bits 1/2/4/8 for left/right/above/below, 0 inside
+     */
+    uint8_t outcode(int16_t x, int16_t y) const;
+
+    /**
+     * @brief Draw a pixel without DMA fence (the caller fenced its bounding box)
+     */
+    void plot(int16_t x, int16_t y, uint16_t color);
+
+    /**
+     * @brief Clip a logical rectangle and get its buffer rectangle for CPU access
+     * @details Waits for DMA transfers into the rectangle in async mode.
+     * @param x, y, w, h Logical rectangle, replaced by the buffer rectangle
+     * @return First buffer pixel of the rectangle, nullptr if nothing is visible
+     */
+    uint16_t* lockRect(int16_t& x, int16_t& y, int16_t& w, int16_t& h);
+
+    /**
+     * @brief Copy or blend RGB565 pixels
+     * @param src First source pixel drawn at (x, y)
+     * @param src_stride Source row stride in pixels
+     * @param alpha Opacity of the source (255: plain copy)
+     */
+    void copyPixels(int16_t x, int16_t y, const uint16_t* src, int16_t src_stride, int16_t w, int16_t h,
+                    bool keyed, uint16_t key, uint8_t alpha);
+
+    /**
+     * @brief Draw a 1-bit or 4-bit bitmap
+     * @param bpp Bits per pixel (1 or 4)
+     * @param palette 2 or 16 RGB565 colors indexed by the pixel value
+     * @param transparent Index that is not drawn, -1 for none
+     */
+    void drawPacked(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                    uint8_t bpp, const uint16_t* palette, int16_t transparent);
+
+    /**
+     * @brief Draw an anti-aliased ring, disc or arc around (x0, y0)
+     * @param outer16 Outer edge radius in 1/16 pixel
+     * @param inner16 Inner edge radius in 1/16 pixel (-8 or less: solid disc)
+     * @param start_angle, end_angle Arc in degrees, clockwise from 12 o'clock
+     * @param full true to ignore the angles and draw the whole ring
+     */
+    void ringAA(int16_t x0, int16_t y0, int32_t outer16, int32_t inner16,
+                int16_t start_angle, int16_t end_angle, bool full, uint16_t color);
+
+    /**
+     * @brief Wait for DMA transfers overlapping a logical rectangle
+     * @details No-op unless async mode has transfers in flight.
+     */
+    void dmaFence(int16_t x, int16_t y, int16_t w, int16_t h);
+};
+
+#endif // FAST_CANVAS_H
@@ -0,0 +1,104 @@
+// FastDMA.h - Asynchronous framebuffer fills and copies for FastGraphics
+// Offloads large memory writes to the ESP32-S3 GDMA through esp_async_memcpy
+
+#ifndef FAST_DMA_H
+#define FAST_DMA_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =============================================================================
+// DMA CONFIGURATION
+// =============================================================================
+
+#ifndef FG_DMA_BACKLOG
+#define FG_DMA_BACKLOG 200          /**< Transfers queued at once (an 800x480 clear needs 191) */
+#endif
+
+#define FG_DMA_ALIGN 64             /**< PSRAM transfer alignment: one cache line, address and size */
+#define FG_DMA_CHUNK_BYTES 4032     /**< Bytes per transfer, fits one DMA descriptor (max 4095) */
+#define FG_DMA_PATTERNS 2           /**< Fill pattern buffers, so a new color rarely waits */
+
+// =============================================================================
+// FASTDMA CLASS
+// =============================================================================
+
+/**
+ * @class FastDMA
+ * @brief Queued memory-to-memory fills and copies on the GDMA
+ * @details fill16() and copy16() mirror FastKernels but return as soon as the work is
+ *          queued. The cache-line aligned middle of each run goes to the DMA; the
+ *          unaligned head and tail (at most 31 pixels each) are written by the CPU
+ *          right away. Fills copy from an internal-SRAM pattern buffer holding the
+ *          color, so any length is a series of FG_DMA_CHUNK_BYTES transfers.
+ *
+ *          Transfers run in the order they were queued. CPU writes must not overlap
+ *          queued transfers: call waitFor() or waitIdle() first. FastGraphics does
+ *          this itself in every CPU drawing path (see FastGraphics::setAsync()).
+ *
+ * @note Cache coherency is handled here: destination (and PSRAM source) cache lines
+ *       are written back before a transfer and invalidated once it completed
+ * @note Sources must be DMA-readable (internal SRAM or PSRAM); copies from flash
+ *       fall back to the CPU transparently
+ * @note Without begin() (or if it failed) every call runs on the CPU
+ *
+ * @example
+ * @code
+ * FastDMA::begin();
+ * FastDMA::fill16(frame_buffer, COLOR_BLACK, 800 * 480);   // Returns in a few us
+ * computeSensorFusion();                                   // Runs while the DMA clears
+ * FastDMA::waitIdle();
+ * @endcode
+ */
+class FastDMA {
+public:
+    /**
+     * @brief Install the async memcpy driver and allocate the pattern buffers
+     * @return false if the driver or the buffers could not be set up
+     * @note Safe to call more than once
+     */
+    static bool begin();
+
+    /**
+     * @brief Check whether begin() succeeded
+     */
+    static bool isReady();
+
+    /**
+     * @brief Fill with a color, asynchronously where possible
+     * @param dst Destination (2-byte aligned)
+     * @param color RGB565 fill color
+     * @param count Number of pixels
+     */
+    static void fill16(uint16_t* dst, uint16_t color, size_t count);
+
+    /**
+     * @brief Copy pixels, asynchronously where possible
+     * @param dst Destination
+     * @param src Source, must stay unchanged until the copy completed
+     * @param count Number of pixels
+     * @note Regions must not overlap
+     */
+    static void copy16(uint16_t* dst, const uint16_t* src, size_t count);
+
+    /**
+     * @brief Check whether transfers are still queued or running
+     */
+    static bool isBusy();
+
+    /**
+     * @brief Wait until all queued transfers completed
+     * @details Blocks the calling task on a semaphore given by the DMA interrupt,
+     *          then invalidates the cache lines the transfers wrote.
+     */
+    static void waitIdle();
+
+    /**
+     * @brief Wait only if a memory range overlaps queued transfers
+     * @param addr Start of the range the CPU is about to access
+     * @param bytes Length of the range
+     */
+    static void waitFor(const void* addr, size_t bytes);
+};
+
+#endif // FAST_DMA_H
@@ -0,0 +1,55 @@
+// FastFont.h - Proportional bitmap font tables for FastGraphics
+// Adafruit-GFX compatible layout, optionally with anti-aliased (2/4/8-bit) glyphs
+
+#ifndef FAST_FONT_H
+#define FAST_FONT_H
+
+#include <stdint.h>
+
+// =============================================================================
+// FONT TABLES
+// =============================================================================
+
+// Same definitions (and include guard) as Adafruit GFX's gfxfont.h, so font headers
+// generated by its fontconvert tool work unchanged, with or without that library
+#ifndef _GFXFONT_H_
+#define _GFXFONT_H_
+
+/**
+ * @struct GFXglyph
+ * @brief Metrics of one glyph and where its pixels start
+ * @details The glyph box is width x height pixels, placed at (xOffset, yOffset)
+ *          from the pen position on the baseline; the pen then moves xAdvance.
+ */
+typedef struct {
+    uint16_t bitmapOffset;  /**< First byte of the glyph in GFXfont::bitmap */
+    uint8_t width;          /**< Glyph box width in pixels */
+    uint8_t height;         /**< Glyph box height in pixels */
+    uint8_t xAdvance;       /**< Pen advance to the next glyph */
+    int8_t xOffset;         /**< Box left edge relative to the pen */
+    int8_t yOffset;         /**< Box top edge relative to the baseline (negative: above) */
+} GFXglyph;
+
+/**
+ * @struct GFXfont
+ * @brief A font: glyph table for the codes first..last and their packed pixels
+ * @details Glyph pixels are one continuous bit stream per glyph, row by row,
+ *          most significant bit first, without padding at the end of a row.
+ */
+typedef struct {
+    uint8_t* bitmap;        /**< Packed glyph pixels */
+    GFXglyph* glyph;        /**< One entry per code, glyph[code - first] */
+    uint16_t first;         /**< First character code */
+    uint16_t last;          /**< Last character code */
+    uint8_t yAdvance;       /**< Line height */
+} GFXfont;
+
+#endif // _GFXFONT_H_
+
+/**
+ * @note FastGraphics::setFont() takes the bits per pixel of the table separately:
+ *       1 is the fontconvert format, 2, 4 or 8 store anti-aliased coverage per
+ *       pixel in the same stream layout (0 = background, all ones = solid).
+ */
+
+#endif // FAST_FONT_H
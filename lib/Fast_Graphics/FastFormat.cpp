@@ -0,0 +1,283 @@
+// FastFormat.cpp - Allocation-free number formatting implementation
+
+#include "FastFormat.h"
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief Two-digit lookup table "00".."99"
+ * @details Halves the number of divisions compared to one digit per step.
+ */
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const uint32_t powers_of_ten[FG_FORMAT_MAX_DECIMALS + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+// =============================================================================
+// INTEGER FORMATTING
+// =============================================================================
+
+/**
+ * @brief Write a 32-bit value right-aligned ending just before end
+ * @implementation Two digits per division using the pair table.
+ * @return Pointer to the first digit written
+ */
+static char* writeDigits32(char* end, uint32_t value) {
+    while (value >= 100) {
+        uint32_t pair = (value % 100) * 2;
+        value /= 100;
+        *--end = digit_pairs[pair + 1];
+        *--end = digit_pairs[pair];
+    }
+    if (value >= 10) {
+        *--end = digit_pairs[value * 2 + 1];
+        *--end = digit_pairs[value * 2];
+    } else {
+        *--end = (char)('0' + value);
+    }
+    return end;
+}
+
+/**
+ * @brief Format an unsigned integer in decimal
+ * @implementation Builds digits backwards in a scratch buffer, then copies them.
+ *                 Values above 32 bits are split by 10^9 so the inner loop never
+ *                 needs 64-bit division per digit.
+ */
+size_t FastFormat::formatUnsigned(char* buf, uint64_t value) {
+    char scratch[FG_FORMAT_BUFFER_SIZE];
+    char* end = scratch + sizeof(scratch);
+    char* start;
+
+    if (value <= 0xFFFFFFFFu) {
+        start = writeDigits32(end, (uint32_t)value);
+    } else {
+        // Low 9 digits, zero padded, then the rest
+        uint32_t low = (uint32_t)(value % 1000000000u);
+        uint64_t high = value / 1000000000u;
+        start = writeDigits32(end, low);
+        while (start > end - 9) *--start = '0';
+        if (high <= 0xFFFFFFFFu) {
+            start = writeDigits32(start, (uint32_t)high);
+        } else {
+            uint32_t mid = (uint32_t)(high % 1000000000u);
+            char* mid_end = start;
+            start = writeDigits32(start, mid);
+            while (start > mid_end - 9) *--start = '0';
+            start = writeDigits32(start, (uint32_t)(high / 1000000000u));
+        }
+    }
+
+    size_t len = end - start;
+    memcpy(buf, start, len);
+    buf[len] = '\0';
+    return len;
+}
+
+size_t FastFormat::formatSigned(char* buf, int64_t value) {
+    if (value < 0) {
+        buf[0] = '-';
+        // Negate in unsigned space so INT64_MIN works
+        return 1 + formatUnsigned(buf + 1, (uint64_t)0 - (uint64_t)value);
+    }
+    return formatUnsigned(buf, (uint64_t)value);
+}
+
+size_t FastFormat::formatHex(char* buf, uint64_t value, bool uppercase) {
+    const char* digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    char scratch[FG_FORMAT_BUFFER_SIZE];
+    char* end = scratch + sizeof(scratch);
+    char* start = end;
+    do {
+        *--start = digits[value & 0xF];
+        value >>= 4;
+    } while (value);
+
+    size_t len = end - start;
+    memcpy(buf, start, len);
+    buf[len] = '\0';
+    return len;
+}
+
+// =============================================================================
+// FIXED-POINT FORMATTING
+// =============================================================================
+
+/**
+ * @brief Format a floating point number with a fixed number of decimals
+ * @implementation Adds half a unit of the last decimal once, splits into integer
+ *                 and fraction, scales the fraction by 10^decimals and prints both
+ *                 as integers (fraction zero padded to the requested width).
+ */
+size_t FastFormat::formatFixed(char* buf, double value, int decimals) {
+    if (isnan(value)) { memcpy(buf, "nan", 4); return 3; }
+
+    size_t len = 0;
+    if (value < 0) {
+        buf[len++] = '-';
+        value = -value;
+    }
+    if (isinf(value)) { memcpy(buf + len, "inf", 4); return len + 3; }
+    if (value > 1.8e19) { memcpy(buf, "ovf", 4); return 3; }
+
+    if (decimals < 0) decimals = 0;
+    if (decimals > FG_FORMAT_MAX_DECIMALS) decimals = FG_FORMAT_MAX_DECIMALS;
+    uint32_t scale = powers_of_ten[decimals];
+
+    // Round half away from zero
+    value += 0.5 / scale;
+    uint64_t integer_part = (uint64_t)value;
+    uint32_t fraction = (uint32_t)((value - (double)integer_part) * scale);
+    if (fraction >= scale) fraction = scale - 1;  // Guard against FP edge cases
+
+    len += formatUnsigned(buf + len, integer_part);
+    if (decimals > 0) {
+        buf[len++] = '.';
+        char* end = buf + len + decimals;
+        char* start = writeDigits32(end, fraction);
+        while (start > buf + len) *--start = '0';
+        len += decimals;
+        buf[len] = '\0';
+    }
+    return len;
+}
+
+// =============================================================================
+// PRINTF-STYLE FORMATTING
+// =============================================================================
+
+/**
+ * @brief Minimal printf-style formatter
+ * @implementation Single pass over the format string. Each conversion is rendered
+ *                 into a small stack buffer by the functions above, then padded
+ *                 and emitted; literal text is emitted directly.
+ */
+size_t FastFormat::vformat(void (*emit)(char c, void* context), void* context, const char* format, va_list args) {
+    size_t count = 0;
+    char number[FG_FORMAT_BUFFER_SIZE + 1];
+
+    while (*format) {
+        if (*format != '%') {
+            emit(*format++, context);
+            count++;
+            continue;
+        }
+        format++;
+
+        // Flags
+        bool left = false, zero = false, plus = false, space = false;
+        for (;; format++) {
+            if (*format == '-') left = true;
+            else if (*format == '0') zero = true;
+            else if (*format == '+') plus = true;
+            else if (*format == ' ') space = true;
+            else break;
+        }
+
+        // Width and precision
+        int width = 0;
+        if (*format == '*') { width = va_arg(args, int); format++; }
+        while (*format >= '0' && *format <= '9') width = width * 10 + (*format++ - '0');
+        int precision = -1;
+        if (*format == '.') {
+            format++;
+            precision = 0;
+            if (*format == '*') { precision = va_arg(args, int); format++; }
+            while (*format >= '0' && *format <= '9') precision = precision * 10 + (*format++ - '0');
+        }
+
+        // Length modifiers
+        int longs = 0;
+        while (*format == 'l' || *format == 'h') {
+            if (*format == 'l') longs++;
+            format++;
+        }
+
+        const char* str = number;
+        size_t len = 0;
+        bool numeric = true;
+        char conversion = *format ? *format++ : '\0';
+
+        switch (conversion) {
+            case 'd':
+            case 'i': {
+                int64_t v = longs >= 2 ? va_arg(args, long long)
+                          : longs == 1 ? va_arg(args, long) : va_arg(args, int);
+                char* p = number;
+                if (v >= 0 && (plus || space)) *p++ = plus ? '+' : ' ';
+                len = (p - number) + formatSigned(p, v);
+                break;
+            }
+            case 'u':
+            case 'x':
+            case 'X': {
+                uint64_t v = longs >= 2 ? va_arg(args, unsigned long long)
+                           : longs == 1 ? va_arg(args, unsigned long) : va_arg(args, unsigned int);
+                len = conversion == 'u' ? formatUnsigned(number, v) : formatHex(number, v, conversion == 'X');
+                break;
+            }
+            case 'f':
+            case 'F': {
+                double v = va_arg(args, double);
+                char* p = number;
+                if (v >= 0 && (plus || space)) *p++ = plus ? '+' : ' ';
+                len = (p - number) + formatFixed(p, v, precision < 0 ? 6 : precision);
+                break;
+            }
+            case 'c':
+                number[0] = (char)va_arg(args, int);
+                len = 1;
+                numeric = false;
+                break;
+            case 's':
+                str = va_arg(args, const char*);
+                if (!str) str = "(null)";
+                len = strlen(str);
+                if (precision >= 0 && (size_t)precision < len) len = precision;
+                numeric = false;
+                break;
+            case '%':
+                number[0] = '%';
+                len = 1;
+                numeric = false;
+                break;
+            default:
+                // Unknown conversion - emit it verbatim
+                number[0] = '%';
+                number[1] = conversion;
+                len = conversion ? 2 : 1;
+                numeric = false;
+                break;
+        }
+
+        // Padding: zeros go after the sign, spaces before or after the field
+        int pad = width > (int)len ? width - (int)len : 0;
+        if (!left && zero && numeric) {
+            size_t sign = (len > 0 && (str[0] == '-' || str[0] == '+' || str[0] == ' ')) ? 1 : 0;
+            for (size_t i = 0; i < sign; i++) { emit(str[i], context); count++; }
+            for (int i = 0; i < pad; i++) { emit('0', context); count++; }
+            str += sign;
+            len -= sign;
+            pad = 0;
+        }
+        if (!left) {
+            for (int i = 0; i < pad; i++) { emit(' ', context); count++; }
+        }
+        for (size_t i = 0; i < len; i++) { emit(str[i], context); count++; }
+        if (left) {
+            for (int i = 0; i < pad; i++) { emit(' ', context); count++; }
+        }
+    }
+    return count;
+}
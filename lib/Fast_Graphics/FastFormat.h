@@ -0,0 +1,96 @@
+// FastFormat.h - Allocation-free number formatting for FastGraphics
+// Digit-pair tables and fixed-point conversion, no libc printf
+
+#ifndef FAST_FORMAT_H
+#define FAST_FORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+
+// =============================================================================
+// FORMAT CONFIGURATION
+// =============================================================================
+
+#define FG_FORMAT_BUFFER_SIZE 34     /**< Longest FastFormat result plus terminator: sign,
+                                          20 integer digits, '.', 9 decimals (32 bytes),
+                                          with slack for a vformat '+' or ' ' flag */
+#define FG_FORMAT_MAX_DECIMALS 9     /**< Fraction digits supported by formatFixed() */
+
+// =============================================================================
+// FASTFORMAT CLASS
+// =============================================================================
+
+/**
+ * @class FastFormat
+ * @brief Number to text conversion without sprintf or heap allocation
+ * @details All functions write into a caller-supplied buffer of at least
+ *          FG_FORMAT_BUFFER_SIZE bytes, null-terminate it, and return the number of
+ *          characters written. Integers are converted two digits at a time from a
+ *          "00".."99" table; floating point values are rounded once and split into
+ *          integer and fraction parts that are converted as integers.
+ *
+ * @example
+ * @code
+ * char buf[FG_FORMAT_BUFFER_SIZE];
+ * size_t len = FastFormat::formatFixed(buf, 23.456, 1);   // "23.5", len = 4
+ * len = FastFormat::formatSigned(buf, -1234);             // "-1234", len = 5
+ * @endcode
+ */
+class FastFormat {
+public:
+    /**
+     * @brief Format an unsigned integer in decimal
+     * @param buf Output buffer (at least FG_FORMAT_BUFFER_SIZE bytes)
+     * @param value Value to format
+     * @return Number of characters written (excluding terminator)
+     */
+    static size_t formatUnsigned(char* buf, uint64_t value);
+
+    /**
+     * @brief Format a signed integer in decimal
+     * @param buf Output buffer (at least FG_FORMAT_BUFFER_SIZE bytes)
+     * @param value Value to format
+     * @return Number of characters written (excluding terminator)
+     */
+    static size_t formatSigned(char* buf, int64_t value);
+
+    /**
+     * @brief Format an unsigned integer in hexadecimal
+     * @param buf Output buffer (at least FG_FORMAT_BUFFER_SIZE bytes)
+     * @param value Value to format
+     * @param uppercase true for A-F, false for a-f
+     * @return Number of characters written (excluding terminator)
+     */
+    static size_t formatHex(char* buf, uint64_t value, bool uppercase = false);
+
+    /**
+     * @brief Format a floating point number with a fixed number of decimals
+     * @details Rounds half away from zero, like Arduino's Print class.
+     *
+     * @param buf Output buffer (at least FG_FORMAT_BUFFER_SIZE bytes)
+     * @param value Value to format
+     * @param decimals Fraction digits (clamped to 0..FG_FORMAT_MAX_DECIMALS)
+     * @return Number of characters written (excluding terminator)
+     *
+     * @note Prints "nan", "inf"/"-inf" and "ovf" (beyond ±1.8e19) like Arduino Print
+     * @note At most 31 characters, e.g. -17999999999999999999.123456789
+     */
+    static size_t formatFixed(char* buf, double value, int decimals);
+
+    /**
+     * @brief Minimal printf-style formatter that emits characters to a callback
+     * @details Supports %d %i %u %x %X %c %s %f %% with optional '-', '0', '+' and
+     *          ' ' flags, field width, precision and the 'l'/'ll'/'h' length modifiers.
+     *          Nothing is buffered beyond one number, so output of any length works.
+     *
+     * @param emit Called once per output character
+     * @param context Passed through to emit
+     * @param format printf-style format string
+     * @param args Arguments matching the format
+     * @return Number of characters emitted
+     */
+    static size_t vformat(void (*emit)(char c, void* context), void* context, const char* format, va_list args);
+};
+
+#endif // FAST_FORMAT_H
@@ -0,0 +1,135 @@
+// FastGlyphCache.cpp - Glyph tile cache implementation
+
+#include "FastGlyphCache.h"
+#include "FastCanvas.h"
+#include "FastDMA.h"
+#include <string.h>
+
+static_assert((FG_GLYPH_CACHE_ENTRIES & (FG_GLYPH_CACHE_ENTRIES - 1)) == 0 && FG_GLYPH_CACHE_ENTRIES <= 128,
+              "FG_GLYPH_CACHE_ENTRIES must be a power of two up to 128");
+
+// =============================================================================
+// SETUP
+// =============================================================================
+
+FastGlyphCache::FastGlyphCache()
+    : pool(nullptr), pool_pixels(0), used_pixels(0), stamp(0), hits(0), misses(0), entry_count(0) {
+    memset(buckets, NONE, sizeof(buckets));
+}
+
+FastGlyphCache::~FastGlyphCache() {
+    end();
+}
+
+bool FastGlyphCache::begin(size_t bytes, uint32_t caps) {
+    end();
+    pool = (uint16_t*)heap_caps_malloc(bytes, caps);
+    if (!pool) return false;
+    pool_pixels = bytes / sizeof(uint16_t);
+    hits = 0;
+    misses = 0;
+    clear();
+    return true;
+}
+
+void FastGlyphCache::end() {
+    if (pool) {
+        FastDMA::waitIdle();
+        heap_caps_free(pool);
+    }
+    pool = nullptr;
+    pool_pixels = 0;
+    clear();
+}
+
+void FastGlyphCache::clear() {
+    used_pixels = 0;
+    entry_count = 0;
+    memset(buckets, NONE, sizeof(buckets));
+}
+
+// =============================================================================
+// LOOKUP
+// =============================================================================
+
+uint8_t FastGlyphCache::hash(char c, uint8_t size, uint16_t color, uint16_t bg) {
+    uint32_t h = (uint8_t)c * 0x9E3779B1u ^ size * 0x85EBCA77u ^ color * 0xC2B2AE3Du ^ bg;
+    return (uint8_t)((h ^ (h >> 15)) & (FG_GLYPH_CACHE_ENTRIES - 1));
+}
+
+/**
+ * @brief Get the tile of a glyph, rendering it on a miss
+ * @implementation A miss renders the glyph with FastCanvas::drawChar() into the
+ *                 tile (a packed canvas in ROTATION_0), so tile and direct drawing
+ *                 are the same pixels by construction. Storage that is handed out
+ *                 again first waits for the DMA, which may still be copying it.
+ * @performance Hit: one hash and a short chain walk; miss: O(entries) LRU scan
+ *              plus the regular rendering
+ */
+const uint16_t* FastGlyphCache::get(char c, uint8_t size, uint16_t color, uint16_t bg) {
+    if (!pool || c < 0 || size == 0) return nullptr;
+    uint8_t bucket = hash(c, size, color, bg);
+    stamp++;
+    for (uint8_t i = buckets[bucket]; i != NONE; i = entries[i].next) {
+        Entry& e = entries[i];
+        if (e.c == c && e.size == size && e.color == color && e.bg == bg) {
+            e.last_used = stamp;
+            hits++;
+            return pool + e.offset;
+        }
+    }
+    
+    int16_t glyph_size = size * 8;
+    size_t tile_pixels = (size_t)glyph_size * glyph_size;
+    if (tile_pixels > pool_pixels) return nullptr;
+    size_t fresh = used_pixels;
+    uint8_t index = allocate(size, tile_pixels);
+    if (index == NONE) {
+        clear();
+        index = allocate(size, tile_pixels);
+    }
+    
+    Entry& e = entries[index];
+    if (e.offset < fresh) FastDMA::waitIdle();  // Reused tile may still be the source of a queued copy
+    e.c = c;
+    e.size = size;
+    e.color = color;
+    e.bg = bg;
+    e.last_used = stamp;
+    e.bucket = bucket;
+    e.next = buckets[bucket];
+    buckets[bucket] = index;
+    
+    FastCanvas tile(pool + e.offset, glyph_size, glyph_size);
+    tile.drawChar(0, 0, c, color, bg, size);
+    misses++;
+    return pool + e.offset;
+}
+
+/**
+ * @brief Find room for a tile
+ * @implementation The pool is a bump allocator; tiles are never freed one by one,
+ *                 only replaced by a glyph of the same size, which fits exactly.
+ */
+uint8_t FastGlyphCache::allocate(uint8_t size, size_t tile_pixels) {
+    if (entry_count < FG_GLYPH_CACHE_ENTRIES && used_pixels + tile_pixels <= pool_pixels) {
+        uint8_t index = entry_count++;
+        entries[index].offset = used_pixels;
+        used_pixels += tile_pixels;
+        return index;
+    }
+    uint8_t oldest = NONE;
+    for (uint8_t i = 0; i < entry_count; i++) {
+        if (entries[i].size == size && (oldest == NONE || entries[i].last_used < entries[oldest].last_used)) {
+            oldest = i;
+        }
+    }
+    if (oldest != NONE) unlink(oldest);
+    return oldest;
+}
+
+void FastGlyphCache::unlink(uint8_t index) {
+    uint8_t* link = &buckets[entries[index].bucket];
+    while (*link != index) link = &entries[*link].next;
+    *link = entries[index].next;
+}
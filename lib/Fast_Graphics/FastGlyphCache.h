@@ -0,0 +1,137 @@
+// FastGlyphCache.h - Pre-rendered glyphs for scaled text
+// Rasterises each (character, size, colors) once into RGB565 and copies it from then on
+
+#ifndef FAST_GLYPH_CACHE_H
+#define FAST_GLYPH_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_heap_caps.h"  // For the allocation capabilities in begin()
+
+// =============================================================================
+// GLYPH CACHE CONFIGURATION
+// =============================================================================
+
+#ifndef FG_GLYPH_CACHE_BYTES
+#define FG_GLYPH_CACHE_BYTES 32768  /**< Default pool: a size 4 glyph takes 2 KB, size 6 4.5 KB */
+#endif
+
+#ifndef FG_GLYPH_CACHE_ENTRIES
+#define FG_GLYPH_CACHE_ENTRIES 64   /**< Glyphs held at once, power of two up to 128 (also the hash size) */
+#endif
+
+#ifndef FG_GLYPH_CACHE_MIN_SIZE
+#define FG_GLYPH_CACHE_MIN_SIZE 2   /**< Smaller text is faster drawn directly than copied */
+#endif
+
+// =============================================================================
+// FASTGLYPHCACHE CLASS
+// =============================================================================
+
+/**
+ * @class FastGlyphCache
+ * @brief LRU atlas of scaled 8x8 font glyphs in RGB565
+ * @details A scaled character costs 2-4 fillRect() calls per font row, each with
+ *          its own clipping and rotation. Dashboards redraw the same few digits in
+ *          the same colors every frame, so the cache renders a glyph once into a
+ *          glyph_size x glyph_size RGB565 tile and FastCanvas::drawChar() copies the
+ *          tile with one row copy per line after that.
+ *
+ *          Lookup is a hash of (character, size, foreground, background) into
+ *          FG_GLYPH_CACHE_ENTRIES chained buckets. Tiles are carved from a single
+ *          pool; when it is full the least recently used tile of the same size is
+ *          replaced in place, and only if there is none the whole cache starts over.
+ *
+ * @note Opaque text only: transparent glyphs depend on what is behind them
+ * @note Not thread-safe; FastGraphics uses it from the one task that draws
+ *
+ * @example
+ * @code
+ * FastGraphics::setGlyphCache(true);                   // 32 KB pool, on first use
+ * FastGraphics::text(40, 40, speed, COLOR_WHITE, COLOR_BLACK, 6);
+ * @endcode
+ */
+class FastGlyphCache {
+public:
+    FastGlyphCache();
+    ~FastGlyphCache();
+
+    FastGlyphCache(const FastGlyphCache&) = delete;
+    FastGlyphCache& operator=(const FastGlyphCache&) = delete;
+
+    /**
+     * @brief Allocate the tile pool
+     * @param bytes Pool size
+     * @param caps heap_caps_malloc() capabilities; internal SRAM copies fastest,
+     *             MALLOC_CAP_SPIRAM still beats re-rasterising large glyphs
+     * @return false if the pool could not be allocated
+     */
+    bool begin(size_t bytes = FG_GLYPH_CACHE_BYTES, uint32_t caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+
+    /**
+     * @brief Free the pool
+     */
+    void end();
+
+    /**
+     * @brief Drop all tiles, keep the pool
+     */
+    void clear();
+
+    /**
+     * @brief Get the tile of a glyph, rendering it on a miss
+     * @param c Character (ASCII 0-127)
+     * @param size Scaling factor, the tile is 8 * size pixels square
+     * @return Tile pixels (row stride 8 * size), nullptr if the glyph cannot be cached
+     */
+    const uint16_t* get(char c, uint8_t size, uint16_t color, uint16_t bg);
+
+    /**
+     * @brief Check whether the pool is allocated
+     */
+    bool isActive() const { return pool != nullptr; }
+
+    uint32_t getHits() const { return hits; }      /**< Glyphs drawn from a tile */
+    uint32_t getMisses() const { return misses; }  /**< Glyphs rendered into a tile */
+
+private:
+    static const uint8_t NONE = 0xFF;   /**< Empty bucket / end of a chain */
+
+    /**
+     * @struct Entry
+     * @brief One cached tile
+     */
+    struct Entry {
+        uint32_t offset;        /**< First tile pixel in the pool */
+        uint32_t last_used;     /**< Use stamp for LRU replacement */
+        uint16_t color, bg;     /**< Key: colors */
+        char c;                 /**< Key: character */
+        uint8_t size;           /**< Key: scale */
+        uint8_t next;           /**< Next entry in the bucket */
+        uint8_t bucket;         /**< Bucket holding the entry */
+    };
+
+    uint16_t* pool;             /**< Tile storage */
+    size_t pool_pixels;         /**< Pool size in pixels */
+    size_t used_pixels;         /**< Pool pixels handed out to tiles */
+    uint32_t stamp;             /**< Incremented per lookup */
+    uint32_t hits, misses;
+    uint8_t entry_count;        /**< Entries handed out */
+    Entry entries[FG_GLYPH_CACHE_ENTRIES];
+    uint8_t buckets[FG_GLYPH_CACHE_ENTRIES];
+
+    static uint8_t hash(char c, uint8_t size, uint16_t color, uint16_t bg);
+
+    /**
+     * @brief Find room for a tile: free pool space, else the LRU tile of that size
+     * @return Entry index (unlinked from its bucket), NONE if the cache must start over
+     */
+    uint8_t allocate(uint8_t size, size_t tile_pixels);
+
+    /**
+     * @brief Remove an entry from its bucket chain
+     */
+    void unlink(uint8_t index);
+};
+
+#endif // FAST_GLYPH_CACHE_H
@@ -2,15 +2,32 @@
 // Comprehensive JSDoc-style documentation for all functions
 
 #include "FastGraphics.h"
+#include "FastKernels.h"
+#include "FastDMA.h"
+#include "FastFormat.h"
+#include "esp_lcd_panel_rgb.h"  // For frame buffer access and VSYNC callbacks
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"      // For the internal-SRAM band buffer
+#if FG_PROFILE
+#include "esp_cpu.h"    // For esp_cpu_get_cycle_count()
+#include "esp_timer.h"  // For esp_timer_get_time()
+#endif
 
 // =============================================================================
 // STATIC VARIABLES
 // =============================================================================
 
 uint16_t* FastGraphics::frame_buffer = nullptr;
-ScreenRotation FastGraphics::current_rotation = ROTATION_0;
-int16_t FastGraphics::display_width = LCD_H_RES;
-int16_t FastGraphics::display_height = LCD_V_RES;
+FastCanvas FastGraphics::screen;
+uint16_t* FastGraphics::shadow_buffer = nullptr;
+bool FastGraphics::rotate_on_flush = false;
+ScreenRotation FastGraphics::shadow_rotation = ROTATION_0;
+int16_t FastGraphics::viewport_y = 0;
+int16_t FastGraphics::viewport_top = 0;
+int16_t FastGraphics::viewport_rows = 0;
+int16_t FastGraphics::viewport_offset = 0;
 
 // Text cursor and settings
 int16_t FastGraphics::cursor_x = 0;
@@ -24,144 +41,148 @@ int16_t FastGraphics::text_area_y = 0;
 int16_t FastGraphics::text_area_w = LCD_H_RES;
 int16_t FastGraphics::text_area_h = LCD_V_RES;
 int16_t FastGraphics::line_spacing = 2;  // Default 2 pixels between lines
+bool FastGraphics::text_scroll = false;
+const GFXfont* FastGraphics::font = nullptr;
+uint8_t FastGraphics::font_bpp = 1;
+int16_t FastGraphics::font_ascent = 0;
+FastGlyphCache FastGraphics::glyph_cache;
+
+// Dirty region tracking
+esp_lcd_panel_handle_t FastGraphics::panel = nullptr;
+uint16_t* FastGraphics::front_buffer = nullptr;
+bool FastGraphics::double_buffered = false;
+FastGraphics::DirtyRect FastGraphics::dirty_rects[FG_MAX_DIRTY_RECTS];
+uint8_t FastGraphics::dirty_count = 0;
+
+// Deferred rendering
+bool FastGraphics::deferred = false;
+DrawCommand* FastGraphics::commands = nullptr;
+uint16_t FastGraphics::command_count = 0;
+DrawCommand* FastGraphics::command_lists[2] = { nullptr, nullptr };
+uint16_t* FastGraphics::band_buffer = nullptr;
+uint8_t* FastGraphics::indexed_buffer = nullptr;
+PixelFormat FastGraphics::pixel_format = PIXEL_RGB565;
+const FastPalette* FastGraphics::index_palette = nullptr;
+uint32_t FastGraphics::dropped_commands = 0;
+
+// Asynchronous DMA drawing
+bool FastGraphics::async_mode = false;
+
+// Render task
+bool FastGraphics::recording = false;
+TaskHandle_t FastGraphics::render_task = nullptr;
+FastGraphics::QueuedCommand* FastGraphics::queue = nullptr;
+uint32_t FastGraphics::queue_head = 0;
+uint32_t FastGraphics::queue_tail = 0;
+bool FastGraphics::queue_waiting = false;
+uint32_t FastGraphics::queue_stalls = 0;
+
+// Clipping
+FastGraphics::ClipRect FastGraphics::clip_stack[FG_CLIP_DEPTH];
+uint8_t FastGraphics::clip_depth = 0;
+
+static_assert((FG_QUEUE_COMMANDS & (FG_QUEUE_COMMANDS - 1)) == 0, "FG_QUEUE_COMMANDS must be a power of two");
+#if !LCD_RUNTIME_PANEL
+static_assert(LCD_H_RES % 8 == 0, "Index buffer rows must be whole bytes in every format");
+#endif
+
+// Given by the render task when the queue has room again, and on CMD_SYNC/CMD_STOP
+static SemaphoreHandle_t queue_space = nullptr;
+static SemaphoreHandle_t sync_semaphore = nullptr;
+
+// Framebuffer-less mode: frame shown by renderBand() and the one flush() hands over
+static DrawCommand* volatile shown_commands = nullptr;
+static volatile uint16_t shown_count = 0;
+static DrawCommand* volatile pending_commands = nullptr;
+static volatile uint16_t pending_count = 0;
+
+// Given from the panel's VSYNC interrupt, taken by present() in double-buffer mode
+static SemaphoreHandle_t vsync_semaphore = nullptr;
+static volatile uint32_t vsync_count = 0;   // VSYNCs since start-up, wraps
 
 /**
- * @brief 8x8 pixel font bitmap data
- * @details Contains bitmap data for ASCII characters 0-127. Each character is
- *          defined as 8 bytes representing 8 rows of 8 pixels each.
- * @note Bit 0 = leftmost pixel, bit 7 = rightmost pixel in each row
- */
-const uint8_t font8x8_basic[128][8] = {
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0000 (nul)
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0001
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0002
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0003
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0004
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0005
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0006
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0007
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0008
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0009
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+000A
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+000B
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+000C
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+000D
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+000E
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+000F
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0010
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0011
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0012
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0013
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0014
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0015
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0016
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0017
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0018
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0019
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+001A
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+001B
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+001C
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+001D
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+001E
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+001F
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0020 (space)
-    { 0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00},   // U+0021 (!)
-    { 0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0022 (")
-    { 0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00},   // U+0023 (#)
-    { 0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00},   // U+0024 ($)
-    { 0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00},   // U+0025 (%)
-    { 0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00},   // U+0026 (&)
-    { 0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0027 (')
-    { 0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00},   // U+0028 (()
-    { 0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00},   // U+0029 ())
-    { 0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00},   // U+002A (*)
-    { 0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00},   // U+002B (+)
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x06, 0x00},   // U+002C (,)
-    { 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00},   // U+002D (-)
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00},   // U+002E (.)
-    { 0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00},   // U+002F (/)
-    { 0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00},   // U+0030 (0)
-    { 0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00},   // U+0031 (1)
-    { 0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00},   // U+0032 (2)
-    { 0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00},   // U+0033 (3)
-    { 0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00},   // U+0034 (4)
-    { 0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00},   // U+0035 (5)
-    { 0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00},   // U+0036 (6)
-    { 0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00},   // U+0037 (7)
-    { 0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00},   // U+0038 (8)
-    { 0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00},   // U+0039 (9)
-    { 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00},   // U+003A (:)
-    { 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x06, 0x00},   // U+003B (;)
-    { 0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00},   // U+003C (<)
-    { 0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00},   // U+003D (=)
-    { 0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00},   // U+003E (>)
-    { 0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00},   // U+003F (?)
-    { 0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00},   // U+0040 (@)
-    { 0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00},   // U+0041 (A)
-    { 0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00},   // U+0042 (B)
-    { 0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00},   // U+0043 (C)
-    { 0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00},   // U+0044 (D)
-    { 0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00},   // U+0045 (E)
-    { 0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00},   // U+0046 (F)
-    { 0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00},   // U+0047 (G)
-    { 0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00},   // U+0048 (H)
-    { 0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},   // U+0049 (I)
-    { 0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00},   // U+004A (J)
-    { 0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00},   // U+004B (K)
-    { 0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00},   // U+004C (L)
-    { 0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00},   // U+004D (M)
-    { 0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00},   // U+004E (N)
-    { 0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00},   // U+004F (O)
-    { 0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00},   // U+0050 (P)
-    { 0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00},   // U+0051 (Q)
-    { 0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00},   // U+0052 (R)
-    { 0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00},   // U+0053 (S)
-    { 0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},   // U+0054 (T)
-    { 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00},   // U+0055 (U)
-    { 0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00},   // U+0056 (V)
-    { 0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00},   // U+0057 (W)
-    { 0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00},   // U+0058 (X)
-    { 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00},   // U+0059 (Y)
-    { 0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00},   // U+005A (Z)
-    { 0x1E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1E, 0x00},   // U+005B ([)
-    { 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00},   // U+005C (\)
-    { 0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x00},   // U+005D (])
-    { 0x08, 0x1C, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00},   // U+005E (^)
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF},   // U+005F (_)
-    { 0x0C, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+0060 (`)
-    { 0x00, 0x00, 0x1E, 0x30, 0x3E, 0x33, 0x6E, 0x00},   // U+0061 (a)
-    { 0x07, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x3B, 0x00},   // U+0062 (b)
-    { 0x00, 0x00, 0x1E, 0x33, 0x03, 0x33, 0x1E, 0x00},   // U+0063 (c)
-    { 0x38, 0x30, 0x30, 0x3e, 0x33, 0x33, 0x6E, 0x00},   // U+0064 (d)
-    { 0x00, 0x00, 0x1E, 0x33, 0x3f, 0x03, 0x1E, 0x00},   // U+0065 (e)
-    { 0x1C, 0x36, 0x06, 0x0f, 0x06, 0x06, 0x0F, 0x00},   // U+0066 (f)
-    { 0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x1F},   // U+0067 (g)
-    { 0x07, 0x06, 0x36, 0x6E, 0x66, 0x66, 0x67, 0x00},   // U+0068 (h)
-    { 0x0C, 0x00, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},   // U+0069 (i)
-    { 0x30, 0x00, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E},   // U+006A (j)
-    { 0x07, 0x06, 0x66, 0x36, 0x1E, 0x36, 0x67, 0x00},   // U+006B (k)
-    { 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},   // U+006C (l)
-    { 0x00, 0x00, 0x33, 0x7F, 0x7F, 0x6B, 0x63, 0x00},   // U+006D (m)
-    { 0x00, 0x00, 0x1F, 0x33, 0x33, 0x33, 0x33, 0x00},   // U+006E (n)
-    { 0x00, 0x00, 0x1E, 0x33, 0x33, 0x33, 0x1E, 0x00},   // U+006F (o)
-    { 0x00, 0x00, 0x3B, 0x66, 0x66, 0x3E, 0x06, 0x0F},   // U+0070 (p)
-    { 0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x78},   // U+0071 (q)
-    { 0x00, 0x00, 0x3B, 0x6E, 0x66, 0x06, 0x0F, 0x00},   // U+0072 (r)
-    { 0x00, 0x00, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x00},   // U+0073 (s)
-    { 0x08, 0x0C, 0x3E, 0x0C, 0x0C, 0x2C, 0x18, 0x00},   // U+0074 (t)
-    { 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x6E, 0x00},   // U+0075 (u)
-    { 0x00, 0x00, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00},   // U+0076 (v)
-    { 0x00, 0x00, 0x63, 0x6B, 0x7F, 0x7F, 0x36, 0x00},   // U+0077 (w)
-    { 0x00, 0x00, 0x63, 0x36, 0x1C, 0x36, 0x63, 0x00},   // U+0078 (x)
-    { 0x00, 0x00, 0x33, 0x33, 0x33, 0x3E, 0x30, 0x1F},   // U+0079 (y)
-    { 0x00, 0x00, 0x3F, 0x19, 0x0C, 0x26, 0x3F, 0x00},   // U+007A (z)
-    { 0x38, 0x0C, 0x0C, 0x07, 0x0C, 0x0C, 0x38, 0x00},   // U+007B ({)
-    { 0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00},   // U+007C (|)
-    { 0x07, 0x0C, 0x0C, 0x38, 0x0C, 0x0C, 0x07, 0x00},   // U+007D (})
-    { 0x6E, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // U+007E (~)
-    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}    // U+007F
+ * @brief RGB panel VSYNC callback (ISR context)
+ * @implementation Counts the frame, then wakes present(), which compares counts so
+ *                 a stale give can never stand in for the VSYNC it waits for.
+ */
+static bool IRAM_ATTR onPanelVsync(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_data_t* edata, void* user_ctx) {
+    BaseType_t high_task_woken = pdFALSE;
+    vsync_count = vsync_count + 1;
+    xSemaphoreGiveFromISR(vsync_semaphore, &high_task_woken);
+    return high_task_woken == pdTRUE;
+}
+
+// =============================================================================
+// PROFILING
+// =============================================================================
+
+static FrameStats profile_last = {};    // Published by the last flush()/present()
+
+#if FG_PROFILE
+
+static FrameStats profile_frame = {};   // Frame being collected
+static int64_t profile_frame_start = 0; // esp_timer time the current frame began
+
+/**
+ * @class ProfileScope
+ * @brief Adds the cycles and pixels of one primitive call to the current frame
+ * @implementation Constructed at the top of the call, accounted in the destructor so
+ *                 early returns are covered. Pixel counts are taken as the delta of
+ *                 FastCanvas::pixels_written, which the canvas write paths advance.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfilePrimitive id)
+        : id(id), start_cycles(esp_cpu_get_cycle_count()), start_pixels(FastCanvas::pixels_written) {}
+    ~ProfileScope() {
+        uint32_t cycles = esp_cpu_get_cycle_count() - start_cycles;
+        PrimitiveStats& stats = profile_frame.primitives[id];
+        stats.calls++;
+        stats.pixels += FastCanvas::pixels_written - start_pixels;
+        stats.cycles += cycles;
+        profile_frame.draw_cycles += cycles;
+    }
+private:
+    ProfilePrimitive id;
+    uint32_t start_cycles;
+    uint32_t start_pixels;
+};
+
+/**
+ * @class FlushScope
+ * @brief Times one flush()/present() and closes the frame
+ */
+class FlushScope {
+public:
+    FlushScope() : start_cycles(esp_cpu_get_cycle_count()) {}
+    ~FlushScope() {
+        profile_frame.flush_cycles += esp_cpu_get_cycle_count() - start_cycles;
+        
+        int64_t now = esp_timer_get_time();
+        if (profile_frame_start != 0) {
+            profile_frame.frame_us = (uint32_t)(now - profile_frame_start);
+            profile_frame.fps = profile_frame.frame_us ? 1000000.0f / profile_frame.frame_us : 0.0f;
+        }
+        profile_frame_start = now;
+        profile_last = profile_frame;
+        profile_frame = {};
+    }
+private:
+    uint32_t start_cycles;
 };
 
+#define FG_PROFILE_SCOPE(id)        ProfileScope profile_scope(id)
+#define FG_PROFILE_FLUSH()          FlushScope flush_scope
+#define FG_PROFILE_BITMAP(n)        (profile_frame.flush_calls++, profile_frame.flush_pixels += (n))
+
+#else
+
+#define FG_PROFILE_SCOPE(id)        ((void)0)
+#define FG_PROFILE_FLUSH()          ((void)0)
+#define FG_PROFILE_BITMAP(n)        ((void)0)
+
+#endif // FG_PROFILE
+
 // =============================================================================
 // LIBRARY INITIALIZATION
 // =============================================================================
@@ -171,11 +192,26 @@ const uint8_t font8x8_basic[128][8] = {
  * @implementation Sets up all static variables and prepares the library for use.
  *                 Must be called before any drawing operations.
  */
-void FastGraphics::begin(uint16_t* framebuffer) {
+void FastGraphics::begin(uint16_t* framebuffer, esp_lcd_panel_handle_t panel_handle) {
+    stopRenderTask();
+    FastDMA::waitIdle();  // Nothing may still be writing into the old buffer
     frame_buffer = framebuffer;
-    current_rotation = ROTATION_0;
-    display_width = LCD_H_RES;
-    display_height = LCD_V_RES;
+    panel = panel_handle;
+    front_buffer = nullptr;
+    double_buffered = false;
+    deferred = false;
+    indexed_buffer = nullptr;
+    pixel_format = PIXEL_RGB565;
+    recording = false;
+    rotate_on_flush = false;
+    shadow_rotation = ROTATION_0;
+    viewport_rows = 0;
+    viewport_offset = 0;
+    screen.setBuffer(framebuffer, LCD_H_RES, LCD_V_RES);
+    screen.setRotation(ROTATION_0);
+    screen.resetClip();
+    screen.setAsync(async_mode);
+    clip_depth = 0;
     
     // Initialize text settings to defaults
     cursor_x = 0;
@@ -186,9 +222,45 @@ void FastGraphics::begin(uint16_t* framebuffer) {
     text_wrap = true;
     text_area_x = 0;
     text_area_y = 0;
-    text_area_w = display_width;
-    text_area_h = display_height;
+    text_area_w = screen.getWidth();
+    text_area_h = screen.getHeight();
     line_spacing = 2;  // Default line spacing
+    text_scroll = false;
+    
+    // Framebuffer content is unknown to the panel until the first full flush
+    markAllDirty();
+}
+
+/**
+ * @brief Initialize the library in tear-free double-buffer mode
+ * @implementation Fetches both driver framebuffers, draws into the second one while
+ *                 the first is scanned out, and registers the VSYNC callback used
+ *                 by present() to wait for the swap.
+ */
+bool FastGraphics::beginDoubleBuffered(esp_lcd_panel_handle_t panel_handle) {
+    void* fb0 = nullptr;
+    void* fb1 = nullptr;
+    if (!panel_handle ||
+        esp_lcd_rgb_panel_get_frame_buffer(panel_handle, 2, &fb0, &fb1) != ESP_OK ||
+        !fb0 || !fb1) {
+        return false;
+    }
+    
+    if (!vsync_semaphore) {
+        vsync_semaphore = xSemaphoreCreateBinary();
+        if (!vsync_semaphore) return false;
+    }
+    
+    esp_lcd_rgb_panel_event_callbacks_t callbacks = {};
+    callbacks.on_vsync = onPanelVsync;
+    if (esp_lcd_rgb_panel_register_event_callbacks(panel_handle, &callbacks, nullptr) != ESP_OK) {
+        return false;
+    }
+    
+    begin((uint16_t*)fb1, panel_handle);
+    front_buffer = (uint16_t*)fb0;
+    double_buffered = true;
+    return true;
 }
 
 // =============================================================================
@@ -197,117 +269,210 @@ void FastGraphics::begin(uint16_t* framebuffer) {
 
 /**
  * @brief Set the screen rotation
- * @implementation Updates rotation state and recalculates logical display dimensions.
- *                 Portrait rotations swap width and height values.
+ * @implementation The screen canvas holds the rotation and the logical dimensions.
  */
 void FastGraphics::setRotation(ScreenRotation rotation) {
-    current_rotation = rotation;
-    
-    // Update logical display dimensions based on rotation
-    switch (rotation) {
-        case ROTATION_0:   // Landscape
-        case ROTATION_180: // Landscape flipped
-            display_width = LCD_H_RES;
-            display_height = LCD_V_RES;
-            break;
-            
-        case ROTATION_90:  // Portrait
-        case ROTATION_270: // Portrait flipped
-            display_width = LCD_V_RES;  // Swapped
-            display_height = LCD_H_RES; // Swapped
-            break;
-    }
+    // Recorded and queued commands are in the old orientation's coordinates
+    waitRenderIdle();
+    if (deferred && (frame_buffer || indexed_buffer)) renderCommands();
+    setScrollViewport(0, 0);  // Its rows are full-width in one orientation only
+    attachScreen(rotation);
+    
+    // Clips are logical rectangles of the old orientation
+    clip_depth = 0;
+    applyClip();
     
     // Update text area to match new screen dimensions
-    text_area_w = display_width;
-    text_area_h = display_height;
+    text_area_w = screen.getWidth();
+    text_area_h = screen.getHeight();
 }
 
 ScreenRotation FastGraphics::getRotation() {
-    return current_rotation;
+    return shadow_rotation != ROTATION_0 ? shadow_rotation : screen.getRotation();
 }
 
 int16_t FastGraphics::getWidth() {
-    return display_width;
+    return screen.getWidth();
 }
 
 int16_t FastGraphics::getHeight() {
-    return display_height;
+    return screen.getHeight();
 }
 
-// =============================================================================
-// COORDINATE TRANSFORMATION
-// =============================================================================
+/**
+ * @brief Draw rotated screens unrotated and rotate them on flush
+ * @implementation The shadow buffer holds a full screen in PSRAM, like the
+ *                 framebuffer itself. Switching re-attaches the screen canvas, which
+ *                 converts the current content in whichever direction is needed.
+ */
+bool FastGraphics::setRotateOnFlush(bool enable) {
+    waitRenderIdle();
+    if (enable) {
+        if (deferred || !frame_buffer || viewport_rows) return false;
+        if (!shadow_buffer) {
+            shadow_buffer = (uint16_t*)heap_caps_malloc((size_t)LCD_H_RES * LCD_V_RES * sizeof(uint16_t),
+                                                        MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            if (!shadow_buffer) return false;
+        }
+    }
+    ScreenRotation rotation = getRotation();
+    rotate_on_flush = enable;
+    attachScreen(rotation);  // The canvas keeps its logical clip
+    return true;
+}
+
+bool FastGraphics::getRotateOnFlush() {
+    return rotate_on_flush;
+}
 
 /**
- * @brief Transform logical coordinates to physical framebuffer coordinates
- * @implementation Applies rotation matrix transformations to convert from logical
- *                 display coordinates to physical framebuffer coordinates.
- * @details For each rotation:
- *          - ROTATION_0: No transformation (x=x, y=y)  
- *          - ROTATION_90: x'=LCD_H_RES-1-y, y'=x
- *          - ROTATION_180: x'=LCD_H_RES-1-x, y'=LCD_V_RES-1-y
- *          - ROTATION_270: x'=y, y'=LCD_V_RES-1-x
+ * @brief Map a rectangle of a w x h area rotated clockwise by quarter turns
+ * @implementation Same mapping as FastKernels::rotate16(), applied to the two
+ *                 corners of an end-exclusive rectangle.
  */
-void FastGraphics::transformCoordinates(int16_t& x, int16_t& y) {
-    int16_t temp_x = x;
-    int16_t temp_y = y;
-    
-    switch (current_rotation) {
-        case ROTATION_0:   // No rotation
-            // x = x, y = y (no change)
-            break;
-            
-        case ROTATION_90:  // 90° clockwise (portrait)
-            x = LCD_H_RES - 1 - temp_y;
-            y = temp_x;
-            break;
-            
-        case ROTATION_180: // 180° (landscape flipped)
-            x = LCD_H_RES - 1 - temp_x;
-            y = LCD_V_RES - 1 - temp_y;
-            break;
-            
-        case ROTATION_270: // 270° clockwise (portrait flipped)
-            x = temp_y;
-            y = LCD_V_RES - 1 - temp_x;
-            break;
+FastGraphics::DirtyRect FastGraphics::rotatedRect(const DirtyRect& r, uint8_t turns, int16_t w, int16_t h) {
+    switch (turns & 3) {
+        case 1:  return { (int16_t)(h - r.y1), r.x0, (int16_t)(h - r.y0), r.x1 };
+        case 2:  return { (int16_t)(w - r.x1), (int16_t)(h - r.y1), (int16_t)(w - r.x0), (int16_t)(h - r.y0) };
+        case 3:  return { r.y0, (int16_t)(w - r.x1), r.y1, (int16_t)(w - r.x0) };
+        default: return r;
     }
 }
 
 /**
- * @brief Transform dimensions for rotated operations  
- * @implementation Currently handles dimension transformation on a per-function basis
- *                 for optimal performance. Most functions handle rotation internally.
+ * @brief Point the screen canvas at the framebuffer or the shadow buffer
+ * @implementation Leaving a shadow rotates its pending rectangles out first, which
+ *                 leaves the framebuffer complete. Entering one copies the whole
+ *                 framebuffer in, rotated back, and maps the pending dirty list
+ *                 the same way so nothing unflushed is lost.
+ * @performance One full screen rotation per switch, none per frame
  */
-void FastGraphics::transformDimensions(int16_t& w, int16_t& h, int16_t x, int16_t y) {
-    // For 90° and 270° rotations, we need to swap width and height for certain operations
-    if (current_rotation == ROTATION_90 || current_rotation == ROTATION_270) {
-        // Note: This is handled per-function basis for optimal performance
-        // Most functions will handle this internally
+void FastGraphics::attachScreen(ScreenRotation rotation) {
+    if (async_mode) FastDMA::waitIdle();  // Both buffers must hold finished pixels
+    rotateDirtyRects();
+    
+    if (!rotate_on_flush || rotation == ROTATION_0 || !shadow_buffer) {
+        shadow_rotation = ROTATION_0;
+        screen.setBuffer(frame_buffer, LCD_H_RES, LCD_V_RES);
+        screen.setRotation(rotation);
+        return;
+    }
+    
+    uint8_t back = (4 - rotation) & 3;
+    bool portrait = rotation == ROTATION_90 || rotation == ROTATION_270;
+    int16_t w = portrait ? LCD_V_RES : LCD_H_RES;
+    FastKernels::rotate16(shadow_buffer, w, frame_buffer, LCD_H_RES, LCD_H_RES, LCD_V_RES, back);
+    for (uint8_t i = 0; i < dirty_count; i++) {
+        dirty_rects[i] = rotatedRect(dirty_rects[i], back, LCD_H_RES, LCD_V_RES);
     }
+    
+    shadow_rotation = rotation;
+    screen.setBuffer(shadow_buffer, w, portrait ? LCD_H_RES : LCD_V_RES);
+    screen.setRotation(ROTATION_0);
 }
 
 // =============================================================================
-// PRIVATE HELPER FUNCTIONS
+// CLIPPING
 // =============================================================================
 
 /**
- * @brief Draw a single pixel with bounds checking and rotation
- * @implementation Performs bounds checking against logical display size,
- *                 applies coordinate transformation, then draws to framebuffer.
- * @performance O(1) operation with minimal overhead for bounds checking
+ * @brief Push a clip rectangle
+ * @implementation The stack holds already intersected rectangles, so the top is the
+ *                 whole clip and popping needs no recomputation. Only the top is
+ *                 handed to the screen canvas and recorded.
  */
-inline void FastGraphics::pixel(int16_t x, int16_t y, uint16_t color) {
-    // Check bounds against logical display size
-    if (x >= 0 && x < display_width && y >= 0 && y < display_height) {
-        // Transform coordinates based on rotation
-        transformCoordinates(x, y);
-        
-        // Now check against physical display bounds and draw
-        if (x >= 0 && x < LCD_H_RES && y >= 0 && y < LCD_V_RES) {
-            frame_buffer[y * LCD_H_RES + x] = color;
-        }
+bool FastGraphics::pushClip(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (clip_depth == FG_CLIP_DEPTH) return false;
+    clipBox(x, y, w, h);
+    if (w < 0) w = 0;
+    if (h < 0) h = 0;
+    clip_stack[clip_depth++] = { x, y, w, h };
+    applyClip();
+    return true;
+}
+
+void FastGraphics::popClip() {
+    if (clip_depth == 0) return;
+    clip_depth--;
+    applyClip();
+}
+
+void FastGraphics::resetClip() {
+    if (clip_depth == 0) return;
+    clip_depth = 0;
+    applyClip();
+}
+
+void FastGraphics::getClip(int16_t& x, int16_t& y, int16_t& w, int16_t& h) {
+    if (clip_depth == 0) {
+        x = 0;
+        y = 0;
+        w = screen.getWidth();
+        h = screen.getHeight();
+        return;
+    }
+    const ClipRect& top = clip_stack[clip_depth - 1];
+    x = top.x;
+    y = top.y;
+    w = top.w;
+    h = top.h;
+}
+
+void FastGraphics::clipBox(int16_t& x, int16_t& y, int16_t& w, int16_t& h) {
+    if (clip_depth == 0) return;
+    const ClipRect& top = clip_stack[clip_depth - 1];
+    int16_t x1 = x + w, y1 = y + h;
+    if (x < top.x) x = top.x;
+    if (y < top.y) y = top.y;
+    if (x1 > top.x + top.w) x1 = top.x + top.w;
+    if (y1 > top.y + top.h) y1 = top.y + top.h;
+    w = x1 - x;
+    h = y1 - y;
+}
+
+void FastGraphics::markDrawn(int16_t x, int16_t y, int16_t w, int16_t h) {
+    clipBox(x, y, w, h);
+    DirtyRect r;
+    if (physicalBounds(x, y, w, h, r)) {
+        addDirtyRect(r.x0, r.y0, r.x1, r.y1);
+    }
+}
+
+DrawCommand FastGraphics::clipCommand() {
+    DrawCommand cmd = { CMD_CLIP };
+    if (clip_depth) {
+        const ClipRect& top = clip_stack[clip_depth - 1];
+        cmd = { CMD_CLIP, 1, 0, 0, top.x, top.y, top.w, top.h };
+    }
+    cmd.row0 = 0;
+    cmd.row1 = LCD_V_RES;  // Replayed in every band
+    return cmd;
+}
+
+/**
+ * @brief Hand the current clip to whoever draws
+ * @implementation A recorded list replays from an unclipped canvas, so a clip only
+ *                 needs recording once something follows it: an empty list gets the
+ *                 clip from record() with its first command, and a clip directly
+ *                 after another one replaces it.
+ */
+void FastGraphics::applyClip() {
+    DrawCommand cmd = clipCommand();
+    if (render_task) {
+        enqueue(cmd, DirtyRect{ 0, 0, 0, 0 });
+        return;
+    }
+    execute(screen, cmd);
+    if (!deferred || command_count == 0) return;
+    
+    if (commands[command_count - 1].type == CMD_CLIP) {
+        commands[command_count - 1] = cmd;
+    } else if (command_count < FG_MAX_COMMANDS) {
+        commands[command_count++] = cmd;
+    } else if (frame_buffer || indexed_buffer) {
+        renderCommands();  // Empty list again, the clip follows with the next command
+    } else {
+        dropped_commands++;
     }
 }
 
@@ -315,58 +480,39 @@ inline void FastGraphics::pixel(int16_t x, int16_t y, uint16_t color) {
 // CORE DRAWING FUNCTIONS
 // =============================================================================
 
+/**
+ * @brief Draw a single pixel
+ * @implementation The screen canvas draws, FastGraphics records or marks dirty.
+ *                 Every primitive below follows the same pattern; primitives built
+ *                 from many pixels mark their bounding box once.
+ */
+void FastGraphics::pixel(int16_t x, int16_t y, uint16_t color) {
+    FG_PROFILE_SCOPE(PROFILE_PIXEL);
+    if (recording) { record({ CMD_PIXEL, 0, color, 0, x, y, 0, 0 }, x, y, 1, 1); return; }
+    screen.pixel(x, y, color);
+    markDrawn(x, y, 1, 1);
+}
+
 /**
  * @brief Clear the entire screen with a solid color
- * @implementation Uses fillRect for the entire display area, which provides
- *                 optimal performance through vectorized clearing operations.
+ * @implementation Uses fillRect for the entire display area, which is contiguous
+ *                 and goes to FastKernels::fill16() as a single run.
  */
 void FastGraphics::clear(uint16_t color) {
-    fillRect(0, 0, display_width, display_height, color);
+    fillRect(0, 0, screen.getWidth(), screen.getHeight(), color);
 }
 
 /**
  * @brief Draw a filled rectangle
- * @implementation Optimized for performance with different paths for rotated vs non-rotated.
- *                 Non-rotated uses fast memory operations, rotated uses pixel-by-pixel.
- * @performance Non-rotated: ~O(w*h/4) due to 4-pixel unrolled loop
- *              Rotated: O(w*h) due to coordinate transformation per pixel
+ * @implementation FastCanvas::fillRect() fills whole physical rows in every
+ *                 rotation, then the rectangle is marked dirty.
+ * @performance ~O(w*h/8) with 128-bit stores on ESP32-S3, independent of rotation
  */
 void FastGraphics::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-    // Input validation using logical display dimensions
-    if (x >= display_width || y >= display_height || w <= 0 || h <= 0) return;
-    
-    // Clip to logical screen boundaries
-    if (x < 0) { w += x; x = 0; }
-    if (y < 0) { h += y; y = 0; }  
-    if (x + w > display_width) w = display_width - x;
-    if (y + h > display_height) h = display_height - y;
-    
-    // For rotations, we need to draw pixel by pixel to handle coordinate transformation
-    // This is less optimal but ensures correctness for all rotations
-    if (current_rotation != ROTATION_0) {
-        for (int16_t row = 0; row < h; row++) {
-            for (int16_t col = 0; col < w; col++) {
-                pixel(x + col, y + row, color);
-            }
-        }
-    } else {
-        // Optimized path for no rotation - direct framebuffer access
-        for (int16_t row = 0; row < h; row++) {
-            uint16_t* ptr = &frame_buffer[(y + row) * LCD_H_RES + x];
-            int16_t pixels = w;
-            
-            // Unrolled loop for maximum performance - 4 pixels at a time
-            while (pixels >= 4) {
-                *ptr++ = color; *ptr++ = color; *ptr++ = color; *ptr++ = color;
-                pixels -= 4;
-            }
-            // Handle remaining pixels
-            while (pixels > 0) {
-                *ptr++ = color;
-                pixels--;
-            }
-        }
-    }
+    FG_PROFILE_SCOPE(PROFILE_FILL_RECT);
+    if (recording) { record({ CMD_FILL_RECT, 0, color, 0, x, y, w, h }, x, y, w, h); return; }
+    screen.fillRect(x, y, w, h, color);
+    markDrawn(x, y, w, h);
 }
 
 /**
@@ -377,31 +523,12 @@ void FastGraphics::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t
  * @algorithm Modified Bresenham circle algorithm optimized for filled circles
  */
 void FastGraphics::fillCircle(int16_t x0, int16_t y0, int16_t radius, uint16_t color) {
+    FG_PROFILE_SCOPE(PROFILE_FILL_CIRCLE);
     if (radius <= 0) return;
-    
-    int16_t x = 0;
-    int16_t y = radius;
-    int16_t decision = 1 - radius;
-    
-    // Draw center line
-    fillRect(x0 - radius, y0, 2 * radius + 1, 1, color);
-    
-    while (x < y) {
-        if (decision < 0) {
-            decision += 2 * x + 3;
-        } else {
-            decision += 2 * (x - y) + 5;
-            // Draw horizontal lines for filled circle
-            fillRect(x0 - x, y0 + y, 2 * x + 1, 1, color);
-            fillRect(x0 - x, y0 - y, 2 * x + 1, 1, color);
-            y--;
-        }
-        x++;
-        if (x <= y) {
-            fillRect(x0 - y, y0 + x, 2 * y + 1, 1, color);
-            fillRect(x0 - y, y0 - x, 2 * y + 1, 1, color);
-        }
-    }
+    int16_t box_x = x0 - radius, box_y = y0 - radius, box_size = 2 * radius + 1;
+    if (recording) { record({ CMD_FILL_CIRCLE, 0, color, 0, x0, y0, radius, 0 }, box_x, box_y, box_size, box_size); return; }
+    screen.fillCircle(x0, y0, radius, color);
+    markDrawn(box_x, box_y, box_size, box_size);
 }
 
 /**
@@ -426,22 +553,13 @@ void FastGraphics::line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t
         return;
     }
     
-    // Bresenham line algorithm for diagonal lines
-    int16_t dx = abs(x1 - x0);
-    int16_t dy = abs(y1 - y0);
-    int16_t sx = (x0 < x1) ? 1 : -1;
-    int16_t sy = (y0 < y1) ? 1 : -1;
-    int16_t err = dx - dy;
-    
-    int16_t x = x0, y = y0;
-    while (true) {
-        pixel(x, y, color);
-        if (x == x1 && y == y1) break;
-        
-        int16_t e2 = 2 * err;
-        if (e2 > -dy) { err -= dy; x += sx; }
-        if (e2 < dx) { err += dx; y += sy; }
-    }
+    // Diagonal line: mark the bounding box once instead of every pixel
+    FG_PROFILE_SCOPE(PROFILE_LINE);
+    int16_t box_x = min(x0, x1), box_y = min(y0, y1);
+    int16_t box_w = abs(x1 - x0) + 1, box_h = abs(y1 - y0) + 1;
+    if (recording) { record({ CMD_LINE, 0, color, 0, x0, y0, x1, y1 }, box_x, box_y, box_w, box_h); return; }
+    screen.line(x0, y0, x1, y1, color);
+    markDrawn(box_x, box_y, box_w, box_h);
 }
 
 // =============================================================================
@@ -468,444 +586,2083 @@ void FastGraphics::rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t col
  */
 void FastGraphics::circle(int16_t x0, int16_t y0, int16_t radius, uint16_t color) {
     if (radius <= 0) return;
-    
-    int16_t x = 0, y = radius;
-    int16_t decision = 1 - radius;
-    
-    while (x <= y) {
-        // Draw all 8 octants using symmetry
-        pixel(x0 + x, y0 + y, color); pixel(x0 - x, y0 + y, color);
-        pixel(x0 + x, y0 - y, color); pixel(x0 - x, y0 - y, color);
-        pixel(x0 + y, y0 + x, color); pixel(x0 - y, y0 + x, color);
-        pixel(x0 + y, y0 - x, color); pixel(x0 - y, y0 - x, color);
-        
-        if (decision < 0) {
-            decision += 2 * x + 3;
-        } else {
-            decision += 2 * (x - y) + 5;
-            y--;
-        }
-        x++;
-    }
+    int16_t box_x = x0 - radius, box_y = y0 - radius, box_size = 2 * radius + 1;
+    if (recording) { record({ CMD_CIRCLE, 0, color, 0, x0, y0, radius, 0 }, box_x, box_y, box_size, box_size); return; }
+    screen.circle(x0, y0, radius, color);
+    markDrawn(box_x, box_y, box_size, box_size);
 }
 
 // =============================================================================
-// TEXT FUNCTIONS
+// ANTI-ALIASED DRAWING
 // =============================================================================
 
 /**
- * @brief Draw a single character at specified position
- * @implementation Renders character from 8x8 font bitmap data with optional scaling.
- *                 Optimized paths for size=1 vs larger sizes.
- * @performance Size 1: O(64) - direct pixel operations
- *              Size >1: O(64 * size²) - uses fillRect for scaled pixels
+ * @brief Draw an anti-aliased line
+ * @implementation FastCanvas::lineAA() draws, the bounding box is marked once.
  */
-void FastGraphics::drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
-    if (c < 0 || c > 127) return;
-    
-    const uint8_t* char_data = font8x8_basic[c];
-    
-    if (size == 1) {
-        // Optimized path for normal size characters
-        for (int8_t row = 0; row < 8; row++) {
-            uint8_t line = char_data[row];
-            for (int8_t col = 0; col < 8; col++) {
-                if (line & (1 << col)) {
-                    pixel(x + col, y + row, color);
-                } else if (bg != color) {
-                    pixel(x + col, y + row, bg);
-                }
-            }
-        }
-    } else {
-        // Scaled character rendering using fillRect for efficiency
-        for (int8_t row = 0; row < 8; row++) {
-            uint8_t line = char_data[row];
-            for (int8_t col = 0; col < 8; col++) {
-                if (line & (1 << col)) {
-                    fillRect(x + col * size, y + row * size, size, size, color);
-                } else if (bg != color) {
-                    fillRect(x + col * size, y + row * size, size, size, bg);
-                }
-            }
-        }
+void FastGraphics::lineAA(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    if (x0 == x1 || y0 == y1) {
+        line(x0, y0, x1, y1, color);
+        return;
     }
+    FG_PROFILE_SCOPE(PROFILE_ANTIALIAS);
+    int16_t box_x = min(x0, x1), box_y = min(y0, y1);
+    int16_t box_w = abs(x1 - x0) + 1, box_h = abs(y1 - y0) + 1;
+    if (recording) { record({ CMD_LINE_AA, 0, color, 0, x0, y0, x1, y1 }, box_x, box_y, box_w, box_h); return; }
+    screen.lineAA(x0, y0, x1, y1, color);
+    markDrawn(box_x, box_y, box_w, box_h);
 }
 
 /**
- * @brief Draw text at specified position
- * @implementation Renders string character by character, handling newlines and
- *                 carriage returns. Cursor advances automatically.
+ * @brief Draw an anti-aliased thick line
+ * @implementation The bounding box grows by half the thickness plus the blended
+ *                 edge pixel on every side.
  */
-void FastGraphics::text(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
-    int16_t cursor_x = x, cursor_y = y;
-    
-    while (*str) {
-        if (*str == '\n') {
-            cursor_y += size * 8;
-            cursor_x = x;
-        } else if (*str != '\r') {
-            drawChar(cursor_x, cursor_y, *str, color, bg, size);
-            cursor_x += size * 8;
-        }
-        str++;
+void FastGraphics::thickLineAA(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t thickness, uint16_t color) {
+    if (thickness <= 1) {
+        lineAA(x0, y0, x1, y1, color);
+        return;
     }
+    FG_PROFILE_SCOPE(PROFILE_ANTIALIAS);
+    int16_t reach = thickness / 2 + 1;
+    int16_t box_x = min(x0, x1) - reach, box_y = min(y0, y1) - reach;
+    int16_t box_w = abs(x1 - x0) + 2 * reach + 1, box_h = abs(y1 - y0) + 2 * reach + 1;
+    if (recording) { record({ CMD_THICK_LINE_AA, thickness, color, 0, x0, y0, x1, y1 }, box_x, box_y, box_w, box_h); return; }
+    screen.thickLineAA(x0, y0, x1, y1, thickness, color);
+    markDrawn(box_x, box_y, box_w, box_h);
 }
 
-// =============================================================================
-// ADVANCED TEXT FUNCTIONS
-// =============================================================================
-
-void FastGraphics::setCursor(int16_t x, int16_t y) {
-    cursor_x = x;
-    cursor_y = y;
+void FastGraphics::circleAA(int16_t x0, int16_t y0, int16_t radius, uint16_t color) {
+    FG_PROFILE_SCOPE(PROFILE_ANTIALIAS);
+    if (radius <= 0) return;
+    int16_t box_x = x0 - radius - 1, box_y = y0 - radius - 1, box_size = 2 * radius + 3;
+    if (recording) { record({ CMD_CIRCLE_AA, 0, color, 0, x0, y0, radius, 0 }, box_x, box_y, box_size, box_size); return; }
+    screen.circleAA(x0, y0, radius, color);
+    markDrawn(box_x, box_y, box_size, box_size);
 }
 
-void FastGraphics::setTextColor(uint16_t color, uint16_t bg) {
-    text_color = color;
-    text_bg_color = bg;
+void FastGraphics::fillCircleAA(int16_t x0, int16_t y0, int16_t radius, uint16_t color) {
+    FG_PROFILE_SCOPE(PROFILE_ANTIALIAS);
+    if (radius <= 0) return;
+    int16_t box_x = x0 - radius - 1, box_y = y0 - radius - 1, box_size = 2 * radius + 3;
+    if (recording) { record({ CMD_FILL_CIRCLE_AA, 0, color, 0, x0, y0, radius, 0 }, box_x, box_y, box_size, box_size); return; }
+    screen.fillCircleAA(x0, y0, radius, color);
+    markDrawn(box_x, box_y, box_size, box_size);
 }
 
-void FastGraphics::setTextSize(uint8_t size) {
-    if (size >= 1 && size <= 10) {  // Reasonable size limits
-        text_size = size;
+/**
+ * @brief Draw an anti-aliased arc
+ * @implementation Marks the box of the whole ring; the angles only narrow what
+ *                 gets drawn, not the dirty area.
+ */
+void FastGraphics::arcAA(int16_t x0, int16_t y0, int16_t radius, int16_t start_angle, int16_t end_angle,
+                         uint8_t thickness, uint16_t color) {
+    FG_PROFILE_SCOPE(PROFILE_ANTIALIAS);
+    if (radius <= 0 || thickness == 0) return;
+    int16_t reach = radius + thickness / 2 + 1;
+    int16_t box_x = x0 - reach, box_y = y0 - reach, box_size = 2 * reach + 1;
+    if (recording) {
+        record({ CMD_ARC_AA, thickness, color, (uint16_t)end_angle, x0, y0, radius, start_angle },
+               box_x, box_y, box_size, box_size);
+        return;
     }
+    screen.arcAA(x0, y0, radius, start_angle, end_angle, thickness, color);
+    markDrawn(box_x, box_y, box_size, box_size);
 }
 
-void FastGraphics::setTextWrap(bool wrap) {
-    text_wrap = wrap;
+// =============================================================================
+// IMAGE FUNCTIONS
+// =============================================================================
+
+void FastGraphics::drawImage(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h) {
+    blitImage(x, y, image, w, h, 0, 0, w, h, false, 0);
 }
 
-void FastGraphics::setLineSpacing(int16_t spacing) {
-    if (spacing >= 0 && spacing <= 20) {  // Reasonable limits
-        line_spacing = spacing;
-    }
+void FastGraphics::drawImage(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h, uint16_t transparent) {
+    blitImage(x, y, image, w, h, 0, 0, w, h, true, transparent);
 }
 
-int16_t FastGraphics::getLineSpacing() {
-    return line_spacing;
+void FastGraphics::blit(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                        int16_t sx, int16_t sy, int16_t sw, int16_t sh) {
+    blitImage(x, y, image, image_w, image_h, sx, sy, sw, sh, false, 0);
 }
 
-void FastGraphics::getCursor(int16_t& x, int16_t& y) {
-    x = cursor_x;
-    y = cursor_y;
+void FastGraphics::blit(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                        int16_t sx, int16_t sy, int16_t sw, int16_t sh, uint16_t transparent) {
+    blitImage(x, y, image, image_w, image_h, sx, sy, sw, sh, true, transparent);
 }
 
-int16_t FastGraphics::getCursorX() {
-    return cursor_x;
+void FastGraphics::drawCanvas(int16_t x, int16_t y, const FastCanvas& canvas) {
+    blitImage(x, y, canvas.getBuffer(), canvas.getStride(), canvas.getBufferHeight(),
+              0, 0, canvas.getBufferWidth(), canvas.getBufferHeight(), false, 0);
 }
 
-int16_t FastGraphics::getCursorY() {
-    return cursor_y;
+void FastGraphics::drawCanvas(int16_t x, int16_t y, const FastCanvas& canvas, uint16_t transparent) {
+    blitImage(x, y, canvas.getBuffer(), canvas.getStride(), canvas.getBufferHeight(),
+              0, 0, canvas.getBufferWidth(), canvas.getBufferHeight(), true, transparent);
 }
 
-void FastGraphics::setTextArea(int16_t x, int16_t y, int16_t w, int16_t h) {
-    text_area_x = x;
-    text_area_y = y;
-    text_area_w = w;
-    text_area_h = h;
+/**
+ * @brief Clip the source rectangle, then record or draw it
+ * @implementation Parts of the source rectangle outside the image move the
+ *                 destination along, so the visible pixels stay where they would be.
+ */
+void FastGraphics::blitImage(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                             int16_t sx, int16_t sy, int16_t sw, int16_t sh, bool keyed, uint16_t key,
+                             uint8_t alpha) {
+    if (!image) return;
+    FG_PROFILE_SCOPE(alpha == 255 ? PROFILE_IMAGE : PROFILE_BLEND);
+    if (sx < 0) { x -= sx; sw += sx; sx = 0; }
+    if (sy < 0) { y -= sy; sh += sy; sy = 0; }
+    if (sx + sw > image_w) sw = image_w - sx;
+    if (sy + sh > image_h) sh = image_h - sy;
+    if (sw <= 0 || sh <= 0) return;
+    
+    const uint16_t* src = image + (int32_t)sy * image_w + sx;
+    if (recording) {
+        uint8_t type = alpha == 255 ? CMD_IMAGE : CMD_IMAGE_ALPHA;
+        record({ type, keyed, key, (uint16_t)image_w, x, y, sw, sh, 0, 0, alpha, src }, x, y, sw, sh);
+        return;
+    }
+    if (alpha != 255) {
+        if (keyed) {
+            screen.blitAlpha(x, y, image, image_w, image_h, sx, sy, sw, sh, alpha, key);
+        } else {
+            screen.blitAlpha(x, y, image, image_w, image_h, sx, sy, sw, sh, alpha);
+        }
+    } else if (keyed) {
+        screen.blit(x, y, image, image_w, image_h, sx, sy, sw, sh, key);
+    } else {
+        screen.blit(x, y, image, image_w, image_h, sx, sy, sw, sh);
+    }
+    markDrawn(x, y, sw, sh);
 }
 
-void FastGraphics::clearTextArea() {
-    fillRect(text_area_x, text_area_y, text_area_w, text_area_h, text_bg_color);
-    cursor_x = text_area_x;
-    cursor_y = text_area_y;
+/**
+ * @brief Draw a 1-bit bitmap
+ * @implementation Drawn by FastCanvas::drawBitmap(), recorded with both colors.
+ */
+void FastGraphics::drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                              uint16_t color, uint16_t bg) {
+    if (!bitmap || w <= 0 || h <= 0) return;
+    FG_PROFILE_SCOPE(PROFILE_IMAGE);
+    if (recording) { record({ CMD_BITMAP, 1, color, bg, x, y, w, h, 0, 0, 0, bitmap }, x, y, w, h); return; }
+    screen.drawBitmap(x, y, bitmap, w, h, color, bg);
+    markDrawn(x, y, w, h);
 }
 
 /**
- * @brief Internal helper to advance cursor position
- * @implementation Moves cursor and handles automatic line wrapping when enabled.
- *                 Checks text area boundaries for wrapping decisions.
+ * @brief Draw a 4-bit paletted bitmap
+ * @implementation A recorded command has no room for the palette pointer, so
+ *                 deferred mode brings the framebuffer up to date and draws directly,
+ *                 which keeps the drawing order. With a render task the caller waits
+ *                 for it to go idle and draws itself the same way. An index buffer
+ *                 is drawn band by band through the band buffer.
  */
-void FastGraphics::advanceCursor(uint8_t char_width, uint8_t char_height) {
-    cursor_x += char_width;
-    
-    // Check for line wrap
-    if (text_wrap && cursor_x + char_width > text_area_x + text_area_w) {
-        newLine();
+void FastGraphics::drawBitmap4(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                               const uint16_t* palette, int16_t transparent) {
+    if (!bitmap || !palette || w <= 0 || h <= 0) return;
+    FG_PROFILE_SCOPE(PROFILE_IMAGE);
+    waitRenderIdle();
+    if (deferred) {
+        if (!frame_buffer && !indexed_buffer) return;
+        renderCommands();
     }
+    if (indexed_buffer) {
+        int16_t cx, cy, cw, ch;
+        DirtyRect r;
+        if (!screen.getClip(cx, cy, cw, ch)) return;
+        int16_t bx = x, by = y, bw = w, bh = h;
+        clipBox(bx, by, bw, bh);
+        if (!physicalBounds(bx, by, bw, bh, r)) return;
+        for (int16_t lo = r.y0; lo < r.y1; lo += FG_BAND_LINES) {
+            int16_t hi = min((int16_t)(lo + FG_BAND_LINES), r.y1);
+            FastCanvas band;
+            loadBand(lo, hi);
+            bandCanvas(band, lo, hi);
+            band.setClip(cx, cy, cw, ch);
+            band.drawBitmap4(x, y, bitmap, w, h, palette, transparent);
+            storeBand(lo, hi);
+        }
+        addDirtyRect(r.x0, r.y0, r.x1, r.y1);
+        return;
+    }
+    if (viewport_rows) {
+        ViewportPart parts[4];
+        uint8_t count = viewportParts(0, LCD_V_RES, parts);
+        for (uint8_t i = 0; i < count; i++) {
+            screen.setRows(parts[i].rows, parts[i].row0, parts[i].row1);
+            screen.drawBitmap4(x, y, bitmap, w, h, palette, transparent);
+        }
+        screen.setRows(frame_buffer, 0, LCD_V_RES);
+    } else {
+        screen.drawBitmap4(x, y, bitmap, w, h, palette, transparent);
+    }
+    markDrawn(x, y, w, h);
+}
+
+void FastGraphics::drawCompressed(int16_t x, int16_t y, const uint8_t* image) {
+    if (!FastImage::valid(image)) return;
+    blitCompressed(x, y, image, 0, 0, FastImage::getWidth(image), FastImage::getHeight(image));
 }
 
 /**
- * @brief Move cursor to next line
- * @implementation Resets X to text area left edge, advances Y by character height
- *                 plus line spacing. Handles text area overflow by scrolling.
+ * @brief Draw part of a compressed image
+ * @implementation Source clipping as in blitImage(); the command keeps the image
+ *                 pointer and the source origin, so each band replay decodes only
+ *                 the rows inside the band.
  */
-void FastGraphics::newLine() {
-    cursor_x = text_area_x;
-    cursor_y += text_size * 8 + line_spacing;  // Character height + line spacing
+void FastGraphics::blitCompressed(int16_t x, int16_t y, const uint8_t* image,
+                                  int16_t sx, int16_t sy, int16_t sw, int16_t sh) {
+    if (!FastImage::valid(image)) return;
+    FG_PROFILE_SCOPE(PROFILE_IMAGE);
+    if (sx < 0) { x -= sx; sw += sx; sx = 0; }
+    if (sy < 0) { y -= sy; sh += sy; sy = 0; }
+    if (sx + sw > FastImage::getWidth(image)) sw = FastImage::getWidth(image) - sx;
+    if (sy + sh > FastImage::getHeight(image)) sh = FastImage::getHeight(image) - sy;
+    if (sw <= 0 || sh <= 0) return;
     
-    // Check if we've gone past the text area
-    if (cursor_y + text_size * 8 > text_area_y + text_area_h) {
-        // Scroll up by clearing and resetting to top
-        clearTextArea();
+    if (recording) {
+        record({ CMD_COMPRESSED, 0, (uint16_t)sx, (uint16_t)sy, x, y, sw, sh, 0, 0, 0, image }, x, y, sw, sh);
+        return;
     }
+    screen.blitCompressed(x, y, image, sx, sy, sw, sh);
+    markDrawn(x, y, sw, sh);
 }
 
 // =============================================================================
-// PRINT FUNCTIONS - Support all common data types
+// ALPHA BLENDING
 // =============================================================================
 
+void FastGraphics::blendPixel(int16_t x, int16_t y, uint16_t color, uint8_t alpha) {
+    FG_PROFILE_SCOPE(PROFILE_BLEND);
+    if (recording) { record({ CMD_PIXEL_ALPHA, 0, color, 0, x, y, 0, 0, 0, 0, alpha }, x, y, 1, 1); return; }
+    screen.blendPixel(x, y, color, alpha);
+    markDrawn(x, y, 1, 1);
+}
+
 /**
- * @brief Print a C-style string
- * @implementation Character-by-character rendering with special handling for
- *                 control characters like newline and carriage return.
+ * @brief Draw a translucent filled rectangle
+ * @implementation FastCanvas::fillRectAlpha() blends whole physical rows. Fully
+ *                 opaque fills go to fillRect(), so they keep its DMA path and
+ *                 the deferred-mode shortcuts for full-screen fills.
+ * @performance One multiply per pixel, two pixels per 32-bit PSRAM access
  */
-void FastGraphics::print(const char* str) {
-    while (*str) {
-        if (*str == '\n') {
-            newLine();
-        } else if (*str == '\r') {
-            cursor_x = text_area_x;  // Carriage return
-        } else if (*str >= 0 && *str <= 127) {
-            drawChar(cursor_x, cursor_y, *str, text_color, text_bg_color, text_size);
-            advanceCursor(text_size * 8, text_size * 8);
-        }
-        str++;
+void FastGraphics::fillRectAlpha(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, uint8_t alpha) {
+    if (alpha >= 252) {
+        fillRect(x, y, w, h, color);
+        return;
     }
+    if (alpha < 4) return;  // Below one blend level
+    FG_PROFILE_SCOPE(PROFILE_BLEND);
+    if (recording) { record({ CMD_FILL_RECT_ALPHA, 0, color, 0, x, y, w, h, 0, 0, alpha }, x, y, w, h); return; }
+    screen.fillRectAlpha(x, y, w, h, color, alpha);
+    markDrawn(x, y, w, h);
 }
 
-void FastGraphics::print(String str) {
-    print(str.c_str());
+/**
+ * @brief Darken a rectangle
+ * @implementation FastCanvas::dimRect() shifts whole physical rows with
+ *                 FastKernels::dim16().
+ * @performance One shift and mask per two pixels, no multiplies
+ */
+void FastGraphics::dimRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t level) {
+    if (level == 0) return;
+    FG_PROFILE_SCOPE(PROFILE_BLEND);
+    if (recording) { record({ CMD_DIM, level, 0, 0, x, y, w, h }, x, y, w, h); return; }
+    screen.dimRect(x, y, w, h, level);
+    markDrawn(x, y, w, h);
 }
 
-void FastGraphics::print(int number) {
-    char buffer[12];  // Enough for 32-bit int
-    sprintf(buffer, "%d", number);
-    print(buffer);
+void FastGraphics::drawImageAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h, uint8_t alpha) {
+    blitImage(x, y, image, w, h, 0, 0, w, h, false, 0, alpha);
 }
 
-void FastGraphics::print(unsigned int number) {
-    char buffer[12];
-    sprintf(buffer, "%u", number);
-    print(buffer);
+void FastGraphics::drawImageAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h, uint8_t alpha,
+                                  uint16_t transparent) {
+    blitImage(x, y, image, w, h, 0, 0, w, h, true, transparent, alpha);
 }
 
-void FastGraphics::print(long number) {
-    char buffer[20];  // Enough for 64-bit long
-    sprintf(buffer, "%ld", number);
-    print(buffer);
+void FastGraphics::blitAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                             int16_t sx, int16_t sy, int16_t sw, int16_t sh, uint8_t alpha) {
+    blitImage(x, y, image, image_w, image_h, sx, sy, sw, sh, false, 0, alpha);
 }
 
-void FastGraphics::print(unsigned long number) {
-    char buffer[20];
-    sprintf(buffer, "%lu", number);
-    print(buffer);
+void FastGraphics::blitAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                             int16_t sx, int16_t sy, int16_t sw, int16_t sh, uint8_t alpha, uint16_t transparent) {
+    blitImage(x, y, image, image_w, image_h, sx, sy, sw, sh, true, transparent, alpha);
 }
 
-void FastGraphics::print(float number, int decimals) {
-    char buffer[20];
-    char format[10];
-    sprintf(format, "%%.%df", decimals);
-    sprintf(buffer, format, number);
-    print(buffer);
+/**
+ * @brief Draw a color through an 8-bit coverage mask
+ * @implementation Drawn by FastCanvas::drawMask(), recorded with the mask pointer
+ *                 like a 1-bit bitmap.
+ */
+void FastGraphics::drawMask(int16_t x, int16_t y, const uint8_t* mask, int16_t w, int16_t h, uint16_t color) {
+    if (!mask || w <= 0 || h <= 0) return;
+    FG_PROFILE_SCOPE(PROFILE_BLEND);
+    if (recording) { record({ CMD_MASK, 0, color, 0, x, y, w, h, 0, 0, 0, mask }, x, y, w, h); return; }
+    screen.drawMask(x, y, mask, w, h, color);
+    markDrawn(x, y, w, h);
 }
 
-void FastGraphics::print(double number, int decimals) {
-    char buffer[25];
-    char format[10];
-    sprintf(format, "%%.%dlf", decimals);
-    sprintf(buffer, format, number);
-    print(buffer);
+// =============================================================================
+// TEXT FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Draw a single character at specified position
+ * @implementation Drawn by FastCanvas::drawChar(), the glyph box is marked dirty once.
+ */
+void FastGraphics::drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+    if (c < 0 || c > 127) return;
+    FG_PROFILE_SCOPE(PROFILE_CHAR);
+    int16_t glyph_size = size * 8;
+    if (recording) { record({ CMD_CHAR, size, color, bg, x, y, c, 0 }, x, y, glyph_size, glyph_size); return; }
+    screen.drawChar(x, y, c, color, bg, size);
+    markDrawn(x, y, glyph_size, glyph_size);
 }
 
-void FastGraphics::print(char character) {
-    if (character == '\n') {
-        newLine();
+/**
+ * @brief Draw one character of the current proportional font
+ * @implementation The optional background cell is a plain fillRect(); the glyph is
+ *                 drawn by FastCanvas::drawGlyph() and recorded as one CMD_GLYPH
+ *                 with its box, which is usually much smaller than the cell.
+ */
+int16_t FastGraphics::drawFontChar(int16_t x, int16_t y, uint16_t c, uint16_t color, uint16_t bg) {
+    if (c < font->first || c > font->last) return 0;
+    const GFXglyph& glyph = font->glyph[c - font->first];
+    if (bg != color) fillRect(x, y, glyph.xAdvance, font->yAdvance, bg);
+    if (glyph.width == 0 || glyph.height == 0) return glyph.xAdvance;  // Space
+    
+    FG_PROFILE_SCOPE(PROFILE_CHAR);
+    int16_t baseline = y + font_ascent;
+    int16_t gx = x + glyph.xOffset, gy = baseline + glyph.yOffset;
+    if (recording) {
+        record({ CMD_GLYPH, font_bpp, color, 0, x, baseline, (int16_t)c, 0, 0, 0, 0, font },
+               gx, gy, glyph.width, glyph.height);
+    } else {
+        screen.drawGlyph(x, baseline, font, font_bpp, c, color);
+        markDrawn(gx, gy, glyph.width, glyph.height);
+    }
+    return glyph.xAdvance;
+}
+
+/**
+ * @brief Draw text at specified position
+ * @implementation Renders string character by character, handling newlines and
+ *                 carriage returns. Cursor advances automatically. With a font set,
+ *                 characters advance by their xAdvance and lines by yAdvance.
+ */
+void FastGraphics::text(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
+    int16_t cursor_x = x, cursor_y = y;
+    
+    while (*str) {
+        if (*str == '\n') {
+            cursor_y += font ? font->yAdvance : size * 8;
+            cursor_x = x;
+        } else if (*str != '\r') {
+            if (font) {
+                cursor_x += drawFontChar(cursor_x, cursor_y, (uint8_t)*str, color, bg);
+            } else {
+                drawChar(cursor_x, cursor_y, *str, color, bg, size);
+                cursor_x += size * 8;
+            }
+        }
+        str++;
+    }
+}
+
+// =============================================================================
+// FONTS AND GLYPH CACHE
+// =============================================================================
+
+/**
+ * @brief Use a proportional font
+ * @implementation The ascent is the largest extent above the baseline of all glyphs,
+ *                 so text placed at y never reaches above y.
+ */
+void FastGraphics::setFont(const GFXfont* font, uint8_t bpp) {
+    if (bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8) return;
+    FastGraphics::font = font;
+    font_bpp = bpp;
+    font_ascent = 0;
+    if (!font) return;
+    for (uint16_t c = font->first; c <= font->last; c++) {
+        int16_t ascent = -font->glyph[c - font->first].yOffset;
+        if (ascent > font_ascent) font_ascent = ascent;
+    }
+}
+
+const GFXfont* FastGraphics::getFont() {
+    return font;
+}
+
+/**
+ * @brief Enable or disable the glyph cache
+ * @implementation The screen canvas draws through the cache; renderCommands() hands
+ *                 it to each band canvas. Waits for the render task first, which
+ *                 may be drawing from the cache.
+ */
+bool FastGraphics::setGlyphCache(bool enable, size_t bytes) {
+    waitRenderIdle();
+    screen.setGlyphCache(nullptr);
+    glyph_cache.end();
+    if (!enable) return true;
+    if (!glyph_cache.begin(bytes) && !glyph_cache.begin(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)) return false;
+    screen.setGlyphCache(&glyph_cache);
+    return true;
+}
+
+const FastGlyphCache& FastGraphics::getGlyphCache() {
+    return glyph_cache;
+}
+
+// =============================================================================
+// TEXT LAYOUT
+// =============================================================================
+
+int16_t FastGraphics::textWidth(const char* str, uint8_t size) {
+    int16_t w, h;
+    measureText(str, w, h, size);
+    return w;
+}
+
+/**
+ * @brief Measure text
+ * @implementation Streams TextLayout::nextLine() over the string, so any number of
+ *                 lines is measured without a layout object.
+ */
+void FastGraphics::measureText(const char* str, int16_t& w, int16_t& h, uint8_t size, int16_t max_width) {
+    w = 0;
+    h = 0;
+    if (!str) return;
+    int16_t line_height = font ? font->yAdvance : size * 8;
+    while (str) {
+        const char* next;
+        TextLine line = TextLayout::nextLine(str, font, size, max_width, next);
+        if (line.width > w) w = line.width;
+        h += h ? line_spacing + line_height : line_height;
+        str = next;
+    }
+}
+
+bool FastGraphics::layoutText(TextLayout& layout, const char* str, int16_t max_width, uint8_t size) {
+    return layout.update(str, font, size, max_width, line_spacing);
+}
+
+/**
+ * @brief Draw a run of characters on one line
+ * @implementation Characters go to drawChar() or drawFontChar() one by one; a tab
+ *                 only advances (and paints its background when opaque).
+ */
+int16_t FastGraphics::drawRun(int16_t x, int16_t y, const char* str, size_t length, uint16_t color, uint16_t bg,
+                              uint8_t size) {
+    for (size_t i = 0; i < length; i++) {
+        char c = str[i];
+        if (c == '\r') continue;
+        if (c == '\t') {
+            int16_t tab = TextLayout::advance(c, font, size);
+            if (bg != color) fillRect(x, y, tab, font ? font->yAdvance : size * 8, bg);
+            x += tab;
+        } else if (font) {
+            x += drawFontChar(x, y, (uint8_t)c, color, bg);
+        } else {
+            drawChar(x, y, c, color, bg, size);
+            x += size * 8;
+        }
+    }
+    return x;
+}
+
+/**
+ * @brief Draw a laid out text block
+ * @implementation Opaque blocks fill the alignment margins of each line and the
+ *                 line spacing gaps next to the glyph cells, which together paint
+ *                 the block exactly once.
+ */
+TextBox FastGraphics::drawLayout(int16_t x, int16_t y, const TextLayout& layout, uint16_t color, uint16_t bg,
+                                 TextAlign align) {
+    int16_t box_w = layout.getMaxWidth() > layout.getWidth() ? layout.getMaxWidth() : layout.getWidth();
+    int16_t line_height = layout.getLineHeight();
+    int16_t spacing = layout.getLineSpacing();
+    bool opaque = bg != color;
+    const char* str = layout.getText();
+    int16_t line_y = y;
+    
+    for (uint8_t i = 0; i < layout.getLineCount(); i++) {
+        const TextLine& line = layout.getLine(i);
+        int16_t offset = 0;
+        if (align == ALIGN_RIGHT) offset = box_w - line.width;
+        else if (align == ALIGN_CENTER) offset = (box_w - line.width) / 2;
+        
+        if (opaque && offset > 0) fillRect(x, line_y, offset, line_height, bg);
+        int16_t end = drawRun(x + offset, line_y, str + line.start, line.length, color, bg, layout.getSize());
+        if (opaque && end < x + box_w) fillRect(end, line_y, x + box_w - end, line_height, bg);
+        line_y += line_height;
+        
+        if (i + 1 < layout.getLineCount()) {
+            if (opaque && spacing > 0) fillRect(x, line_y, box_w, spacing, bg);
+            line_y += spacing;
+        }
+    }
+    return { x, y, box_w, layout.getHeight() };
+}
+
+/**
+ * @brief Draw text aligned to an anchor
+ * @implementation Lays the text out on the stack (no wrapping), places the block,
+ *                 clears the old box minus the new one, then draws the block,
+ *                 which paints its own box. The two areas are disjoint, so every
+ *                 pixel is written once.
+ */
+TextBox FastGraphics::drawAligned(int16_t x, int16_t y, const char* str, TextAlign align, uint16_t color,
+                                  uint16_t bg, uint8_t size, const TextBox* previous) {
+    TextLayout layout;
+    layout.update(str, font, size, 0, line_spacing);
+    int16_t left = x;
+    if (align == ALIGN_RIGHT) left = x - layout.getWidth();
+    else if (align == ALIGN_CENTER) left = x - layout.getWidth() / 2;
+    
+    TextBox box = { left, y, layout.getWidth(), layout.getHeight() };
+    if (previous && bg != color) fillOutside(*previous, box, bg);
+    return drawLayout(left, y, layout, color, bg, align);
+}
+
+void FastGraphics::fillOutside(const TextBox& old, const TextBox& box, uint16_t color) {
+    if (old.w <= 0 || old.h <= 0) return;
+    int16_t old_x1 = old.x + old.w, old_y1 = old.y + old.h;
+    int16_t x0 = old.x > box.x ? old.x : box.x;
+    int16_t y0 = old.y > box.y ? old.y : box.y;
+    int16_t x1 = old_x1 < box.x + box.w ? old_x1 : box.x + box.w;
+    int16_t y1 = old_y1 < box.y + box.h ? old_y1 : box.y + box.h;
+    if (x0 >= x1 || y0 >= y1) {
+        fillRect(old.x, old.y, old.w, old.h, color);
+        return;
+    }
+    if (old.y < y0) fillRect(old.x, old.y, old.w, y0 - old.y, color);       // Above
+    if (old_y1 > y1) fillRect(old.x, y1, old.w, old_y1 - y1, color);        // Below
+    if (old.x < x0) fillRect(old.x, y0, x0 - old.x, y1 - y0, color);        // Left
+    if (old_x1 > x1) fillRect(x1, y0, old_x1 - x1, y1 - y0, color);         // Right
+}
+
+// =============================================================================
+// ADVANCED TEXT FUNCTIONS
+// =============================================================================
+
+void FastGraphics::setCursor(int16_t x, int16_t y) {
+    cursor_x = x;
+    cursor_y = y;
+}
+
+void FastGraphics::setTextColor(uint16_t color, uint16_t bg) {
+    text_color = color;
+    text_bg_color = bg;
+}
+
+void FastGraphics::setTextSize(uint8_t size) {
+    if (size >= 1 && size <= 10) {  // Reasonable size limits
+        text_size = size;
+    }
+}
+
+void FastGraphics::setTextWrap(bool wrap) {
+    text_wrap = wrap;
+}
+
+void FastGraphics::setLineSpacing(int16_t spacing) {
+    if (spacing >= 0 && spacing <= 20) {  // Reasonable limits
+        line_spacing = spacing;
+    }
+}
+
+int16_t FastGraphics::getLineSpacing() {
+    return line_spacing;
+}
+
+void FastGraphics::getCursor(int16_t& x, int16_t& y) {
+    x = cursor_x;
+    y = cursor_y;
+}
+
+int16_t FastGraphics::getCursorX() {
+    return cursor_x;
+}
+
+int16_t FastGraphics::getCursorY() {
+    return cursor_y;
+}
+
+void FastGraphics::setTextArea(int16_t x, int16_t y, int16_t w, int16_t h) {
+    text_area_x = x;
+    text_area_y = y;
+    text_area_w = w;
+    text_area_h = h;
+}
+
+void FastGraphics::clearTextArea() {
+    fillRect(text_area_x, text_area_y, text_area_w, text_area_h, text_bg_color);
+    cursor_x = text_area_x;
+    cursor_y = text_area_y;
+}
+
+void FastGraphics::setTextScroll(bool scroll) {
+    text_scroll = scroll;
+}
+
+bool FastGraphics::getTextScroll() {
+    return text_scroll;
+}
+
+/**
+ * @brief Scroll the content of a rectangle upwards
+ * @implementation Maps the rectangle to physical coordinates once. Logical "up" is
+ *                 physical up (ROTATION_0), down (180), right (90) or left (270):
+ *                 the first two copy whole row spans between rows, the portrait
+ *                 cases memmove within each physical row. Full-width landscape
+ *                 rectangles are contiguous and move with a single memmove.
+ *                 Only the exposed strip is filled.
+ * @performance O(w*h) memory moves, no per-pixel work
+ */
+void FastGraphics::scrollRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dy, uint16_t color) {
+    if (w <= 0 || h <= 0 || dy <= 0) return;
+    if (render_task) {
+        // Queued in order, so the render task moves exactly what was drawn before
+        record({ CMD_SCROLL, 0, color, (uint16_t)dy, x, y, w, h }, x, y, w, h);
+        return;
+    }
+    if (indexed_buffer) {
+        scrollIndexed(x, y, w, h, dy, color);
+        return;
+    }
+    if (deferred) {
+        // Scrolling moves existing pixels: bring the framebuffer up to date first
+        if (!frame_buffer) return;
+        renderCommands();
+    }
+    if (viewport_rows) {
+        scrollViewportRect(x, y, w, h, dy, color);
+        return;
+    }
+    if (async_mode) FastDMA::waitIdle();  // Also the back buffer copies of swapBuffers()
+    screen.scrollRect(x, y, w, h, dy, color);
+    markDrawn(x, y, w, h);
+}
+
+/**
+ * @brief scrollRect() on the index buffer
+ * @implementation Same moves as FastCanvas::scrollRect() on packed rows, through
+ *                 FastPalette::movePixels(); full-width landscape rectangles stay a
+ *                 single memmove. The exposed strip is recorded as a fill, so it is
+ *                 replayed after the move like any later command.
+ */
+void FastGraphics::scrollIndexed(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dy, uint16_t color) {
+    renderCommands();
+    
+    // Only the visible part of the rectangle scrolls
+    int16_t cx, cy, cw, ch;
+    if (!screen.getClip(cx, cy, cw, ch)) return;
+    int16_t x1 = min(x + w, cx + cw), y1 = min(y + h, cy + ch);
+    x = max(x, cx);
+    y = max(y, cy);
+    w = x1 - x;
+    h = y1 - y;
+    if (w <= 0 || h <= 0) return;
+    
+    if (dy < h) {
+        int16_t px = x, py = y, pw = w, ph = h;
+        screen.transformRect(px, py, pw, ph);
+        int32_t stride = FastPalette::rowBytes(pixel_format, LCD_H_RES);
+        uint8_t* base = &indexed_buffer[py * stride];
+        
+        switch (screen.getRotation()) {
+            case ROTATION_0:   // Rows move up
+                if (pw == LCD_H_RES) {
+                    memmove(base, base + dy * stride, (size_t)(ph - dy) * stride);
+                } else {
+                    for (int16_t row = 0; row < ph - dy; row++) {
+                        FastPalette::movePixels(base + (row + dy) * stride, px, base + row * stride, px, pw,
+                                                pixel_format);
+                    }
+                }
+                break;
+                
+            case ROTATION_180: // Rows move down
+                if (pw == LCD_H_RES) {
+                    memmove(base + dy * stride, base, (size_t)(ph - dy) * stride);
+                } else {
+                    for (int16_t row = ph - 1; row >= dy; row--) {
+                        FastPalette::movePixels(base + (row - dy) * stride, px, base + row * stride, px, pw,
+                                                pixel_format);
+                    }
+                }
+                break;
+                
+            case ROTATION_90:  // Spans move right within each row
+                for (int16_t row = 0; row < ph; row++) {
+                    uint8_t* ptr = base + row * stride;
+                    FastPalette::movePixels(ptr, px, ptr, px + dy, pw - dy, pixel_format);
+                }
+                break;
+                
+            case ROTATION_270: // Spans move left within each row
+                for (int16_t row = 0; row < ph; row++) {
+                    uint8_t* ptr = base + row * stride;
+                    FastPalette::movePixels(ptr, px + dy, ptr, px, pw - dy, pixel_format);
+                }
+                break;
+        }
+    } else {
+        dy = h;
+    }
+    
+    fillRect(x, y + h - dy, w, dy, color);
+    markDrawn(x, y, w, h);
+}
+
+// =============================================================================
+// SCROLL VIEWPORT
+// =============================================================================
+
+/**
+ * @brief Turn a band of full-width rows into a circular scroll viewport
+ * @implementation Commands reach record() while the viewport is on, which draws
+ *                 them through drawViewport(). A previous viewport is unrolled
+ *                 first, so the new one starts in display order.
+ */
+bool FastGraphics::setScrollViewport(int16_t y, int16_t h) {
+    if (viewport_rows) {
+        unrollViewport();
+        viewport_rows = 0;
+        recording = deferred || render_task;
+    }
+    if (h <= 0) return true;
+    
+    ScreenRotation rotation = screen.getRotation();
+    if (rotation == ROTATION_90 || rotation == ROTATION_270) return false;
+    if (deferred || double_buffered || render_task || rotate_on_flush || !frame_buffer) return false;
+    if (y < 0 || y + h > LCD_V_RES) return false;
+    
+    viewport_y = y;
+    viewport_top = rotation == ROTATION_180 ? LCD_V_RES - (y + h) : y;
+    viewport_rows = h;
+    viewport_offset = 0;
+    recording = true;
+    return true;
+}
+
+/**
+ * @brief Scroll the viewport content
+ * @implementation Moving the ring start by the scrolled rows puts every row where
+ *                 it belongs; the rows that wrapped around still hold the content
+ *                 that scrolled out and are filled in storage order, ignoring the
+ *                 clip. The whole band is then dirty, the panel sees every row move.
+ * @performance One fill of |lines| full rows, no pixel is moved
+ */
+void FastGraphics::scrollViewport(int16_t lines, uint16_t color) {
+    if (!viewport_rows || lines == 0) return;
+    if (lines > viewport_rows) lines = viewport_rows;
+    if (lines < -viewport_rows) lines = -viewport_rows;
+    if (async_mode) FastDMA::waitIdle();  // Transfers may still target the rows to clear
+    
+    // Up on the screen is towards row 0 in ROTATION_0, away from it in ROTATION_180
+    int16_t step = screen.getRotation() == ROTATION_180 ? -lines : lines;
+    viewport_offset = (int16_t)(((viewport_offset + step) % viewport_rows + viewport_rows) % viewport_rows);
+    
+    int16_t top = viewport_top, bottom = viewport_top + viewport_rows;
+    int16_t row0 = step > 0 ? bottom - step : top;
+    int16_t row1 = step > 0 ? bottom : top - step;
+    ViewportPart parts[4];
+    uint8_t count = viewportParts(row0, row1, parts);
+    for (uint8_t i = 0; i < count; i++) {
+        int16_t y0 = max(row0, parts[i].row0), y1 = min(row1, parts[i].row1);
+        FastKernels::fill16(&parts[i].rows[(y0 - parts[i].row0) * LCD_H_RES], color, (size_t)(y1 - y0) * LCD_H_RES);
+    }
+    addDirtyRect(0, top, LCD_H_RES, bottom);
+}
+
+bool FastGraphics::getScrollViewport(int16_t& y, int16_t& h) {
+    y = viewport_rows ? viewport_y : 0;
+    h = viewport_rows;
+    return viewport_rows != 0;
+}
+
+uint8_t FastGraphics::viewportParts(int16_t row0, int16_t row1, ViewportPart* parts) {
+    int16_t top = viewport_top;
+    int16_t bottom = viewport_top + viewport_rows;
+    int16_t split = bottom - viewport_offset;  // First screen row stored at the top of the ring
+    const ViewportPart all[4] = {
+        { frame_buffer, 0, top },
+        { &frame_buffer[(top + viewport_offset) * LCD_H_RES], top, split },
+        { &frame_buffer[top * LCD_H_RES], split, bottom },
+        { &frame_buffer[bottom * LCD_H_RES], bottom, (int16_t)LCD_V_RES }
+    };
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        if (all[i].row0 < all[i].row1 && all[i].row1 > row0 && all[i].row0 < row1) {
+            parts[count++] = all[i];
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Draw a command through the scroll viewport
+ * @implementation FastCanvas::setRows() makes the screen canvas hold just one part
+ *                 at its storage, keeping rotation, clip, glyph cache and async mode,
+ *                 so each part is drawn exactly like a deferred band.
+ */
+void FastGraphics::drawViewport(const DrawCommand& cmd) {
+    ViewportPart parts[4];
+    uint8_t count = viewportParts(cmd.row0, cmd.row1, parts);
+    for (uint8_t i = 0; i < count; i++) {
+        screen.setRows(parts[i].rows, parts[i].row0, parts[i].row1);
+        execute(screen, cmd);
+    }
+    screen.setRows(frame_buffer, 0, LCD_V_RES);
+}
+
+uint16_t* FastGraphics::viewportRow(int16_t row) {
+    if (row >= viewport_top && row < viewport_top + viewport_rows) {
+        row = viewport_top + (row - viewport_top + viewport_offset) % viewport_rows;
+    }
+    return &frame_buffer[(int32_t)row * LCD_H_RES];
+}
+
+/**
+ * @brief scrollRect() while a scroll viewport is on
+ * @implementation The viewport only exists in ROTATION_0/180, where logical rows
+ *                 are physical rows, up or down. Each screen row is found through
+ *                 the ring, so spans are copied one row at a time in the order
+ *                 FastCanvas::scrollRect() uses, reading every source row before it
+ *                 is overwritten. The exposed strip is a fillRect(), which is drawn
+ *                 through the ring like any primitive. The whole band unclipped
+ *                 only advances the ring.
+ * @performance Same row copies as without a viewport, except for the whole band,
+ *              which moves no pixel
+ */
+void FastGraphics::scrollViewportRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dy, uint16_t color) {
+    int16_t cx, cy, cw, ch;
+    if (!screen.getClip(cx, cy, cw, ch)) return;
+    if (x == 0 && w == screen.getWidth() && y == viewport_y && h == viewport_rows &&
+        cx <= x && cy <= y && cx + cw >= x + w && cy + ch >= y + h) {
+        scrollViewport(dy, color);
+        return;
+    }
+    
+    // Only the visible part of the rectangle scrolls
+    int16_t x1 = min(x + w, cx + cw), y1 = min(y + h, cy + ch);
+    x = max(x, cx);
+    y = max(y, cy);
+    w = x1 - x;
+    h = y1 - y;
+    if (w <= 0 || h <= 0) return;
+    if (async_mode) FastDMA::waitIdle();
+    
+    if (dy < h) {
+        int16_t px = x, py = y, pw = w, ph = h;
+        screen.transformRect(px, py, pw, ph);
+        if (screen.getRotation() == ROTATION_0) {      // Rows move up
+            for (int16_t row = 0; row < ph - dy; row++) {
+                FastKernels::copy16(viewportRow(py + row) + px, viewportRow(py + row + dy) + px, pw);
+            }
+        } else {                                        // ROTATION_180: rows move down
+            for (int16_t row = ph - 1; row >= dy; row--) {
+                FastKernels::copy16(viewportRow(py + row) + px, viewportRow(py + row - dy) + px, pw);
+            }
+        }
+    } else {
+        dy = h;
+    }
+    
+    fillRect(x, y + h - dy, w, dy, color);
+    markDrawn(x, y, w, h);
+}
+
+/**
+ * @brief Put the viewport rows back in display order
+ * @implementation Rotates the ring left by its offset with three row reversals
+ *                 (first part, second part, all), swapping rows through a small
+ *                 stack buffer. The panel content does not change.
+ * @performance Every ring row is moved twice, once per viewport end
+ */
+void FastGraphics::unrollViewport() {
+    if (viewport_offset == 0) return;
+    if (async_mode) FastDMA::waitIdle();
+    const int16_t ranges[3][2] = {
+        { 0, viewport_offset }, { viewport_offset, viewport_rows }, { 0, viewport_rows }
+    };
+    uint16_t swap[64];
+    for (uint8_t r = 0; r < 3; r++) {
+        int16_t lo = ranges[r][0], hi = ranges[r][1] - 1;
+        for (; lo < hi; lo++, hi--) {
+            uint16_t* a = &frame_buffer[(viewport_top + lo) * LCD_H_RES];
+            uint16_t* b = &frame_buffer[(viewport_top + hi) * LCD_H_RES];
+            for (int16_t x = 0; x < LCD_H_RES; x += 64) {
+                size_t n = min(64, LCD_H_RES - x);
+                memcpy(swap, a + x, n * sizeof(uint16_t));
+                memcpy(a + x, b + x, n * sizeof(uint16_t));
+                memcpy(b + x, swap, n * sizeof(uint16_t));
+            }
+        }
+    }
+    viewport_offset = 0;
+}
+
+/**
+ * @brief Internal helper to advance cursor position
+ * @implementation Moves cursor and handles automatic line wrapping when enabled.
+ *                 Checks text area boundaries for wrapping decisions.
+ */
+void FastGraphics::advanceCursor(uint8_t char_width, uint8_t char_height) {
+    cursor_x += char_width;
+    
+    // Check for line wrap
+    if (text_wrap && cursor_x + char_width > text_area_x + text_area_w) {
+        newLine();
+    }
+}
+
+int16_t FastGraphics::lineHeight() {
+    return font ? font->yAdvance : text_size * 8;
+}
+
+/**
+ * @brief Move cursor to next line
+ * @implementation Resets X to text area left edge, advances Y by character height
+ *                 plus line spacing. On overflow either scrolls the text area by
+ *                 the overflow amount or clears it, depending on text_scroll.
+ */
+void FastGraphics::newLine() {
+    cursor_x = text_area_x;
+    cursor_y += lineHeight() + line_spacing;  // Character height + line spacing
+    
+    // Check if we've gone past the text area
+    int16_t overflow = cursor_y + lineHeight() - (text_area_y + text_area_h);
+    if (overflow > 0) {
+        if (text_scroll) {
+            // Move existing lines up just enough for the new line to fit
+            scrollRect(text_area_x, text_area_y, text_area_w, text_area_h, overflow, text_bg_color);
+            cursor_y -= overflow;
+            if (cursor_y < text_area_y) cursor_y = text_area_y;
+        } else {
+            // Clear and restart at the top
+            clearTextArea();
+        }
+    }
+}
+
+// =============================================================================
+// PRINT FUNCTIONS - Support all common data types
+// =============================================================================
+
+/**
+ * @brief Print a C-style string
+ * @implementation Character-by-character rendering with special handling for
+ *                 control characters like newline and carriage return.
+ */
+void FastGraphics::print(const char* str) {
+    print(str, strlen(str));
+}
+
+void FastGraphics::print(const char* str, size_t length) {
+    const char* end = str + length;
+    while (str < end) {
+        print(*str++);
+    }
+}
+
+void FastGraphics::print(const String& str) {
+    print(str.c_str(), str.length());
+}
+
+/**
+ * @brief Print integers
+ * @implementation FastFormat digit-pair conversion into a stack buffer, no sprintf.
+ */
+void FastGraphics::print(int number) {
+    char buffer[FG_FORMAT_BUFFER_SIZE];
+    print(buffer, FastFormat::formatSigned(buffer, number));
+}
+
+void FastGraphics::print(unsigned int number) {
+    char buffer[FG_FORMAT_BUFFER_SIZE];
+    print(buffer, FastFormat::formatUnsigned(buffer, number));
+}
+
+void FastGraphics::print(long number) {
+    char buffer[FG_FORMAT_BUFFER_SIZE];
+    print(buffer, FastFormat::formatSigned(buffer, number));
+}
+
+void FastGraphics::print(unsigned long number) {
+    char buffer[FG_FORMAT_BUFFER_SIZE];
+    print(buffer, FastFormat::formatUnsigned(buffer, number));
+}
+
+/**
+ * @brief Print floating point numbers
+ * @implementation FastFormat fixed-point conversion: one rounding step, then the
+ *                 integer and fraction parts are printed as integers.
+ */
+void FastGraphics::print(float number, int decimals) {
+    char buffer[FG_FORMAT_BUFFER_SIZE];
+    print(buffer, FastFormat::formatFixed(buffer, number, decimals));
+}
+
+void FastGraphics::print(double number, int decimals) {
+    char buffer[FG_FORMAT_BUFFER_SIZE];
+    print(buffer, FastFormat::formatFixed(buffer, number, decimals));
+}
+
+void FastGraphics::print(char character) {
+    if (character == '\n') {
+        newLine();
     } else if (character == '\r') {
-        cursor_x = text_area_x;
+        cursor_x = text_area_x;  // Carriage return
+    } else if (font) {
+        int16_t advance = drawFontChar(cursor_x, cursor_y, (uint8_t)character, text_color, text_bg_color);
+        if (advance) advanceCursor(advance, font->yAdvance);
     } else if (character >= 0 && character <= 127) {
         drawChar(cursor_x, cursor_y, character, text_color, text_bg_color, text_size);
         advanceCursor(text_size * 8, text_size * 8);
     }
 }
 
-void FastGraphics::print(bool value) {
-    print(value ? "true" : "false");
+void FastGraphics::print(bool value) {
+    print(value ? "true" : "false");
+}
+
+/**
+ * @brief FastFormat output callback feeding the glyph renderer
+ */
+static void printFormattedChar(char c, void* context) {
+    FastGraphics::print(c);
+}
+
+/**
+ * @brief Print formatted text
+ * @implementation FastFormat::vformat() emits each character straight to print(char).
+ */
+void FastGraphics::printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    FastFormat::vformat(printFormattedChar, nullptr, format, args);
+    va_end(args);
+}
+
+// Println versions (add newline after printing)
+void FastGraphics::println(const char* str) {
+    print(str);
+    print("\n");
+}
+
+void FastGraphics::println(const String& str) {
+    print(str);
+    print("\n");  
+}
+
+void FastGraphics::println(int number) {
+    print(number);
+    print("\n");
+}
+
+void FastGraphics::println(unsigned int number) {
+    print(number);
+    print("\n");
+}
+
+void FastGraphics::println(long number) {
+    print(number);
+    print("\n");
+}
+
+void FastGraphics::println(unsigned long number) {
+    print(number);
+    print("\n");
+}
+
+void FastGraphics::println(float number, int decimals) {
+    print(number, decimals);
+    print("\n");
+}
+
+void FastGraphics::println(double number, int decimals) {
+    print(number, decimals);
+    print("\n");
+}
+
+void FastGraphics::println(char character) {
+    print(character);
+    print("\n");
+}
+
+void FastGraphics::println(bool value) {
+    print(value);
+    print("\n");
+}
+
+/**
+ * @brief Print text with automatic word wrapping
+ * @implementation Streams TextLayout::nextLine() over the string: each line is
+ *                 measured once and drawn from the string itself, with no word
+ *                 buffer and no limit on word or text length.
+ * @performance One width lookup per character plus the glyph drawing
+ */
+void FastGraphics::printWrapped(int16_t x, int16_t y, int16_t maxWidth, const char* str, uint16_t color, uint8_t size) {
+    if (!str) return;
+    int16_t line_step = (font ? font->yAdvance : size * 8) + line_spacing;  // Include line spacing
+    while (str) {
+        const char* next;
+        TextLine line = TextLayout::nextLine(str, font, size, maxWidth, next);
+        drawRun(x, y, str, line.length, color, text_bg_color, size);
+        y += line_step;
+        str = next;
+    }
+}
+
+// Convenience text functions
+void FastGraphics::textSmall(int16_t x, int16_t y, const char* str, uint16_t color) {
+    text(x, y, str, color, COLOR_BLACK, 1);
+}
+
+void FastGraphics::textMedium(int16_t x, int16_t y, const char* str, uint16_t color) {
+    text(x, y, str, color, COLOR_BLACK, 2);
+}
+
+void FastGraphics::textLarge(int16_t x, int16_t y, const char* str, uint16_t color) {
+    text(x, y, str, color, COLOR_BLACK, 3);
+}
+
+// =============================================================================
+// DEMO FUNCTION
+// =============================================================================
+
+/**
+ * @brief Run a comprehensive graphics demonstration
+ * @implementation Showcases various library capabilities including text formatting,
+ *                 colors, text areas, and word wrapping. Useful for testing.
+ */
+void FastGraphics::demo() {
+    clear(COLOR_BLACK);
+    
+    // Demo the new text features
+    setCursor(10, 10);
+    setTextColor(COLOR_WHITE);
+    setTextSize(1);
+    
+    println("=== FastGraphics Text Demo ===");
+    println();
+    
+    // Different colors and sizes
+    setTextColor(COLOR_GREEN);
+    print("Green text, ");
+    setTextColor(COLOR_RED);
+    print("Red text, ");
+    setTextColor(COLOR_BLUE);
+    println("Blue text");
+    println();
+    
+    // Numbers and formatting
+    setTextColor(COLOR_YELLOW);
+    print("Temperature: ");
+    print(25.6, 1);
+    println(" C");
+    
+    print("Count: ");
+    println(42);
+    println();
+    
+    // Text wrapping demo
+    setTextColor(COLOR_CYAN);
+    printWrapped(10, cursor_y, screen.getWidth() - 20, 
+                "This is a long line that should automatically wrap to the next line when it reaches the edge of the display. Pretty cool, right?", 
+                COLOR_CYAN, 1);
+    
+    setCursor(10, cursor_y + 40);
+    
+    // Text area demo
+    setTextColor(COLOR_WHITE);
+    fillRect(screen.getWidth() - 200, 100, 180, 100, COLOR_BLUE);
+    setTextArea(screen.getWidth() - 190, 110, 160, 80);
+    setCursor(screen.getWidth() - 190, 110);
+    setTextColor(COLOR_WHITE);
+    
+    println("Text Area:");
+    println("Confined to");
+    println("this blue box");
+    println("with auto-wrap");
+    
+    // Reset text area to full screen
+    setTextArea(0, 0, screen.getWidth(), screen.getHeight());
+}
+
+// =============================================================================
+// DEFERRED RENDERING
+// =============================================================================
+
+/**
+ * @brief Initialize the library in deferred (display-list) mode
+ * @implementation Allocates the command list(s) and, with a framebuffer, the band
+ *                 buffer in internal SRAM on first use; later calls reuse them.
+ */
+bool FastGraphics::beginDeferred(uint16_t* framebuffer, esp_lcd_panel_handle_t panel_handle) {
+    if (!allocateDeferred(framebuffer ? 1 : 2, framebuffer != nullptr)) return false;
+    begin(framebuffer, panel_handle);
+    startDeferred();
+    return true;
+}
+
+/**
+ * @brief Initialize the library on a palettised framebuffer
+ * @implementation Deferred mode with a framebuffer, except that the band buffer is
+ *                 loaded and stored through the palette (loadBand(), storeBand())
+ *                 and sent through it (flushIndexed()). The screen canvas never
+ *                 draws, like in framebuffer-less deferred mode.
+ */
+bool FastGraphics::beginIndexed(uint8_t* framebuffer, PixelFormat format, const FastPalette* palette,
+                                esp_lcd_panel_handle_t panel_handle) {
+    if (!framebuffer || !palette) return false;
+    if (format != PIXEL_INDEX8 && format != PIXEL_INDEX4 && format != PIXEL_INDEX1) return false;
+    if (LCD_H_RES % 8) return false;  // Rows must be whole bytes in every format
+    if (!allocateDeferred(1, true)) return false;
+    
+    begin(nullptr, panel_handle);
+    indexed_buffer = framebuffer;
+    pixel_format = format;
+    index_palette = palette;
+    startDeferred();
+    return true;
+}
+
+PixelFormat FastGraphics::getPixelFormat() {
+    return pixel_format;
+}
+
+bool FastGraphics::allocateDeferred(int list_count, bool band) {
+    for (int i = 0; i < list_count; i++) {
+        if (!command_lists[i]) {
+            command_lists[i] = (DrawCommand*)heap_caps_malloc(FG_MAX_COMMANDS * sizeof(DrawCommand),
+                                                              MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+            if (!command_lists[i]) return false;
+        }
+    }
+    if (band && !band_buffer) {
+        band_buffer = (uint16_t*)heap_caps_malloc(LCD_H_RES * FG_BAND_LINES * sizeof(uint16_t),
+                                                  MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (!band_buffer) return false;
+    }
+    return true;
+}
+
+void FastGraphics::startDeferred() {
+    shown_commands = nullptr;
+    pending_commands = nullptr;
+    commands = command_lists[0];
+    command_count = 0;
+    dropped_commands = 0;
+    deferred = true;
+    recording = true;
+    screen.setAsync(false);  // Replay bands are internal SRAM, drawn by the CPU
+}
+
+uint16_t FastGraphics::getCommandCount() {
+    return command_count;
+}
+
+uint32_t FastGraphics::getDroppedCommands() {
+    return dropped_commands;
+}
+
+/**
+ * @brief Record a command in deferred, render task or scroll viewport mode
+ * @implementation With a render task the command goes to its queue together with
+ *                 the dirty box, which only the render task tracks. A scroll
+ *                 viewport draws it right away through the ring. In deferred mode
+ *                 a full-screen fill hides everything recorded before it, so the
+ *                 list restarts there. A full list is replayed early when there is a
+ *                 framebuffer to replay into, otherwise the command is dropped.
+ */
+void FastGraphics::record(DrawCommand cmd, int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (cmd.type != CMD_DIRTY) clipBox(x, y, w, h);
+    DirtyRect r;
+    if (!physicalBounds(x, y, w, h, r)) return;  // Entirely off screen or clipped away
+    
+    if (render_task) {
+        enqueue(cmd, r);
+        return;
+    }
+    if (viewport_rows) {
+        cmd.row0 = r.y0;
+        cmd.row1 = r.y1;
+        drawViewport(cmd);
+        addDirtyRect(r.x0, r.y0, r.x1, r.y1);
+        return;
+    }
+    if (cmd.type == CMD_FILL_RECT && r.x0 == 0 && r.y0 == 0 && r.x1 == LCD_H_RES && r.y1 == LCD_V_RES) {
+        command_count = 0;
+    }
+    if (command_count == FG_MAX_COMMANDS) {
+        if (!frame_buffer && !indexed_buffer) {
+            dropped_commands++;
+            return;
+        }
+        renderCommands();
+    }
+    if (command_count == 0 && clip_depth) {
+        commands[command_count++] = clipCommand();  // Replay starts unclipped
+    }
+    
+    cmd.row0 = r.y0;
+    cmd.row1 = r.y1;
+    commands[command_count++] = cmd;
+    addDirtyRect(r.x0, r.y0, r.x1, r.y1);
+}
+
+void FastGraphics::execute(FastCanvas& target, const DrawCommand& cmd) {
+    switch (cmd.type) {
+        case CMD_FILL_RECT:   target.fillRect(cmd.a, cmd.b, cmd.c, cmd.d, cmd.color);                  break;
+        case CMD_PIXEL:       target.pixel(cmd.a, cmd.b, cmd.color);                                   break;
+        case CMD_LINE:        target.line(cmd.a, cmd.b, cmd.c, cmd.d, cmd.color);                      break;
+        case CMD_CIRCLE:      target.circle(cmd.a, cmd.b, cmd.c, cmd.color);                           break;
+        case CMD_FILL_CIRCLE: target.fillCircle(cmd.a, cmd.b, cmd.c, cmd.color);                       break;
+        case CMD_CHAR:        target.drawChar(cmd.a, cmd.b, (char)cmd.c, cmd.color, cmd.bg, cmd.size); break;
+        case CMD_IMAGE: {
+            // data points at the first pixel drawn, bg holds the source stride
+            const uint16_t* src = (const uint16_t*)cmd.data;
+            if (cmd.size) {
+                target.blit(cmd.a, cmd.b, src, cmd.bg, cmd.d, 0, 0, cmd.c, cmd.d, cmd.color);
+            } else {
+                target.blit(cmd.a, cmd.b, src, cmd.bg, cmd.d, 0, 0, cmd.c, cmd.d);
+            }
+            break;
+        }
+        case CMD_BITMAP:
+            target.drawBitmap(cmd.a, cmd.b, (const uint8_t*)cmd.data, cmd.c, cmd.d, cmd.color, cmd.bg);
+            break;
+        case CMD_SCROLL:      target.scrollRect(cmd.a, cmd.b, cmd.c, cmd.d, (int16_t)cmd.bg, cmd.color);  break;
+        case CMD_LINE_AA:     target.lineAA(cmd.a, cmd.b, cmd.c, cmd.d, cmd.color);                    break;
+        case CMD_THICK_LINE_AA:
+            target.thickLineAA(cmd.a, cmd.b, cmd.c, cmd.d, cmd.size, cmd.color);
+            break;
+        case CMD_CIRCLE_AA:   target.circleAA(cmd.a, cmd.b, cmd.c, cmd.color);                         break;
+        case CMD_FILL_CIRCLE_AA:
+            target.fillCircleAA(cmd.a, cmd.b, cmd.c, cmd.color);
+            break;
+        case CMD_ARC_AA:
+            target.arcAA(cmd.a, cmd.b, cmd.c, cmd.d, (int16_t)cmd.bg, cmd.size, cmd.color);
+            break;
+        case CMD_PIXEL_ALPHA: target.blendPixel(cmd.a, cmd.b, cmd.color, cmd.alpha);                    break;
+        case CMD_FILL_RECT_ALPHA:
+            target.fillRectAlpha(cmd.a, cmd.b, cmd.c, cmd.d, cmd.color, cmd.alpha);
+            break;
+        case CMD_DIM:         target.dimRect(cmd.a, cmd.b, cmd.c, cmd.d, cmd.size);                    break;
+        case CMD_IMAGE_ALPHA: {
+            const uint16_t* src = (const uint16_t*)cmd.data;
+            if (cmd.size) {
+                target.blitAlpha(cmd.a, cmd.b, src, cmd.bg, cmd.d, 0, 0, cmd.c, cmd.d, cmd.alpha, cmd.color);
+            } else {
+                target.blitAlpha(cmd.a, cmd.b, src, cmd.bg, cmd.d, 0, 0, cmd.c, cmd.d, cmd.alpha);
+            }
+            break;
+        }
+        case CMD_MASK:        target.drawMask(cmd.a, cmd.b, (const uint8_t*)cmd.data, cmd.c, cmd.d, cmd.color); break;
+        case CMD_GLYPH:
+            target.drawGlyph(cmd.a, cmd.b, (const GFXfont*)cmd.data, cmd.size, (uint16_t)cmd.c, cmd.color);
+            break;
+        case CMD_COMPRESSED:
+            target.blitCompressed(cmd.a, cmd.b, (const uint8_t*)cmd.data, (int16_t)cmd.color, (int16_t)cmd.bg,
+                                  cmd.c, cmd.d);
+            break;
+        case CMD_CLIP:
+            if (cmd.size) {
+                target.setClip(cmd.a, cmd.b, cmd.c, cmd.d);
+            } else {
+                target.resetClip();
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Replay the recorded list into the framebuffer band by band
+ * @implementation For each FG_BAND_LINES band, finds the rows the commands actually
+ *                 touch, loads just those rows from PSRAM into the SRAM band buffer
+ *                 (skipped when a full-width fill covers them anyway), replays the
+ *                 commands into a canvas holding just those rows, then stores the
+ *                 rows back. PSRAM only sees sequential bursts. An index buffer is
+ *                 expanded on load and packed on store.
+ * @performance Each PSRAM row is read and written at most once per flush,
+ *              independent of how often commands overlap
+ */
+void FastGraphics::renderCommands() {
+    if (command_count == 0) return;
+    
+    for (int16_t band_y = 0; band_y < LCD_V_RES; band_y += FG_BAND_LINES) {
+        int16_t band_end = min(band_y + FG_BAND_LINES, LCD_V_RES);
+        
+        // Rows of this band touched by any command (clips span every band)
+        int16_t lo = band_end, hi = band_y;
+        uint16_t first = command_count;
+        const DrawCommand* head_clip = nullptr;
+        for (uint16_t i = 0; i < command_count; i++) {
+            const DrawCommand& cmd = commands[i];
+            if (cmd.type == CMD_CLIP) {
+                if (first == command_count) head_clip = &cmd;
+                continue;
+            }
+            if (cmd.row1 <= band_y || cmd.row0 >= band_end) continue;
+            if (first == command_count) first = i;
+            lo = min(lo, max(cmd.row0, band_y));
+            hi = max(hi, min(cmd.row1, band_end));
+        }
+        if (first == command_count) continue;
+        
+        // A first command filling whole rows makes loading them pointless
+        bool covered = false;
+        const DrawCommand& head = commands[first];
+        if (head.type == CMD_FILL_RECT) {
+            int16_t x = head.a, y = head.b, w = head.c, h = head.d;
+            if (head_clip && head_clip->size) {
+                int16_t x1 = x + w, y1 = y + h;
+                if (x < head_clip->a) x = head_clip->a;
+                if (y < head_clip->b) y = head_clip->b;
+                if (x1 > head_clip->a + head_clip->c) x1 = head_clip->a + head_clip->c;
+                if (y1 > head_clip->b + head_clip->d) y1 = head_clip->b + head_clip->d;
+                w = x1 - x;
+                h = y1 - y;
+            }
+            DirtyRect r;
+            if (physicalBounds(x, y, w, h, r)) {
+                covered = r.x0 == 0 && r.x1 == LCD_H_RES && r.y0 <= lo && r.y1 >= hi;
+            }
+        }
+        
+        if (!covered) loadBand(lo, hi);
+        
+        FastCanvas band;
+        bandCanvas(band, lo, hi);
+        for (uint16_t i = 0; i < command_count; i++) {
+            const DrawCommand& cmd = commands[i];
+            if (cmd.row1 > lo && cmd.row0 < hi) execute(band, cmd);
+        }
+        
+        storeBand(lo, hi);
+    }
+    command_count = 0;
 }
 
-// Println versions (add newline after printing)
-void FastGraphics::println(const char* str) {
-    print(str);
-    print("\n");
+/**
+ * @brief Load physical rows into the band buffer
+ * @implementation Whole rows of an index buffer are whole bytes, so consecutive rows
+ *                 are one packed run and expand with a single call.
+ */
+void FastGraphics::loadBand(int16_t row0, int16_t row1) {
+    size_t pixels = (size_t)(row1 - row0) * LCD_H_RES;
+    if (indexed_buffer) {
+        int32_t stride = FastPalette::rowBytes(pixel_format, LCD_H_RES);
+        index_palette->expand(&indexed_buffer[row0 * stride], pixel_format, 0, pixels, band_buffer);
+    } else {
+        FastKernels::copy16(band_buffer, &frame_buffer[row0 * LCD_H_RES], pixels);
+    }
 }
 
-void FastGraphics::println(String str) {
-    print(str);
-    print("\n");  
+void FastGraphics::storeBand(int16_t row0, int16_t row1) {
+    size_t pixels = (size_t)(row1 - row0) * LCD_H_RES;
+    if (indexed_buffer) {
+        int32_t stride = FastPalette::rowBytes(pixel_format, LCD_H_RES);
+        index_palette->pack(band_buffer, pixel_format, 0, pixels, &indexed_buffer[row0 * stride]);
+    } else {
+        FastKernels::copy16(&frame_buffer[row0 * LCD_H_RES], band_buffer, pixels);
+    }
 }
 
-void FastGraphics::println(int number) {
-    print(number);
-    print("\n");
+void FastGraphics::bandCanvas(FastCanvas& band, int16_t row0, int16_t row1) {
+    band.setBuffer(band_buffer, LCD_H_RES, LCD_V_RES);
+    band.setRows(band_buffer, row0, row1);
+    band.setRotation(screen.getRotation());
+    band.setGlyphCache(screen.getGlyphCache());
 }
 
-void FastGraphics::println(unsigned int number) {
-    print(number);
-    print("\n");
+/**
+ * @brief Make a recorded frame the one renderBand() shows
+ * @implementation Must run in one place only (frame start of renderBand(), or the
+ *                 flush() fallback) so the shown list never changes mid-frame.
+ */
+static inline void adoptPendingCommands() {
+    DrawCommand* next = pending_commands;
+    if (next) {
+        shown_count = pending_count;
+        shown_commands = next;
+        pending_commands = nullptr;
+    }
 }
 
-void FastGraphics::println(long number) {
-    print(number);
-    print("\n");
+/**
+ * @brief Hand the recorded frame to renderBand() (framebuffer-less mode)
+ * @implementation Publishes the list and waits until renderBand() picks it up at the
+ *                 start of the next refresh, so the previously shown list is free to
+ *                 record into. Gives up after 100 ms (panel not refreshing) and
+ *                 switches directly.
+ */
+void FastGraphics::publishCommands() {
+    pending_count = command_count;
+    pending_commands = commands;
+    
+    TickType_t start = xTaskGetTickCount();
+    while (pending_commands && xTaskGetTickCount() - start < pdMS_TO_TICKS(100)) {
+        vTaskDelay(1);
+    }
+    adoptPendingCommands();
+    
+    commands = shown_commands == command_lists[0] ? command_lists[1] : command_lists[0];
+    command_count = 0;
+    dirty_count = 0;
 }
 
-void FastGraphics::println(unsigned long number) {
-    print(number);
-    print("\n");
+/**
+ * @brief Render rows of the current frame into a band buffer
+ * @implementation Clears the band, then replays the commands whose rows intersect
+ *                 it into a canvas holding just those rows. An index buffer already
+ *                 holds the frame and is only expanded. Everything runs in
+ *                 FastKernels scalar mode: as bounce-buffer callback this is the
+ *                 LCD interrupt, which must not touch the PIE registers.
+ */
+void FastGraphics::renderBand(uint16_t* band, int y, int lines, void* user_ctx) {
+    (void)user_ctx;
+    FastKernels::beginScalar();
+    if (indexed_buffer) {
+        int32_t stride = FastPalette::rowBytes(pixel_format, LCD_H_RES);
+        index_palette->expand(&indexed_buffer[y * stride], pixel_format, 0, (int32_t)lines * LCD_H_RES, band);
+    } else {
+        if (y == 0) adoptPendingCommands();
+        
+        FastKernels::fill16(band, COLOR_BLACK, (size_t)lines * LCD_H_RES);
+        const DrawCommand* list = shown_commands;
+        uint16_t count = shown_count;
+        
+        FastCanvas target(band, LCD_H_RES, LCD_V_RES);
+        target.setRows(band, y, y + lines);
+        target.setRotation(screen.getRotation());
+        for (uint16_t i = 0; list && i < count; i++) {
+            const DrawCommand& cmd = list[i];
+            if (cmd.row1 > y && cmd.row0 < y + lines) execute(target, cmd);
+        }
+    }
+    FastKernels::endScalar();
 }
 
-void FastGraphics::println(float number, int decimals) {
-    print(number, decimals);
-    print("\n");
+// =============================================================================
+// DIRTY REGION TRACKING & FLUSH
+// =============================================================================
+
+/**
+ * @brief Mark a logical rectangle as changed
+ * @implementation Clips to the logical screen, maps the rectangle to physical
+ *                 coordinates once, then hands it to the merging dirty list.
+ */
+void FastGraphics::markDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (render_task && !onRenderTask()) {
+        record({ CMD_DIRTY }, x, y, w, h);
+        return;
+    }
+    DirtyRect r;
+    if (physicalBounds(x, y, w, h, r)) {
+        addDirtyRect(r.x0, r.y0, r.x1, r.y1);
+    }
 }
 
-void FastGraphics::println(double number, int decimals) {
-    print(number, decimals);
-    print("\n");
+bool FastGraphics::physicalBounds(int16_t x, int16_t y, int16_t w, int16_t h, DirtyRect& r) {
+    if (x >= screen.getWidth() || y >= screen.getHeight() || w <= 0 || h <= 0) return false;
+    
+    // Clip to logical screen boundaries
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > screen.getWidth()) w = screen.getWidth() - x;
+    if (y + h > screen.getHeight()) h = screen.getHeight() - y;
+    if (w <= 0 || h <= 0) return false;
+    
+    screen.transformRect(x, y, w, h);
+    r = { x, y, (int16_t)(x + w), (int16_t)(y + h) };
+    return true;
 }
 
-void FastGraphics::println(char character) {
-    print(character);
-    print("\n");
+void FastGraphics::markAllDirty() {
+    if (render_task && !onRenderTask()) {
+        markDirty(0, 0, screen.getWidth(), screen.getHeight());
+        return;
+    }
+    dirty_rects[0] = { 0, 0, screen.getBufferWidth(), screen.getBufferHeight() };
+    dirty_count = 1;
 }
 
-void FastGraphics::println(bool value) {
-    print(value);
-    print("\n");
+bool FastGraphics::isDirty() {
+    return dirty_count > 0;
 }
 
 /**
- * @brief Print text with automatic word wrapping
- * @implementation Intelligent word wrapping that preserves word boundaries.
- *                 Handles spaces, newlines, and tabs appropriately.
- * @algorithm Builds words in buffer, checks if they fit on current line,
- *           wraps to next line if needed while preserving word integrity.
+ * @brief Add a physical rectangle to the dirty list
+ * @implementation Repeatedly absorbs pending rectangles that overlap, touch, or are
+ *                 cheap to merge, since a grown rectangle may reach new neighbours.
+ *                 A full list forces a merge with the least-growth candidate.
+ * @performance O(n²) worst case with n = FG_MAX_DIRTY_RECTS, typically O(n)
  */
-void FastGraphics::printWrapped(int16_t x, int16_t y, int16_t maxWidth, const char* str, uint16_t color, uint8_t size) {
-    int16_t current_x = x;
-    int16_t current_y = y;
-    int16_t word_start_x = x;
-    char word_buffer[50];  // Buffer for current word
-    int word_len = 0;
-    int16_t line_height = size * 8 + line_spacing;  // Include line spacing
-    
-    while (*str) {
-        if (*str == ' ' || *str == '\n' || *str == '\t' || *(str + 1) == '\0') {
-            // End of word - add current character if not space
-            if (*str != ' ' && *str != '\n' && *str != '\t') {
-                word_buffer[word_len++] = *str;
-            }
-            word_buffer[word_len] = '\0';
+void FastGraphics::addDirtyRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        int32_t area = (int32_t)(x1 - x0) * (y1 - y0);
+        
+        for (uint8_t i = 0; i < dirty_count; i++) {
+            DirtyRect& r = dirty_rects[i];
             
-            // Check if word fits on current line
-            int16_t word_width = word_len * size * 8;
-            if (current_x + word_width > x + maxWidth && current_x > x) {
-                // Word doesn't fit - move to next line
-                current_x = x;
-                current_y += line_height;
-                word_start_x = x;
-            }
+            // Already covered - nothing new to track
+            if (x0 >= r.x0 && y0 >= r.y0 && x1 <= r.x1 && y1 <= r.y1) return;
             
-            // Draw the word
-            text(current_x, current_y, word_buffer, color, text_bg_color, size);
-            current_x += word_width;
+            int16_t ux0 = min(x0, r.x0), uy0 = min(y0, r.y0);
+            int16_t ux1 = max(x1, r.x1), uy1 = max(y1, r.y1);
+            int32_t union_area = (int32_t)(ux1 - ux0) * (uy1 - uy0);
+            int32_t r_area = (int32_t)(r.x1 - r.x0) * (r.y1 - r.y0);
+            bool touching = x0 <= r.x1 && r.x0 <= x1 && y0 <= r.y1 && r.y0 <= y1;
             
-            // Handle different separators
-            if (*str == ' ') {
-                current_x += size * 8;  // Add space width
-            } else if (*str == '\n') {
-                current_x = x;
-                current_y += line_height;
-            } else if (*str == '\t') {
-                current_x += size * 8 * 4;  // Tab = 4 spaces
+            if (touching || union_area - area - r_area <= FG_DIRTY_MERGE_SLACK) {
+                // Absorb r and rescan, the grown rectangle may reach others
+                x0 = ux0; y0 = uy0; x1 = ux1; y1 = uy1;
+                dirty_rects[i] = dirty_rects[--dirty_count];
+                merged = true;
+                break;
             }
-            
-            // Reset word buffer
-            word_len = 0;
-            word_start_x = current_x;
-        } else {
-            // Add character to current word
-            if (word_len < 49) {  // Prevent buffer overflow
-                word_buffer[word_len++] = *str;
+        }
+        
+        if (!merged && dirty_count == FG_MAX_DIRTY_RECTS) {
+            // List full - merge with the rectangle whose bounding box grows least
+            uint8_t best = 0;
+            int32_t best_growth = INT32_MAX;
+            for (uint8_t i = 0; i < dirty_count; i++) {
+                const DirtyRect& r = dirty_rects[i];
+                int32_t union_area = (int32_t)(max(x1, r.x1) - min(x0, r.x0)) *
+                                     (max(y1, r.y1) - min(y0, r.y0));
+                int32_t growth = union_area - (int32_t)(r.x1 - r.x0) * (r.y1 - r.y0);
+                if (growth < best_growth) {
+                    best_growth = growth;
+                    best = i;
+                }
             }
+            const DirtyRect& r = dirty_rects[best];
+            x0 = min(x0, r.x0); y0 = min(y0, r.y0);
+            x1 = max(x1, r.x1); y1 = max(y1, r.y1);
+            dirty_rects[best] = dirty_rects[--dirty_count];
+            merged = true;
         }
-        str++;
     }
+    
+    dirty_rects[dirty_count++] = { x0, y0, x1, y1 };
 }
 
-// Convenience text functions
-void FastGraphics::textSmall(int16_t x, int16_t y, const char* str, uint16_t color) {
-    text(x, y, str, color, COLOR_BLACK, 1);
+/**
+ * @brief Rotate the dirty shadow rectangles into the framebuffer
+ * @implementation Each rectangle is rotated straight into its place in the
+ *                 framebuffer, then replaced by its physical counterpart for the
+ *                 panel transfer or the back buffer copy that follows.
+ * @performance Proportional to the dirty area, see FastKernels::rotate16()
+ */
+void FastGraphics::rotateDirtyRects() {
+    if (shadow_rotation == ROTATION_0) return;
+    int16_t w = screen.getBufferWidth();
+    int16_t h = screen.getBufferHeight();
+    for (uint8_t i = 0; i < dirty_count; i++) {
+        DirtyRect l = dirty_rects[i];
+        DirtyRect& r = dirty_rects[i];
+        r = rotatedRect(l, shadow_rotation, w, h);
+        FastKernels::rotate16(&frame_buffer[r.y0 * LCD_H_RES + r.x0], LCD_H_RES,
+                              &shadow_buffer[l.y0 * w + l.x0], w,
+                              l.x1 - l.x0, l.y1 - l.y0, shadow_rotation);
+    }
 }
 
-void FastGraphics::textMedium(int16_t x, int16_t y, const char* str, uint16_t color) {
-    text(x, y, str, color, COLOR_BLACK, 2);
+/**
+ * @brief Send one physical rectangle of the framebuffer to the panel
+ * @implementation esp_lcd_panel_draw_bitmap() expects tightly packed source rows.
+ *                 A full-width band is contiguous in the framebuffer and goes out in
+ *                 one call; narrower rectangles go out one row per call, which
+ *                 avoids a staging copy. Rectangles at least half the screen wide
+ *                 are widened to a band since the extra pixels cost less than the
+ *                 per-call overhead of many rows.
+ */
+void FastGraphics::flushRect(const DirtyRect& r) {
+    if (indexed_buffer) {
+        flushIndexed(r);
+        return;
+    }
+    if (!viewport_rows) {
+        flushRows(r, &frame_buffer[r.y0 * LCD_H_RES]);
+        return;
+    }
+    
+    // The ring goes out in display order, one contiguous part at a time
+    ViewportPart parts[4];
+    uint8_t count = viewportParts(r.y0, r.y1, parts);
+    for (uint8_t i = 0; i < count; i++) {
+        DirtyRect piece = { r.x0, max(r.y0, parts[i].row0), r.x1, min(r.y1, parts[i].row1) };
+        flushRows(piece, &parts[i].rows[(piece.y0 - parts[i].row0) * LCD_H_RES]);
+    }
 }
 
-void FastGraphics::textLarge(int16_t x, int16_t y, const char* str, uint16_t color) {
-    text(x, y, str, color, COLOR_BLACK, 3);
+void FastGraphics::flushRows(const DirtyRect& r, const uint16_t* rows) {
+    if ((r.x1 - r.x0) * 2 >= LCD_H_RES) {
+        FG_PROFILE_BITMAP((uint32_t)(r.y1 - r.y0) * LCD_H_RES);
+        esp_lcd_panel_draw_bitmap(panel, 0, r.y0, LCD_H_RES, r.y1, rows);
+    } else {
+        for (int16_t y = r.y0; y < r.y1; y++) {
+            FG_PROFILE_BITMAP(r.x1 - r.x0);
+            esp_lcd_panel_draw_bitmap(panel, r.x0, y, r.x1, y + 1, &rows[r.x0]);
+            rows += LCD_H_RES;
+        }
+    }
 }
 
-// =============================================================================
-// DEMO FUNCTION
-// =============================================================================
+/**
+ * @brief Send one physical rectangle of the index buffer to the panel
+ * @implementation The rectangle is widened to whole bytes of the 1-bit format (and
+ *                 to full rows from half the screen width, as in flushRows()), then
+ *                 expanded chunk by chunk into the band buffer at its own width, so
+ *                 each chunk is one tightly packed esp_lcd_panel_draw_bitmap() call.
+ *                 The RGB panel driver copies the pixels before returning, so the
+ *                 band is free again for the next chunk.
+ * @performance Reads 1/16 to 1/2 of the PSRAM bytes an RGB565 flush reads
+ */
+void FastGraphics::flushIndexed(const DirtyRect& r) {
+    int16_t x0 = r.x0 & ~7, x1 = (r.x1 + 7) & ~7;
+    if ((x1 - x0) * 2 >= LCD_H_RES) {
+        x0 = 0;
+        x1 = LCD_H_RES;
+    }
+    int16_t w = x1 - x0;
+    int16_t lines = LCD_H_RES * FG_BAND_LINES / w;
+    int32_t stride = FastPalette::rowBytes(pixel_format, LCD_H_RES);
+    
+    for (int16_t y = r.y0; y < r.y1; y += lines) {
+        int16_t end = min((int16_t)(y + lines), r.y1);
+        if (w == LCD_H_RES) {
+            index_palette->expand(&indexed_buffer[y * stride], pixel_format, 0, (int32_t)(end - y) * w, band_buffer);
+        } else {
+            for (int16_t row = y; row < end; row++) {
+                index_palette->expand(&indexed_buffer[row * stride], pixel_format, x0, w, &band_buffer[(row - y) * w]);
+            }
+        }
+        FG_PROFILE_BITMAP((uint32_t)(end - y) * w);
+        esp_lcd_panel_draw_bitmap(panel, x0, y, x1, end, band_buffer);
+    }
+}
 
 /**
- * @brief Run a comprehensive graphics demonstration
- * @implementation Showcases various library capabilities including text formatting,
- *                 colors, text areas, and word wrapping. Useful for testing.
+ * @brief Send only the changed regions of the framebuffer to the panel
+ * @implementation Pushes every pending dirty rectangle, then empties the list.
  */
-void FastGraphics::demo() {
-    clear(COLOR_BLACK);
+void FastGraphics::flush() {
+    if (render_task && !onRenderTask()) {
+        pushMarker(CMD_FRAME);  // The render task flushes once it got here
+        return;
+    }
+    FG_PROFILE_FLUSH();
+    if (async_mode) FastDMA::waitIdle();  // The panel must see finished pixels
+    if (deferred) {
+        if (!frame_buffer && !indexed_buffer) {
+            publishCommands();
+            return;
+        }
+        renderCommands();
+    }
+    if (double_buffered) {
+        swapBuffers();
+        return;
+    }
     
-    // Demo the new text features
-    setCursor(10, 10);
-    setTextColor(COLOR_WHITE);
-    setTextSize(1);
+    rotateDirtyRects();
+    if (panel && (frame_buffer || indexed_buffer)) {
+        for (uint8_t i = 0; i < dirty_count; i++) {
+            flushRect(dirty_rects[i]);
+        }
+    }
+    dirty_count = 0;
+}
+
+void FastGraphics::present() {
+    if (render_task && !onRenderTask()) {
+        pushMarker(CMD_FRAME);
+        return;
+    }
+    if (double_buffered) {
+        FG_PROFILE_FLUSH();
+        if (async_mode) FastDMA::waitIdle();
+        swapBuffers();
+    } else {
+        flush();
+    }
+}
+
+/**
+ * @brief Swap front and back buffers on VSYNC
+ * @implementation Passing one of its own framebuffers to esp_lcd_panel_draw_bitmap()
+ *                 makes the RGB driver write back the CPU cache and switch scanout to
+ *                 that buffer at the next frame start, without copying. The old front
+ *                 buffer is released by the first VSYNC counted after the call has
+ *                 returned: any VSYNC up to then may have come before the driver took
+ *                 the new buffer (e.g. when preempted between the two), and a later
+ *                 one can only be at or after the switch. It then only lacks this
+ *                 frame's dirty rectangles, which are copied over (by FastDMA in async
+ *                 mode, finishing while the next frame is drawn).
+ * @performance Copy cost is proportional to the changed area, not the frame size
+ */
+void FastGraphics::swapBuffers() {
+    if (dirty_count == 0) return;  // Nothing new to show
+    rotateDirtyRects();
     
-    println("=== FastGraphics Text Demo ===");
-    println();
+    FG_PROFILE_BITMAP((uint32_t)LCD_H_RES * LCD_V_RES);
+    esp_lcd_panel_draw_bitmap(panel, 0, 0, LCD_H_RES, LCD_V_RES, frame_buffer);
+    uint32_t handed_over = vsync_count;
+    while (vsync_count == handed_over) {
+        xSemaphoreTake(vsync_semaphore, portMAX_DELAY);  // Gives from earlier frames just loop
+    }
     
-    // Different colors and sizes
-    setTextColor(COLOR_GREEN);
-    print("Green text, ");
-    setTextColor(COLOR_RED);
-    print("Red text, ");
-    setTextColor(COLOR_BLUE);
-    println("Blue text");
-    println();
+    uint16_t* shown = frame_buffer;
+    frame_buffer = front_buffer;
+    front_buffer = shown;
+    if (shadow_rotation == ROTATION_0) screen.setBuffer(frame_buffer, LCD_H_RES, LCD_V_RES);
     
-    // Numbers and formatting
-    setTextColor(COLOR_YELLOW);
-    print("Temperature: ");
-    print(25.6, 1);
-    println(" C");
+    // Bring the new back buffer up to date with the frame just presented
+    void (*copy)(uint16_t*, const uint16_t*, size_t) = async_mode ? FastDMA::copy16 : FastKernels::copy16;
+    for (uint8_t i = 0; i < dirty_count; i++) {
+        const DirtyRect& r = dirty_rects[i];
+        if (r.x0 == 0 && r.x1 == LCD_H_RES) {
+            copy(&frame_buffer[r.y0 * LCD_H_RES], &front_buffer[r.y0 * LCD_H_RES],
+                 (size_t)(r.y1 - r.y0) * LCD_H_RES);
+        } else {
+            for (int16_t y = r.y0; y < r.y1; y++) {
+                copy(&frame_buffer[y * LCD_H_RES + r.x0], &front_buffer[y * LCD_H_RES + r.x0], r.x1 - r.x0);
+            }
+        }
+    }
+    dirty_count = 0;
+}
+
+// =============================================================================
+// RENDER TASK
+// =============================================================================
+
+/**
+ * @brief Start the render task
+ * @implementation Allocates the ring in internal SRAM on first use, so pushing a
+ *                 command never touches PSRAM, then pins the task. Without an
+ *                 explicit core it takes the one the caller is not running on.
+ */
+bool FastGraphics::beginRenderTask(int core, unsigned priority) {
+    if (render_task) return true;
+    if (deferred || !frame_buffer || viewport_rows) return false;
     
-    print("Count: ");
-    println(42);
-    println();
+    if (!queue) {
+        queue = (QueuedCommand*)heap_caps_malloc(FG_QUEUE_COMMANDS * sizeof(QueuedCommand),
+                                                 MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (!queue) return false;
+    }
+    if (!queue_space) queue_space = xSemaphoreCreateBinary();
+    if (!sync_semaphore) sync_semaphore = xSemaphoreCreateBinary();
+    if (!queue_space || !sync_semaphore) return false;
     
-    // Text wrapping demo
-    setTextColor(COLOR_CYAN);
-    printWrapped(10, cursor_y, display_width - 20, 
-                "This is a long line that should automatically wrap to the next line when it reaches the edge of the display. Pretty cool, right?", 
-                COLOR_CYAN, 1);
+    queue_head = 0;
+    queue_tail = 0;
+    queue_waiting = false;
+    queue_stalls = 0;
+    if (core < 0) core = xPortGetCoreID() == 0 ? 1 : 0;
     
-    setCursor(10, cursor_y + 40);
+    TaskHandle_t task = nullptr;
+    if (xTaskCreatePinnedToCore(renderTaskLoop, "fg_render", FG_RENDER_STACK, nullptr, priority,
+                                &task, core) != pdPASS) {
+        return false;
+    }
+    render_task = task;
+    recording = true;
+    return true;
+}
+
+void FastGraphics::stopRenderTask() {
+    if (!render_task || onRenderTask()) return;
+    pushMarker(CMD_STOP);
+    xSemaphoreTake(sync_semaphore, portMAX_DELAY);
+    render_task = nullptr;
+    recording = deferred;
+}
+
+void FastGraphics::waitRenderIdle() {
+    if (!render_task || onRenderTask()) return;
+    pushMarker(CMD_SYNC);
+    xSemaphoreTake(sync_semaphore, portMAX_DELAY);
+}
+
+bool FastGraphics::isRenderTaskRunning() {
+    return render_task != nullptr;
+}
+
+uint32_t FastGraphics::getQueueStalls() {
+    return queue_stalls;
+}
+
+bool FastGraphics::onRenderTask() {
+    return render_task && xTaskGetCurrentTaskHandle() == render_task;
+}
+
+/**
+ * @brief Push a command into the render task queue
+ * @implementation Single-producer/single-consumer ring with free-running indices:
+ *                 the entry is written before the head is published (release), and
+ *                 the tail is read with acquire, so neither side needs a lock.
+ *                 While the ring is full the producer sleeps on a semaphore the
+ *                 render task gives when it frees an entry.
+ * @performance A 32-byte copy to SRAM and two atomic accesses per command
+ */
+void FastGraphics::enqueue(const DrawCommand& cmd, const DirtyRect& box) {
+    uint32_t head = queue_head;
+    if (head - __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE) == FG_QUEUE_COMMANDS) {
+        queue_stalls++;
+        __atomic_store_n(&queue_waiting, true, __ATOMIC_SEQ_CST);
+        xTaskNotifyGive(render_task);
+        while (head - __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE) == FG_QUEUE_COMMANDS) {
+            xSemaphoreTake(queue_space, 1);
+        }
+    }
     
-    // Text area demo
-    setTextColor(COLOR_WHITE);
-    fillRect(display_width - 200, 100, 180, 100, COLOR_BLUE);
-    setTextArea(display_width - 190, 110, 160, 80);
-    setCursor(display_width - 190, 110);
-    setTextColor(COLOR_WHITE);
+    QueuedCommand& entry = queue[head & (FG_QUEUE_COMMANDS - 1)];
+    entry.cmd = cmd;
+    entry.box = box;
+    __atomic_store_n(&queue_head, head + 1, __ATOMIC_RELEASE);
     
-    println("Text Area:");
-    println("Confined to");
-    println("this blue box");
-    println("with auto-wrap");
+    // Keep the render task busy during long frames, not only at their end
+    if (((head + 1) & (FG_QUEUE_COMMANDS / 4 - 1)) == 0) xTaskNotifyGive(render_task);
+}
+
+void FastGraphics::pushMarker(uint8_t type) {
+    enqueue({ type }, DirtyRect{ 0, 0, 0, 0 });
+    xTaskNotifyGive(render_task);
+}
+
+/**
+ * @brief Render task body
+ * @implementation Sleeps until notified, then drains the ring in order. Drawing
+ *                 commands run exactly as in immediate mode and mark their box
+ *                 dirty; CMD_FRAME runs present() here, so the panel only gets what
+ *                 was drawn before the marker.
+ */
+void FastGraphics::renderTaskLoop(void* arg) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        
+        uint32_t tail = queue_tail;
+        while (tail != __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE)) {
+            const QueuedCommand& entry = queue[tail & (FG_QUEUE_COMMANDS - 1)];
+            switch (entry.cmd.type) {
+                case CMD_FRAME:
+                    present();
+                    break;
+                case CMD_SYNC:
+                    xSemaphoreGive(sync_semaphore);
+                    break;
+                case CMD_STOP:
+                    __atomic_store_n(&queue_tail, tail + 1, __ATOMIC_RELEASE);
+                    xSemaphoreGive(sync_semaphore);
+                    vTaskDelete(nullptr);
+                    return;
+                case CMD_CLIP:
+                    execute(screen, entry.cmd);
+                    break;
+                default:
+                    execute(screen, entry.cmd);
+                    addDirtyRect(entry.box.x0, entry.box.y0, entry.box.x1, entry.box.y1);
+                    break;
+            }
+            
+            tail++;
+            __atomic_store_n(&queue_tail, tail, __ATOMIC_RELEASE);
+            if (__atomic_exchange_n(&queue_waiting, false, __ATOMIC_SEQ_CST)) {
+                xSemaphoreGive(queue_space);
+            }
+        }
+    }
+}
+
+// =============================================================================
+// ASYNC DMA
+// =============================================================================
+
+/**
+ * @brief Enable or disable DMA offloading
+ * @implementation Installs the FastDMA driver on first use. Disabling waits for the
+ *                 queue so no transfer outlives async mode.
+ */
+bool FastGraphics::setAsync(bool enable) {
+    waitRenderIdle();  // The render task may be using the DMA right now
+    if (!enable) {
+        FastDMA::waitIdle();
+        screen.setAsync(false);
+        async_mode = false;
+        return true;
+    }
+    if (!FastDMA::begin()) return false;
+    screen.setAsync(!deferred);
+    async_mode = true;
+    return true;
+}
+
+bool FastGraphics::getAsync() {
+    return async_mode;
+}
+
+void FastGraphics::waitIdle() {
+    waitRenderIdle();
+    FastDMA::waitIdle();
+}
+
+// =============================================================================
+// PROFILING
+// =============================================================================
+
+const FrameStats& FastGraphics::getFrameStats() {
+    return profile_last;
+}
+
+#if FG_PROFILE
+/**
+ * @brief Append a fixed-point value and a suffix to an overlay line
+ */
+static size_t appendStat(char* line, size_t len, const char* label, double value, int decimals, const char* unit) {
+    size_t n = strlen(label);
+    memcpy(line + len, label, n);
+    len += n;
+    len += FastFormat::formatFixed(line + len, value, decimals);
+    n = strlen(unit);
+    memcpy(line + len, unit, n + 1);
+    return len + n;
+}
+#endif
+
+/**
+ * @brief Draw a two-line FPS / frame time overlay
+ * @implementation Converts cycles to milliseconds with the current CPU clock and
+ *                 formats with FastFormat, so the overlay does not disturb the heap.
+ */
+void FastGraphics::drawStatsOverlay(int16_t x, int16_t y, uint16_t color, uint16_t bg) {
+#if FG_PROFILE
+    const FrameStats& stats = profile_last;
+    double cycles_per_ms = getCpuFrequencyMhz() * 1000.0;
+    char line[64];
     
-    // Reset text area to full screen
-    setTextArea(0, 0, display_width, display_height);
-}
\ No newline at end of file
+    size_t len = appendStat(line, 0, "FPS ", stats.fps, 1, "");
+    appendStat(line, len, "  frame ", stats.frame_us / 1000.0, 2, "ms ");
+    text(x, y, line, color, bg, 1);
+    
+    len = appendStat(line, 0, "draw ", stats.draw_cycles / cycles_per_ms, 2, "ms");
+    appendStat(line, len, "  flush ", stats.flush_cycles / cycles_per_ms, 2, "ms ");
+    text(x, y + 8 + line_spacing, line, color, bg, 1);
+#else
+    (void)x; (void)y; (void)color; (void)bg;
+#endif
+}
@@ -5,31 +5,142 @@
 #define FAST_GRAPHICS_H
 
 #include <Arduino.h>
+#include "esp_lcd_panel_ops.h"  // For esp_lcd_panel_handle_t and partial flushes
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"      // For the render task handle
+#include "FastCanvas.h"          // Drawing surface, ScreenRotation, FG_DMA_MIN_PIXELS, FG_PROFILE
+#include "FastGlyphCache.h"      // Scaled glyph tiles, FG_GLYPH_CACHE_BYTES
+#include "FastLayout.h"          // TextLayout, TextBox, TextAlign
+#include "FastImage.h"           // Compressed images, mapPartition()
+#include "FastPalette.h"         // Palettised framebuffers (beginIndexed())
+#include "display_config.h"      // Panel size: LCD_H_RES / LCD_V_RES, LCD_MAX_*, LCD_RUNTIME_PANEL
 
 // =============================================================================
 // LIBRARY CONFIGURATION
 // =============================================================================
 
-// Display dimensions (adjust for your display)
-#ifndef LCD_H_RES
-#define LCD_H_RES 800
+// Dirty region tracking (see flush())
+#ifndef FG_MAX_DIRTY_RECTS
+#define FG_MAX_DIRTY_RECTS 16       /**< Max separate dirty rectangles before forced merging */
 #endif
 
-#ifndef LCD_V_RES  
-#define LCD_V_RES 480
+#ifndef FG_DIRTY_MERGE_SLACK
+#define FG_DIRTY_MERGE_SLACK 1024   /**< Extra pixels a merge may add without overlap/contact */
 #endif
 
+// Deferred rendering (see beginDeferred())
+#ifndef FG_MAX_COMMANDS
+#define FG_MAX_COMMANDS 512         /**< Draw commands recorded per frame (24 bytes each) */
+#endif
+
+#ifndef FG_BAND_LINES
+#define FG_BAND_LINES 32            /**< Physical rows per replay band (internal SRAM buffer) */
+#endif
+
+// Render task (see beginRenderTask())
+#ifndef FG_QUEUE_COMMANDS
+#define FG_QUEUE_COMMANDS 256       /**< Command queue entries, power of two (32 bytes each) */
+#endif
+
+#ifndef FG_RENDER_STACK
+#define FG_RENDER_STACK 4096        /**< Render task stack size in bytes */
+#endif
+
+// Clipping (see pushClip())
+#ifndef FG_CLIP_DEPTH
+#define FG_CLIP_DEPTH 8             /**< Nested clip rectangles */
+#endif
+
+/**
+ * @enum ProfilePrimitive
+ * @brief Primitives counted separately in FrameStats
+ */
+enum ProfilePrimitive {
+    PROFILE_FILL_RECT   = 0,  /**< fillRect(), clear(), horizontal/vertical line() */
+    PROFILE_PIXEL       = 1,  /**< pixel() */
+    PROFILE_LINE        = 2,  /**< Diagonal line() */
+    PROFILE_CHAR        = 3,  /**< One glyph of text()/print() */
+    PROFILE_FILL_CIRCLE = 4,  /**< fillCircle() */
+    PROFILE_IMAGE       = 5,  /**< drawImage(), blit(), drawBitmap(), drawBitmap4(), compressed images */
+    PROFILE_ANTIALIAS   = 6,  /**< lineAA(), thickLineAA(), circleAA(), fillCircleAA(), arcAA() */
+    PROFILE_BLEND       = 7,  /**< blendPixel(), fillRectAlpha(), dimRect(), alpha images, drawMask() */
+    PROFILE_PRIMITIVE_COUNT
+};
+
+/**
+ * @struct PrimitiveStats
+ * @brief Per-primitive counters for one frame
+ */
+struct PrimitiveStats {
+    uint32_t calls;     /**< Number of calls */
+    uint32_t pixels;    /**< Framebuffer pixels written (after clipping) */
+    uint32_t cycles;    /**< CPU cycles spent inside the calls */
+};
+
+/**
+ * @struct FrameStats
+ * @brief Timing of one frame, from one flush()/present() to the next
+ */
+struct FrameStats {
+    PrimitiveStats primitives[PROFILE_PRIMITIVE_COUNT]; /**< Indexed by ProfilePrimitive */
+    uint32_t draw_cycles;       /**< Sum of all primitive cycles */
+    uint32_t flush_cycles;      /**< Cycles inside flush()/present(), incl. VSYNC wait */
+    uint32_t flush_calls;       /**< esp_lcd_panel_draw_bitmap() calls */
+    uint32_t flush_pixels;      /**< Pixels handed to esp_lcd_panel_draw_bitmap() */
+    uint32_t frame_us;          /**< Wall time since the previous frame ended */
+    float fps;                  /**< 1 / frame_us */
+};
+
+/**
+ * @enum DrawCommandType
+ * @brief Primitive recorded in a DrawCommand
+ */
+enum DrawCommandType {
+    CMD_FILL_RECT       = 0,   /**< a,b = x,y  c,d = w,h */
+    CMD_PIXEL           = 1,   /**< a,b = x,y */
+    CMD_LINE            = 2,   /**< a,b = x0,y0  c,d = x1,y1 */
+    CMD_CIRCLE          = 3,   /**< a,b = center  c = radius */
+    CMD_FILL_CIRCLE     = 4,   /**< a,b = center  c = radius */
+    CMD_CHAR            = 5,   /**< a,b = x,y  c = character, size and bg used */
+    CMD_IMAGE           = 6,   /**< a,b = x,y  c,d = w,h  bg = source stride, size = keyed, color = key */
+    CMD_BITMAP          = 7,   /**< a,b = x,y  c,d = w,h  1-bit data, bg == color: transparent */
+    CMD_SCROLL          = 8,   /**< a,b = x,y  c,d = w,h  bg = dy, color = exposed fill (render task) */
+    CMD_DIRTY           = 9,   /**< Marks its box dirty, draws nothing (render task) */
+    CMD_FRAME           = 10,  /**< End of frame: flush()/present() (render task) */
+    CMD_SYNC            = 11,  /**< Wakes waitRenderIdle() (render task) */
+    CMD_STOP            = 12,  /**< Ends the render task */
+    CMD_LINE_AA         = 13,  /**< a,b = x0,y0  c,d = x1,y1 */
+    CMD_THICK_LINE_AA   = 14,  /**< a,b = x0,y0  c,d = x1,y1  size = thickness */
+    CMD_CIRCLE_AA       = 15,  /**< a,b = center  c = radius */
+    CMD_FILL_CIRCLE_AA  = 16,  /**< a,b = center  c = radius */
+    CMD_ARC_AA          = 17,  /**< a,b = center  c = radius  d = start angle, bg = end angle, size = thickness */
+    CMD_CLIP            = 18,  /**< a,b = x,y  c,d = w,h  size = 1: clip to the box, 0: no clip */
+    CMD_PIXEL_ALPHA     = 19,  /**< a,b = x,y  alpha */
+    CMD_FILL_RECT_ALPHA = 20,  /**< a,b = x,y  c,d = w,h  alpha */
+    CMD_DIM             = 21,  /**< a,b = x,y  c,d = w,h  size = level */
+    CMD_IMAGE_ALPHA     = 22,  /**< As CMD_IMAGE, alpha */
+    CMD_MASK            = 23,  /**< a,b = x,y  c,d = w,h  8-bit coverage data */
+    CMD_GLYPH           = 24,  /**< a,b = pen on the baseline  c = code  size = bpp  data = GFXfont */
+    CMD_COMPRESSED      = 25   /**< a,b = x,y  c,d = w,h  color,bg = source x,y  data = FastImage */
+};
+
 /**
- * @enum ScreenRotation
- * @brief Screen rotation options for display orientation
- * @details Defines the four possible screen orientations. ROTATION_0 and ROTATION_180 
- *          maintain landscape orientation, while ROTATION_90 and ROTATION_270 switch to portrait.
+ * @struct DrawCommand
+ * @brief One recorded drawing operation in logical coordinates
+ * @details row0/row1 hold the physical framebuffer rows the command can touch, so
+ *          replaying a band skips commands outside it without decoding them.
+ *          Image commands keep a pointer to the caller's pixels, which are read
+ *          again each time the command is replayed.
  */
-enum ScreenRotation {
-    ROTATION_0   = 0,  /**< Landscape (default): 800x480 */
-    ROTATION_90  = 1,  /**< Portrait: 480x800 */
-    ROTATION_180 = 2,  /**< Landscape flipped: 800x480 */
-    ROTATION_270 = 3   /**< Portrait flipped: 480x800 */
+struct DrawCommand {
+    uint8_t type;           /**< DrawCommandType */
+    uint8_t size;           /**< Text size (CMD_CHAR), thickness (CMD_THICK_LINE_AA, CMD_ARC_AA), clip on (CMD_CLIP), bpp (CMD_GLYPH) */
+    uint16_t color;         /**< RGB565 color */
+    uint16_t bg;            /**< RGB565 background (CMD_CHAR) */
+    int16_t a, b, c, d;     /**< Parameters, see DrawCommandType */
+    int16_t row0, row1;     /**< Physical rows touched, end-exclusive */
+    uint8_t alpha;          /**< Opacity (CMD_PIXEL_ALPHA, CMD_FILL_RECT_ALPHA, CMD_IMAGE_ALPHA) */
+    const void* data;       /**< Source pixels (CMD_IMAGE, CMD_BITMAP, CMD_IMAGE_ALPHA, CMD_MASK, CMD_COMPRESSED), font (CMD_GLYPH) */
 };
 
 // RGB565 color definitions
@@ -83,17 +194,43 @@ public:
      *          in PSRAM with size LCD_H_RES * LCD_V_RES * sizeof(uint16_t).
      * 
      * @param framebuffer Pointer to pre-allocated framebuffer (RGB565 format)
+     * @param panel Panel handle used by flush() (default: nullptr, flush() disabled)
      * 
      * @note The framebuffer must remain valid for the lifetime of graphics operations
      * @note Default settings: rotation=0, text_size=1, text_color=WHITE, text_wrap=true
+     * @note The whole screen starts out dirty so the first flush() sends a full frame
      * 
      * @example
      * @code
      * uint16_t* fb = (uint16_t*)heap_caps_malloc(800*480*2, MALLOC_CAP_SPIRAM);
-     * FastGraphics::begin(fb);
+     * FastGraphics::begin(fb, panel_handle);
+     * @endcode
+     */
+    static void begin(uint16_t* framebuffer, esp_lcd_panel_handle_t panel = nullptr);
+    
+    /**
+     * @brief Initialize the library in tear-free double-buffer mode
+     * @details Uses the two framebuffers owned by the RGB panel driver (panel created
+     *          with num_fbs = 2, see LCD_NUM_FBS in display_config.h). Drawing always goes
+     *          to the back buffer while the LCD DMA scans out the front buffer, and
+     *          present() swaps them on VSYNC.
+     * 
+     * @param panel RGB panel handle created with two framebuffers
+     * @return true on success, false if the panel has no second framebuffer
+     * 
+     * @note Replaces begin(); all other settings get the same defaults
+     * @note No separate PSRAM framebuffer is needed in this mode
+     * 
+     * @example
+     * @code
+     * // display_config.h: #define LCD_NUM_FBS 2
+     * initialize_display_and_framebuffer();
+     * FastGraphics::beginDoubleBuffered(panel_handle);
+     * FastGraphics::fillRect(10, 10, 100, 50, COLOR_RED);
+     * FastGraphics::present();    // Swap on next VSYNC
      * @endcode
      */
-    static void begin(uint16_t* framebuffer);
+    static bool beginDoubleBuffered(esp_lcd_panel_handle_t panel);
     
     // =============================================================================
     // SCREEN ROTATION FUNCTIONS
@@ -142,6 +279,88 @@ public:
      */
     static int16_t getHeight();
     
+    /**
+     * @brief Draw rotated screens unrotated and rotate them on flush
+     * @details In ROTATION_90/180/270 every primitive maps its coordinates and walks
+     *          the framebuffer with rotated strides. With this mode on, drawing goes
+     *          to a logical-orientation shadow buffer instead, where every primitive
+     *          takes the ROTATION_0 path (contiguous rows, vector fills). flush() and
+     *          present() then rotate just the dirty rectangles into the framebuffer
+     *          with FastKernels::rotate16(), so the rotation cost follows the changed
+     *          area rather than the number of primitives.
+     * 
+     * @param enable true to draw into the shadow buffer while rotated
+     * @return false if the 768 KB PSRAM shadow buffer cannot be allocated, or in
+     *         deferred mode (bands are replayed physical), or before begin()
+     * 
+     * @note Allocated on first use and kept; begin() turns the mode off again
+     * @note ROTATION_0 needs no shadow and draws into the framebuffer as usual
+     * @note Switching the mode or the rotation converts the screen content once
+     * @note Works with double buffering, the render task and async mode
+     * 
+     * @example
+     * @code
+     * FastGraphics::setRotation(ROTATION_90);
+     * FastGraphics::setRotateOnFlush(true);
+     * FastGraphics::fillRect(0, 0, 480, 100, COLOR_BLUE);  // Unrotated row fills
+     * FastGraphics::flush();                               // Rotates 480x100 once
+     * @endcode
+     */
+    static bool setRotateOnFlush(bool enable);
+    
+    /**
+     * @brief Check whether rotate-on-flush mode is on
+     */
+    static bool getRotateOnFlush();
+    
+    // =============================================================================
+    // CLIPPING
+    // =============================================================================
+    
+    /**
+     * @brief Restrict drawing to a rectangle
+     * @details Intersects the rectangle with the current clip and makes the result the
+     *          new clip, until the matching popClip(). Every primitive, image and text
+     *          function draws only inside it, and only the visible part is marked
+     *          dirty. Primitives cut themselves to the clip once (lines by their end
+     *          points, circles and glyphs by their bounding box, fills and images by
+     *          their rectangle), so inner loops do not test pixels.
+     * 
+     * @param x, y Top-left corner in the current rotation
+     * @param w, h Size in pixels (a clip may be empty: nothing is drawn)
+     * @return false if FG_CLIP_DEPTH clips are already pushed (the clip is unchanged)
+     * 
+     * @note Recorded in order in deferred and render task mode
+     * @note setRotation() and begin() remove all clips
+     * @note markDirty() ignores the clip
+     * 
+     * @example
+     * @code
+     * FastGraphics::pushClip(20, 60, 200, 100);     // List view
+     * for (int i = 0; i < count; i++) {
+     *     FastGraphics::text(24, 60 + i * 12 - scroll, items[i], COLOR_WHITE, COLOR_BLACK);
+     * }
+     * FastGraphics::popClip();
+     * @endcode
+     */
+    static bool pushClip(int16_t x, int16_t y, int16_t w, int16_t h);
+    
+    /**
+     * @brief Restore the clip that was active before the last pushClip()
+     */
+    static void popClip();
+    
+    /**
+     * @brief Remove all clips
+     */
+    static void resetClip();
+    
+    /**
+     * @brief Get the current clip rectangle
+     * @details The whole screen when no clip is pushed.
+     */
+    static void getClip(int16_t& x, int16_t& y, int16_t& w, int16_t& h);
+    
     // =============================================================================
     // CORE DRAWING FUNCTIONS
     // =============================================================================
@@ -175,6 +394,7 @@ public:
      * @note Negative coordinates are clipped to screen edges
      * @note Zero or negative width/height are ignored
      * @note Optimized with unrolled loops for maximum speed
+     * @note Equally fast in all rotations (the rectangle is rotated, not each pixel)
      * 
      * @example
      * @code
@@ -279,254 +499,841 @@ public:
     static void circle(int16_t x0, int16_t y0, int16_t radius, uint16_t color);
     
     // =============================================================================
-    // BASIC TEXT FUNCTIONS
+    // ANTI-ALIASED DRAWING
     // =============================================================================
     
     /**
-     * @brief Draw text at specified position
-     * @details Renders text using the built-in 8x8 pixel font with optional scaling.
-     *          Supports basic ASCII characters (0-127). Text can have background color.
+     * @brief Draw an anti-aliased line, 1 pixel wide
+     * @details Xiaolin Wu's algorithm in 16.16 fixed point: each step along the major
+     *          axis splits the color between the two pixels the line passes between
+     *          and blends it over the framebuffer. The visible part of the line is
+     *          found before the loop, so off-screen lengths cost nothing.
      * 
-     * @param x Left edge X coordinate for text
-     * @param y Top edge Y coordinate for text
-     * @param str Null-terminated string to draw
-     * @param color RGB565 text color
-     * @param bg RGB565 background color (default: COLOR_BLACK)
-     * @param size Text scaling factor 1-10 (default: 1)
+     * @param x0 Starting point X coordinate
+     * @param y0 Starting point Y coordinate
+     * @param x1 Ending point X coordinate
+     * @param y1 Ending point Y coordinate
+     * @param color RGB565 line color
      * 
-     * @note Each character is 8x8 pixels at size=1
-     * @note Size 2 = 16x16 pixels per character, etc.
-     * @note Newline characters (\n) move to next line
-     * @note Characters outside ASCII 0-127 range are ignored
+     * @note Horizontal and vertical lines are drawn solid with line()
+     * @note Blending uses 33 alpha levels (see FastKernels::blendPixel())
      * 
      * @example
      * @code
-     * FastGraphics::text(10, 10, "Hello", COLOR_WHITE);                    // Basic text
-     * FastGraphics::text(10, 30, "Large", COLOR_RED, COLOR_BLUE, 2);      // 2x size with blue background
-     * FastGraphics::text(10, 70, "Line1\nLine2", COLOR_GREEN);            // Multi-line text
+     * FastGraphics::lineAA(400, 240, needle_x, needle_y, COLOR_RED);
      * @endcode
      */
-    static void text(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg = COLOR_BLACK, uint8_t size = 1);
+    static void lineAA(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
     
     /**
-     * @brief Draw small text (size 1)
-     * @details Convenience function for drawing text at size 1 with black background.
+     * @brief Draw an anti-aliased line of any thickness with round caps
+     * @details Shades pixels by their distance to the segment: stepped cross products
+     *          along each row, an integer square root only in the caps.
      * 
-     * @param x Left edge X coordinate
-     * @param y Top edge Y coordinate
-     * @param str Text string to draw
-     * @param color RGB565 text color
+     * @param x0 Starting point X coordinate
+     * @param y0 Starting point Y coordinate
+     * @param x1 Ending point X coordinate
+     * @param y1 Ending point Y coordinate
+     * @param thickness Line width in pixels (1: same as lineAA())
+     * @param color RGB565 line color
      * 
-     * @see text() for full parameter control
+     * @example
+     * @code
+     * FastGraphics::thickLineAA(400, 240, needle_x, needle_y, 5, COLOR_RED);  // Gauge needle
+     * @endcode
      */
-    static void textSmall(int16_t x, int16_t y, const char* str, uint16_t color);
+    static void thickLineAA(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t thickness, uint16_t color);
     
     /**
-     * @brief Draw medium text (size 2)
-     * @details Convenience function for drawing text at size 2 with black background.
+     * @brief Draw an anti-aliased circle outline, 1 pixel wide
      * 
-     * @param x Left edge X coordinate
-     * @param y Top edge Y coordinate
-     * @param str Text string to draw
-     * @param color RGB565 text color
+     * @param x0 Center X coordinate
+     * @param y0 Center Y coordinate
+     * @param radius Radius of the outline's center in pixels
+     * @param color RGB565 outline color
      * 
-     * @see text() for full parameter control
+     * @note Radius <= 0 circles are ignored
      */
-    static void textMedium(int16_t x, int16_t y, const char* str, uint16_t color);
+    static void circleAA(int16_t x0, int16_t y0, int16_t radius, uint16_t color);
     
     /**
-     * @brief Draw large text (size 3)
-     * @details Convenience function for drawing text at size 3 with black background.
+     * @brief Draw an anti-aliased filled circle
+     * @details Only the edge pixels are blended; the inside of each row is one fill.
      * 
-     * @param x Left edge X coordinate
-     * @param y Top edge Y coordinate
-     * @param str Text string to draw
-     * @param color RGB565 text color
+     * @param x0 Center X coordinate
+     * @param y0 Center Y coordinate
+     * @param radius Circle radius in pixels (same extent as fillCircle())
+     * @param color RGB565 fill color
      * 
-     * @see text() for full parameter control
+     * @note Radius <= 0 circles are ignored
      */
-    static void textLarge(int16_t x, int16_t y, const char* str, uint16_t color);
-    
-    // =============================================================================
-    // ADVANCED TEXT CURSOR FUNCTIONS
-    // =============================================================================
+    static void fillCircleAA(int16_t x0, int16_t y0, int16_t radius, uint16_t color);
     
     /**
-     * @brief Set the text cursor position
-     * @details Sets the position where the next print() or println() operation will begin.
-     *          The cursor automatically advances as text is printed.
-     * 
-     * @param x X coordinate for cursor
-     * @param y Y coordinate for cursor
+     * @brief Draw an anti-aliased arc
+     * @details Draws the part of a ring from start_angle clockwise to end_angle, with
+     *          smooth edges on all four sides. Angles are whole degrees, 0 at 12
+     *          o'clock and 90 at 3 o'clock in the current rotation.
      * 
-     * @note Cursor position is in pixels, not character cells
-     * @note Used by all print() and println() functions
+     * @param x0 Center X coordinate
+     * @param y0 Center Y coordinate
+     * @param radius Radius of the arc's center line in pixels
+     * @param start_angle First angle in degrees
+     * @param end_angle Last angle in degrees (start_angle + 360 or more: full ring)
+     * @param thickness Arc width in pixels
+     * @param color RGB565 arc color
      * 
      * @example
      * @code
-     * FastGraphics::setCursor(100, 50);
-     * FastGraphics::print("Text starts here");
+     * // 270 degree gauge track and the value part of it
+     * FastGraphics::arcAA(400, 240, 100, 225, 495, 12, COLOR_GRAY);
+     * FastGraphics::arcAA(400, 240, 100, 225, 225 + value * 270 / 100, 12, COLOR_GREEN);
      * @endcode
      */
-    static void setCursor(int16_t x, int16_t y);
+    static void arcAA(int16_t x0, int16_t y0, int16_t radius, int16_t start_angle, int16_t end_angle,
+                      uint8_t thickness, uint16_t color);
+    
+    // =============================================================================
+    // IMAGE FUNCTIONS
+    // =============================================================================
     
     /**
-     * @brief Set text color and optional background color
-     * @details Sets the colors used by print() and println() functions.
-     *          Background color is used to fill behind each character.
+     * @brief Draw an RGB565 image
+     * @details Copies a w x h image (rows stored contiguously, top row first) to the
+     *          screen. The image is clipped against the screen and drawn in the current
+     *          rotation without per-pixel transforms: in ROTATION_0 every row is a single
+     *          FastKernels::copy16() run, the other rotations step through the
+     *          framebuffer with fixed strides in the order that keeps writes sequential.
      * 
-     * @param color RGB565 text foreground color
-     * @param bg RGB565 text background color (default: COLOR_BLACK)
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param image RGB565 pixels in flash, PSRAM or internal SRAM
+     * @param w Image width in pixels
+     * @param h Image height in pixels
      * 
-     * @note Setting bg = color creates invisible text (useful for spacing)
-     * @note Color settings persist until changed
+     * @note Pixels are copied as stored, convert images to the panel's byte order offline
      * 
      * @example
      * @code
-     * FastGraphics::setTextColor(COLOR_WHITE);                    // White text, black background
-     * FastGraphics::setTextColor(COLOR_RED, COLOR_YELLOW);        // Red text on yellow background
+     * extern const uint16_t logo[64 * 32];           // const data stays in flash
+     * FastGraphics::drawImage(10, 10, logo, 64, 32);
      * @endcode
      */
-    static void setTextColor(uint16_t color, uint16_t bg = COLOR_BLACK);
+    static void drawImage(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h);
     
     /**
-     * @brief Set text scaling size
-     * @details Sets the text scaling factor for print() and println() functions.
-     *          Size 1 = 8x8 pixels per character, size 2 = 16x16, etc.
-     * 
-     * @param size Text scaling factor (1-10, default: 1)
+     * @brief Draw an RGB565 image with a transparent color key
+     * @details Same as drawImage() but skips every pixel equal to transparent, so
+     *          sprites can have arbitrary outlines.
      * 
-     * @note Values outside 1-10 range are ignored
-     * @note Larger sizes consume more memory and drawing time
+     * @param transparent RGB565 value that is not drawn
+     */
+    static void drawImage(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h, uint16_t transparent);
+    
+    /**
+     * @brief Draw part of an RGB565 image
+     * @details Copies the source rectangle (sx, sy, sw, sh) of a larger image, e.g. one
+     *          frame of a sprite sheet or a tile of a map, to (x, y). The source
+     *          rectangle is clipped to the image and the destination to the screen.
+     * 
+     * @param x Destination left edge X coordinate
+     * @param y Destination top edge Y coordinate
+     * @param image RGB565 pixels of the whole source image
+     * @param image_w Source image width in pixels (the row stride)
+     * @param image_h Source image height in pixels
+     * @param sx Source rectangle left edge
+     * @param sy Source rectangle top edge
+     * @param sw Source rectangle width
+     * @param sh Source rectangle height
      * 
      * @example
      * @code
-     * FastGraphics::setTextSize(1);    // Small text
-     * FastGraphics::setTextSize(3);    // Large text (24x24 pixels per char)
+     * // 8 animation frames of 32x32 side by side in a 256x32 sheet
+     * FastGraphics::blit(100, 100, sheet, 256, 32, frame * 32, 0, 32, 32);
      * @endcode
      */
-    static void setTextSize(uint8_t size);
+    static void blit(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                     int16_t sx, int16_t sy, int16_t sw, int16_t sh);
     
     /**
-     * @brief Enable or disable automatic text wrapping
-     * @details Controls whether text automatically wraps to the next line when reaching
-     *          the right edge of the text area.
-     * 
-     * @param wrap true to enable wrapping, false to disable
-     * 
-     * @note When disabled, text extends beyond screen boundaries
-     * @note Wrapping uses the current text area boundaries
-     * @note Default: enabled (true)
+     * @brief Draw part of an RGB565 image with a transparent color key
+     * @details Same as blit() but skips every pixel equal to transparent.
      * 
-     * @example
-     * @code
-     * FastGraphics::setTextWrap(true);     // Enable automatic wrapping
-     * FastGraphics::setTextWrap(false);    // Disable wrapping (text may go off-screen)
-     * @endcode
+     * @param transparent RGB565 value that is not drawn
      */
-    static void setTextWrap(bool wrap);
+    static void blit(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                     int16_t sx, int16_t sy, int16_t sw, int16_t sh, uint16_t transparent);
     
     /**
-     * @brief Set additional spacing between text lines
-     * @details Sets extra pixels added between lines when text wraps or when using
-     *          println(). Improves readability for dense text.
+     * @brief Draw an offscreen canvas
+     * @details Copies the canvas buffer to (x, y) like drawImage(), so content that is
+     *          expensive to draw (a gauge face, a rendered label) is drawn once into an
+     *          internal SRAM canvas and then costs one row copy per line per frame.
      * 
-     * @param spacing Additional pixels between lines (0-20, default: 2)
+     * @param x Destination left edge X coordinate
+     * @param y Destination top edge Y coordinate
+     * @param canvas Source canvas, drawn in ROTATION_0
      * 
-     * @note Values outside 0-20 range are ignored
-     * @note This is in addition to the character height
-     * @note Line height = (text_size * 8) + line_spacing
+     * @note In deferred and render task mode the canvas buffer is read when the frame
+     *       is rendered, so it must stay unchanged until then
      * 
      * @example
      * @code
-     * FastGraphics::setLineSpacing(0);     // Tight line spacing
-     * FastGraphics::setLineSpacing(4);     // More readable spacing
-     * FastGraphics::setLineSpacing(10);    // Very loose spacing
+     * static FastCanvas label;
+     * label.begin(120, 16);
+     * label.clear(COLOR_BLACK);
+     * label.text(4, 4, "Temperature", COLOR_WHITE, COLOR_BLACK);
+     * FastGraphics::drawCanvas(20, 20, label);
      * @endcode
      */
-    static void setLineSpacing(int16_t spacing);
+    static void drawCanvas(int16_t x, int16_t y, const FastCanvas& canvas);
     
     /**
-     * @brief Get current line spacing setting
-     * @return Current line spacing in pixels
+     * @brief Draw an offscreen canvas with a transparent color key
+     * @param transparent RGB565 value that is not drawn
      */
-    static int16_t getLineSpacing();
+    static void drawCanvas(int16_t x, int16_t y, const FastCanvas& canvas, uint16_t transparent);
     
     /**
-     * @brief Get current cursor position
-     * @details Returns the current text cursor position by reference.
+     * @brief Draw a 1-bit bitmap
+     * @details Set bits are drawn in color, clear bits in bg. Rows start on a byte
+     *          boundary ((w + 7) / 8 bytes per row) with the leftmost pixel in the
+     *          most significant bit, the layout of common image converters.
      * 
-     * @param x Reference to store current X coordinate
-     * @param y Reference to store current Y coordinate
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param bitmap Packed bitmap data
+     * @param w Bitmap width in pixels
+     * @param h Bitmap height in pixels
+     * @param color RGB565 color of set bits
+     * @param bg RGB565 color of clear bits (same as color: clear bits are transparent)
      * 
      * @example
      * @code
-     * int16_t x, y;
-     * FastGraphics::getCursor(x, y);
-     * Serial.printf("Cursor at: %d, %d\n", x, y);
+     * FastGraphics::drawBitmap(10, 10, icon_wifi, 24, 24, COLOR_WHITE, COLOR_WHITE);
      * @endcode
      */
-    static void getCursor(int16_t& x, int16_t& y);
-    
-    /**
-     * @brief Get current cursor X coordinate
-     * @return Current cursor X position in pixels
-     */
-    static int16_t getCursorX();
+    static void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                           uint16_t color, uint16_t bg);
     
     /**
-     * @brief Get current cursor Y coordinate
-     * @return Current cursor Y position in pixels
+     * @brief Draw a 4-bit paletted bitmap
+     * @details Each pixel is a 4-bit index into a 16-entry RGB565 palette. Rows start
+     *          on a byte boundary ((w + 1) / 2 bytes per row) with the left pixel in
+     *          the high nibble.
+     * 
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param bitmap Packed bitmap data
+     * @param w Bitmap width in pixels
+     * @param h Bitmap height in pixels
+     * @param palette 16 RGB565 colors
+     * @param transparent Palette index that is not drawn (default: -1, none)
+     * 
+     * @note Deferred mode draws it right away (after replaying the pending commands)
+     *       instead of recording it; without a framebuffer it does nothing
      */
-    static int16_t getCursorY();
-    
-    // =============================================================================
-    // PRINT FUNCTIONS (Serial.print-like interface)
-    // =============================================================================
+    static void drawBitmap4(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                            const uint16_t* palette, int16_t transparent = -1);
     
     /**
-     * @brief Print a C-style string
-     * @details Prints text at the current cursor position using current text settings.
-     *          Cursor automatically advances. Supports newline (\n) and carriage return (\r).
+     * @brief Draw a compressed image
+     * @details Decodes an FGI image (see FastImage.h, written by tools/fgimage.py)
+     *          row by row straight into the framebuffer, without a decompression
+     *          buffer. The image can live in a C array or in a data partition mapped
+     *          with FastImage::mapPartition(); either way it is read through the
+     *          flash cache.
      * 
-     * @param str Null-terminated string to print
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param image FGI data, invalid data draws nothing
      * 
-     * @note Handles \n (newline) and \r (carriage return) characters
-     * @note Cursor advances automatically after each character
-     * @note Text wrapping applies if enabled
+     * @note In deferred and render task mode the data is read when the frame is
+     *       rendered, so it must stay mapped until then
      * 
      * @example
      * @code
-     * FastGraphics::print("Hello ");
-     * FastGraphics::print("World!");     // Results in "Hello World!"
+     * #include "dial.h"                              // fgimage.py dial.png -o dial.h
+     * FastGraphics::drawCompressed(200, 40, dial);
      * @endcode
      */
-    static void print(const char* str);
-    
-    /**
-     * @brief Print an Arduino String
-     * @param str Arduino String object to print
-     * @see print(const char*)
-     */
-    static void print(String str);
+    static void drawCompressed(int16_t x, int16_t y, const uint8_t* image);
     
     /**
-     * @brief Print a signed integer
-     * @param number Integer value to print
+     * @brief Draw part of a compressed image
+     * @details Like blit(): copies the source rectangle (sx, sy, sw, sh) to (x, y).
+     *          Decoding starts at row sy through the image's row table, so redrawing
+     *          a small area of a full-screen background costs the rows it covers,
+     *          not the whole image. Columns left of sx are still run through, but
+     *          not written.
+     * 
+     * @param x Destination left edge X coordinate
+     * @param y Destination top edge Y coordinate
+     * @param image FGI data
+     * @param sx Source rectangle left edge
+     * @param sy Source rectangle top edge
+     * @param sw Source rectangle width
+     * @param sh Source rectangle height
      * 
      * @example
      * @code
-     * FastGraphics::print(-123);    // Prints "-123"
-     * FastGraphics::print(42);      // Prints "42"
+     * // Restore the background behind a moving marker, then draw it at its new place
+     * FastGraphics::blitCompressed(old_x, old_y, background, old_x, old_y, 16, 16);
+     * FastGraphics::fillCircle(new_x + 8, new_y + 8, 7, COLOR_RED);
      * @endcode
      */
-    static void print(int number);
+    static void blitCompressed(int16_t x, int16_t y, const uint8_t* image,
+                               int16_t sx, int16_t sy, int16_t sw, int16_t sh);
+    
+    // =============================================================================
+    // ALPHA BLENDING
+    // =============================================================================
     
     /**
-     * @brief Print an unsigned integer
-     * @param number Unsigned integer value to print
+     * @brief Blend a color over a single pixel
+     * @details result = pixel + (color - pixel) * alpha per channel, using the packed
+     *          RGB565 multiply of FastKernels::blendPixel().
+     * 
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @param color RGB565 color drawn on top
+     * @param alpha Opacity (0 = invisible, 255 = opaque)
+     * 
+     * @note Alpha is reduced to 33 levels for the packed multiply
      */
-    static void print(unsigned int number);
+    static void blendPixel(int16_t x, int16_t y, uint16_t color, uint8_t alpha);
+    
+    /**
+     * @brief Draw a translucent filled rectangle
+     * @details Blends color over the rectangle in one pass over the framebuffer, for
+     *          overlays, highlights and glass panels. Clipped and rotated once like
+     *          fillRect(); every buffer row is one FastKernels::blend16() run that
+     *          reads and writes two pixels per 32-bit access.
+     * 
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param w Width in pixels
+     * @param h Height in pixels
+     * @param color RGB565 color drawn on top
+     * @param alpha Opacity (0 = invisible, 255 = same as fillRect())
+     * 
+     * @example
+     * @code
+     * FastGraphics::fillRectAlpha(0, 440, 800, 40, COLOR_BLACK, 160);  // Caption bar
+     * FastGraphics::text(10, 452, "Live view", COLOR_WHITE, COLOR_WHITE);
+     * @endcode
+     */
+    static void fillRectAlpha(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, uint8_t alpha);
+    
+    /**
+     * @brief Darken a rectangle by a power of two
+     * @details The fast coarse variant of fillRectAlpha(x, y, w, h, COLOR_BLACK, ...):
+     *          each channel is shifted right by level, two pixels per 32-bit shift and
+     *          mask, without multiplies. Meant for dimming the background of a modal
+     *          dialog in one pass instead of redrawing the scene darker.
+     * 
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param w Width in pixels
+     * @param h Height in pixels
+     * @param level 1 = half brightness, 2 = quarter, 3 = eighth (6 or more: black)
+     * 
+     * @example
+     * @code
+     * FastGraphics::dimRect(0, 0, FastGraphics::getWidth(), FastGraphics::getHeight());
+     * FastGraphics::fillRect(200, 140, 400, 200, COLOR_GRAY);        // Dialog on top
+     * @endcode
+     */
+    static void dimRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t level = 1);
+    
+    /**
+     * @brief Draw an RGB565 image with constant opacity
+     * @details Like drawImage(), but every pixel is blended over the framebuffer. In
+     *          ROTATION_0 each row is one FastKernels::blendCopy16() run.
+     * 
+     * @param alpha Opacity of the image (255 = same as drawImage())
+     * 
+     * @example
+     * @code
+     * FastGraphics::drawImageAlpha(10, 10, logo, 64, 32, fade);   // Fade in over frames
+     * @endcode
+     */
+    static void drawImageAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h, uint8_t alpha);
+    
+    /**
+     * @brief Draw an RGB565 image with constant opacity and a transparent color key
+     * @param transparent RGB565 value that is not drawn
+     */
+    static void drawImageAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t w, int16_t h, uint8_t alpha,
+                               uint16_t transparent);
+    
+    /**
+     * @brief Draw part of an RGB565 image with constant opacity
+     * @details The translucent version of blit(), e.g. a ghosted sprite frame.
+     * 
+     * @param alpha Opacity of the image (255 = same as blit())
+     */
+    static void blitAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                          int16_t sx, int16_t sy, int16_t sw, int16_t sh, uint8_t alpha);
+    
+    /**
+     * @brief Draw part of an RGB565 image with constant opacity and a transparent color key
+     * @param transparent RGB565 value that is not drawn
+     */
+    static void blitAlpha(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                          int16_t sx, int16_t sy, int16_t sw, int16_t sh, uint8_t alpha, uint16_t transparent);
+    
+    /**
+     * @brief Draw a color through an 8-bit coverage mask
+     * @details Every mask byte is the opacity of color at that pixel (w bytes per row,
+     *          top row first): 0 leaves the pixel, 255 stores color, values between
+     *          blend. Anti-aliased icons and glyphs rendered offline need one byte per
+     *          pixel instead of two and can be drawn in any color.
+     * 
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param mask Coverage values
+     * @param w Mask width in pixels
+     * @param h Mask height in pixels
+     * @param color RGB565 color
+     * 
+     * @example
+     * @code
+     * extern const uint8_t icon_bell[24 * 24];
+     * FastGraphics::drawMask(10, 10, icon_bell, 24, 24, COLOR_YELLOW);
+     * @endcode
+     */
+    static void drawMask(int16_t x, int16_t y, const uint8_t* mask, int16_t w, int16_t h, uint16_t color);
+    
+    // =============================================================================
+    // BASIC TEXT FUNCTIONS
+    // =============================================================================
+    
+    /**
+     * @brief Draw text at specified position
+     * @details Renders text using the built-in 8x8 pixel font with optional scaling.
+     *          Supports basic ASCII characters (0-127). Text can have background color.
+     * 
+     * @param x Left edge X coordinate for text
+     * @param y Top edge Y coordinate for text
+     * @param str Null-terminated string to draw
+     * @param color RGB565 text color
+     * @param bg RGB565 background color (default: COLOR_BLACK)
+     * @param size Text scaling factor 1-10 (default: 1)
+     * 
+     * @note Each character is 8x8 pixels at size=1
+     * @note Size 2 = 16x16 pixels per character, etc.
+     * @note Newline characters (\n) move to next line
+     * @note Characters outside ASCII 0-127 range are ignored
+     * 
+     * @example
+     * @code
+     * FastGraphics::text(10, 10, "Hello", COLOR_WHITE);                    // Basic text
+     * FastGraphics::text(10, 30, "Large", COLOR_RED, COLOR_BLUE, 2);      // 2x size with blue background
+     * FastGraphics::text(10, 70, "Line1\nLine2", COLOR_GREEN);            // Multi-line text
+     * @endcode
+     */
+    static void text(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg = COLOR_BLACK, uint8_t size = 1);
+    
+    /**
+     * @brief Draw small text (size 1)
+     * @details Convenience function for drawing text at size 1 with black background.
+     * 
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param str Text string to draw
+     * @param color RGB565 text color
+     * 
+     * @see text() for full parameter control
+     */
+    static void textSmall(int16_t x, int16_t y, const char* str, uint16_t color);
+    
+    /**
+     * @brief Draw medium text (size 2)
+     * @details Convenience function for drawing text at size 2 with black background.
+     * 
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param str Text string to draw
+     * @param color RGB565 text color
+     * 
+     * @see text() for full parameter control
+     */
+    static void textMedium(int16_t x, int16_t y, const char* str, uint16_t color);
+    
+    /**
+     * @brief Draw large text (size 3)
+     * @details Convenience function for drawing text at size 3 with black background.
+     * 
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param str Text string to draw
+     * @param color RGB565 text color
+     * 
+     * @see text() for full parameter control
+     */
+    static void textLarge(int16_t x, int16_t y, const char* str, uint16_t color);
+    
+    // =============================================================================
+    // ADVANCED TEXT CURSOR FUNCTIONS
+    // =============================================================================
+    
+    /**
+     * @brief Set the text cursor position
+     * @details Sets the position where the next print() or println() operation will begin.
+     *          The cursor automatically advances as text is printed.
+     * 
+     * @param x X coordinate for cursor
+     * @param y Y coordinate for cursor
+     * 
+     * @note Cursor position is in pixels, not character cells
+     * @note Used by all print() and println() functions
+     * 
+     * @example
+     * @code
+     * FastGraphics::setCursor(100, 50);
+     * FastGraphics::print("Text starts here");
+     * @endcode
+     */
+    static void setCursor(int16_t x, int16_t y);
+    
+    /**
+     * @brief Set text color and optional background color
+     * @details Sets the colors used by print() and println() functions.
+     *          Background color is used to fill behind each character.
+     * 
+     * @param color RGB565 text foreground color
+     * @param bg RGB565 text background color (default: COLOR_BLACK)
+     * 
+     * @note Setting bg = color creates invisible text (useful for spacing)
+     * @note Color settings persist until changed
+     * 
+     * @example
+     * @code
+     * FastGraphics::setTextColor(COLOR_WHITE);                    // White text, black background
+     * FastGraphics::setTextColor(COLOR_RED, COLOR_YELLOW);        // Red text on yellow background
+     * @endcode
+     */
+    static void setTextColor(uint16_t color, uint16_t bg = COLOR_BLACK);
+    
+    /**
+     * @brief Set text scaling size
+     * @details Sets the text scaling factor for print() and println() functions.
+     *          Size 1 = 8x8 pixels per character, size 2 = 16x16, etc.
+     * 
+     * @param size Text scaling factor (1-10, default: 1)
+     * 
+     * @note Values outside 1-10 range are ignored
+     * @note Larger sizes consume more memory and drawing time
+     * 
+     * @example
+     * @code
+     * FastGraphics::setTextSize(1);    // Small text
+     * FastGraphics::setTextSize(3);    // Large text (24x24 pixels per char)
+     * @endcode
+     */
+    static void setTextSize(uint8_t size);
+    
+    /**
+     * @brief Enable or disable automatic text wrapping
+     * @details Controls whether text automatically wraps to the next line when reaching
+     *          the right edge of the text area.
+     * 
+     * @param wrap true to enable wrapping, false to disable
+     * 
+     * @note When disabled, text extends beyond screen boundaries
+     * @note Wrapping uses the current text area boundaries
+     * @note Default: enabled (true)
+     * 
+     * @example
+     * @code
+     * FastGraphics::setTextWrap(true);     // Enable automatic wrapping
+     * FastGraphics::setTextWrap(false);    // Disable wrapping (text may go off-screen)
+     * @endcode
+     */
+    static void setTextWrap(bool wrap);
+    
+    /**
+     * @brief Set additional spacing between text lines
+     * @details Sets extra pixels added between lines when text wraps or when using
+     *          println(). Improves readability for dense text.
+     * 
+     * @param spacing Additional pixels between lines (0-20, default: 2)
+     * 
+     * @note Values outside 0-20 range are ignored
+     * @note This is in addition to the character height
+     * @note Line height = (text_size * 8) + line_spacing, or the font's yAdvance + line_spacing
+     * 
+     * @example
+     * @code
+     * FastGraphics::setLineSpacing(0);     // Tight line spacing
+     * FastGraphics::setLineSpacing(4);     // More readable spacing
+     * FastGraphics::setLineSpacing(10);    // Very loose spacing
+     * @endcode
+     */
+    static void setLineSpacing(int16_t spacing);
+    
+    /**
+     * @brief Get current line spacing setting
+     * @return Current line spacing in pixels
+     */
+    static int16_t getLineSpacing();
+    
+    /**
+     * @brief Get current cursor position
+     * @details Returns the current text cursor position by reference.
+     * 
+     * @param x Reference to store current X coordinate
+     * @param y Reference to store current Y coordinate
+     * 
+     * @example
+     * @code
+     * int16_t x, y;
+     * FastGraphics::getCursor(x, y);
+     * Serial.printf("Cursor at: %d, %d\n", x, y);
+     * @endcode
+     */
+    static void getCursor(int16_t& x, int16_t& y);
+    
+    /**
+     * @brief Get current cursor X coordinate
+     * @return Current cursor X position in pixels
+     */
+    static int16_t getCursorX();
+    
+    /**
+     * @brief Get current cursor Y coordinate
+     * @return Current cursor Y position in pixels
+     */
+    static int16_t getCursorY();
+    
+    // =============================================================================
+    // FONTS AND GLYPH CACHE
+    // =============================================================================
+    
+    /**
+     * @brief Use a proportional font for text() and print()
+     * @details Takes an Adafruit-GFX font table (fontconvert output, see FastFont.h) or
+     *          one of the same layout with 2, 4 or 8 bits of anti-aliased coverage per
+     *          pixel. Glyphs are looked up by index in O(1). Coordinates stay the
+     *          top-left corner of the line: the baseline is placed at the font's
+     *          highest ascent, found once here.
+     * 
+     * @param font Font table, nullptr to return to the built-in 8x8 font
+     * @param bpp Bits per pixel of the table: 1 (default), 2, 4 or 8
+     * 
+     * @note The font drives character width (xAdvance) and line height (yAdvance);
+     *       the size argument and setTextSize() apply to the 8x8 font only
+     * @note An opaque background fills each character's advance x line height box
+     * @note The table is not copied and must remain valid (const data in flash is fine)
+     * 
+     * @example
+     * @code
+     * #include "FreeSans12pt7b.h"
+     * FastGraphics::setFont(&FreeSans12pt7b);
+     * FastGraphics::text(20, 20, "Proportional", COLOR_WHITE, COLOR_WHITE);  // Transparent
+     * FastGraphics::setFont(&MySans16_aa4, 4);                               // 4-bit anti-aliased table
+     * @endcode
+     */
+    static void setFont(const GFXfont* font = nullptr, uint8_t bpp = 1);
+    
+    /**
+     * @brief Get the current font, nullptr for the built-in 8x8 font
+     */
+    static const GFXfont* getFont();
+    
+    /**
+     * @brief Draw scaled opaque 8x8 text from pre-rendered glyph tiles
+     * @details A glyph of size FG_GLYPH_CACHE_MIN_SIZE or more with an opaque background
+     *          is rasterised once per (character, size, colors) into an RGB565 tile
+     *          and copied from then on, one row copy per line instead of 2-4 rectangle
+     *          fills per font row. Least recently used tiles are replaced when the
+     *          pool is full. The pool is taken from internal SRAM, else PSRAM.
+     * 
+     * @param enable true to allocate the pool and use it, false to free it
+     * @param bytes Pool size (default: FG_GLYPH_CACHE_BYTES)
+     * @return false if the pool could not be allocated
+     * 
+     * @note Also used for deferred replay and by the render task
+     * @note Transparent text is not cached: it depends on the pixels behind it
+     * 
+     * @example
+     * @code
+     * FastGraphics::setGlyphCache(true);
+     * FastGraphics::text(300, 200, "88.8", COLOR_GREEN, COLOR_BLACK, 8);  // Rendered once
+     * @endcode
+     */
+    static bool setGlyphCache(bool enable, size_t bytes = FG_GLYPH_CACHE_BYTES);
+    
+    /**
+     * @brief Get the glyph cache, for its hit and miss counters
+     */
+    static const FastGlyphCache& getGlyphCache();
+    
+    // =============================================================================
+    // TEXT LAYOUT
+    // =============================================================================
+    
+    /**
+     * @brief Get the width of text in pixels
+     * @details Uses the current font (or the 8x8 font at size); for multi-line text
+     *          the widest line. Nothing is drawn.
+     * 
+     * @param str Text to measure
+     * @param size Text scaling factor of the 8x8 font (default: 1)
+     * @return Width in pixels
+     * 
+     * @example
+     * @code
+     * int16_t w = FastGraphics::textWidth("Settings", 2);
+     * FastGraphics::text((FastGraphics::getWidth() - w) / 2, 10, "Settings", COLOR_WHITE, COLOR_BLACK, 2);
+     * @endcode
+     */
+    static int16_t textWidth(const char* str, uint8_t size = 1);
+    
+    /**
+     * @brief Get the bounding box size of text, optionally wrapped
+     * @param str Text to measure
+     * @param w Receives the width of the widest line
+     * @param h Receives the height of all lines, including the current line spacing
+     * @param size Text scaling factor of the 8x8 font (default: 1)
+     * @param max_width Wrap width as for printWrapped(), 0 for no wrapping
+     */
+    static void measureText(const char* str, int16_t& w, int16_t& h, uint8_t size = 1, int16_t max_width = 0);
+    
+    /**
+     * @brief Lay out text with the current font and line spacing
+     * @details Shorthand for layout.update() with the current text settings. An
+     *          unchanged string keeps its cached line breaks.
+     * 
+     * @param layout Layout to update (keeps a pointer to str)
+     * @param str Text to lay out
+     * @param max_width Wrap width in pixels, 0 for no wrapping
+     * @param size Text scaling factor of the 8x8 font (default: 1)
+     * @return true if the line breaks were computed, false if the cached ones apply
+     */
+    static bool layoutText(TextLayout& layout, const char* str, int16_t max_width = 0, uint8_t size = 1);
+    
+    /**
+     * @brief Draw a laid out text block
+     * @details Renders line by line straight from the source string. The block is
+     *          the wrap width wide (the widest line without wrapping) and each line
+     *          is aligned inside it. With an opaque background the whole block is
+     *          painted, so drawing a new text over an old one of the same box
+     *          leaves nothing behind.
+     * 
+     * @param x Left edge of the block
+     * @param y Top edge of the block
+     * @param layout Layout from layoutText() or TextLayout::update()
+     * @param color RGB565 text color
+     * @param bg RGB565 background color (same as color: transparent)
+     * @param align Line alignment inside the block (default: ALIGN_LEFT)
+     * @return The block's box
+     * 
+     * @note Draws with the current font: the one the layout was made with
+     * 
+     * @example
+     * @code
+     * static TextLayout help;
+     * FastGraphics::layoutText(help, help_text, 360);       // Measured once
+     * FastGraphics::drawLayout(220, 120, help, COLOR_WHITE, COLOR_BLUE, ALIGN_CENTER);
+     * @endcode
+     */
+    static TextBox drawLayout(int16_t x, int16_t y, const TextLayout& layout, uint16_t color,
+                              uint16_t bg = COLOR_BLACK, TextAlign align = ALIGN_LEFT);
+    
+    /**
+     * @brief Draw text aligned to an anchor, clearing only what the old text left
+     * @details The text is measured first and placed so that x is its left edge,
+     *          center or right edge. With the box returned by the previous call,
+     *          only the part of the old box outside the new one is cleared, so a
+     *          right-aligned readout going from "100.0" to "99.5" repaints its new
+     *          bounds and one glyph cell of background.
+     * 
+     * @param x Anchor X: left edge (ALIGN_LEFT), center or right edge
+     * @param y Top edge Y coordinate
+     * @param str Text to draw, '\n' starts a new line aligned the same way
+     * @param align Alignment to the anchor
+     * @param color RGB565 text color
+     * @param bg RGB565 background color (opaque text only is cleared)
+     * @param size Text scaling factor of the 8x8 font (default: 1)
+     * @param previous Box returned for the old text, nullptr for none
+     * @return Box of the new text, to pass as previous next time
+     * 
+     * @example
+     * @code
+     * static TextBox speed_box = { 0, 0, 0, 0 };
+     * char buf[FG_FORMAT_BUFFER_SIZE];
+     * FastFormat::formatFixed(buf, speed, 1);
+     * speed_box = FastGraphics::drawAligned(780, 40, buf, ALIGN_RIGHT, COLOR_WHITE, COLOR_BLACK, 4, &speed_box);
+     * @endcode
+     */
+    static TextBox drawAligned(int16_t x, int16_t y, const char* str, TextAlign align, uint16_t color,
+                               uint16_t bg = COLOR_BLACK, uint8_t size = 1, const TextBox* previous = nullptr);
+    
+    // =============================================================================
+    // PRINT FUNCTIONS (Serial.print-like interface)
+    // =============================================================================
+    
+    /**
+     * @brief Print a C-style string
+     * @details Prints text at the current cursor position using current text settings.
+     *          Cursor automatically advances. Supports newline (\n) and carriage return (\r).
+     * 
+     * @param str Null-terminated string to print
+     * 
+     * @note Handles \n (newline) and \r (carriage return) characters
+     * @note Cursor advances automatically after each character
+     * @note Text wrapping applies if enabled
+     * 
+     * @example
+     * @code
+     * FastGraphics::print("Hello ");
+     * FastGraphics::print("World!");     // Results in "Hello World!"
+     * @endcode
+     */
+    static void print(const char* str);
+    
+    /**
+     * @brief Print a string of known length
+     * @details string_view-style overload: prints exactly length characters, so the
+     *          text does not need to be null-terminated (e.g. a slice of a buffer).
+     * 
+     * @param str Characters to print
+     * @param length Number of characters
+     * 
+     * @example
+     * @code
+     * const char* line = "TEMP=23.5;HUM=40";
+     * FastGraphics::print(line, 9);     // Prints "TEMP=23.5"
+     * @endcode
+     */
+    static void print(const char* str, size_t length);
+    
+    /**
+     * @brief Print an Arduino String
+     * @param str Arduino String object to print (not copied)
+     * @see print(const char*)
+     */
+    static void print(const String& str);
+    
+    /**
+     * @brief Print a signed integer
+     * @param number Integer value to print
+     * 
+     * @example
+     * @code
+     * FastGraphics::print(-123);    // Prints "-123"
+     * FastGraphics::print(42);      // Prints "42"
+     * @endcode
+     */
+    static void print(int number);
+    
+    /**
+     * @brief Print an unsigned integer
+     * @param number Unsigned integer value to print
+     */
+    static void print(unsigned int number);
     
     /**
      * @brief Print a long integer
@@ -545,7 +1352,7 @@ public:
      * @details Prints a float with specified decimal precision.
      * 
      * @param number Float value to print
-     * @param decimals Number of decimal places (default: 2)
+     * @param decimals Number of decimal places (default: 2, max: 9)
      * 
      * @example
      * @code
@@ -593,6 +1400,23 @@ public:
      */
     static void print(bool value);
     
+    /**
+     * @brief Print formatted text
+     * @details printf-style output straight into the glyph renderer at the cursor
+     *          position. No intermediate string, no heap allocation and no libc
+     *          printf; numbers are converted by FastFormat.
+     * 
+     * @param format Format string supporting %d %i %u %x %X %c %s %f %% with
+     *               flags '-', '0', '+', ' ', width, precision and l/ll/h modifiers
+     * @param ... Arguments matching the format
+     * 
+     * @example
+     * @code
+     * FastGraphics::printf("T=%5.1f C  RH=%3d%%\n", temperature, humidity);
+     * @endcode
+     */
+    static void printf(const char* format, ...) __attribute__((format(printf, 1, 2)));
+    
     // =============================================================================
     // PRINTLN FUNCTIONS (Print + newline)
     // =============================================================================
@@ -611,7 +1435,7 @@ public:
     static void println(const char* str = "");
     
     /** @brief Print Arduino String + newline */ 
-    static void println(String str);
+    static void println(const String& str);
     
     /** @brief Print integer + newline */
     static void println(int number);
@@ -664,31 +1488,121 @@ public:
      * FastGraphics::println("to the defined area");
      * @endcode
      */
-    static void setTextArea(int16_t x, int16_t y, int16_t w, int16_t h);
+    static void setTextArea(int16_t x, int16_t y, int16_t w, int16_t h);
+    
+    /**
+     * @brief Clear the current text area
+     * @details Fills the current text area with the background color and resets
+     *          the cursor to the top-left of the text area.
+     * 
+     * @note Uses current text background color for clearing
+     * @note Cursor is reset to text area origin
+     * 
+     * @example
+     * @code
+     * FastGraphics::setTextArea(50, 50, 200, 100);
+     * FastGraphics::println("Some text...");
+     * FastGraphics::clearTextArea();  // Clear and reset cursor
+     * FastGraphics::println("New text from top");
+     * @endcode
+     */
+    static void clearTextArea();
+    
+    /**
+     * @brief Enable or disable console-style scrolling of the text area
+     * @details When enabled, printing past the bottom of the text area moves the
+     *          existing text up by one line and clears only the newly exposed line.
+     *          When disabled, the text area is cleared and printing restarts at the top.
+     * 
+     * @param scroll true to scroll, false to clear-and-restart (default: false)
+     * 
+     * @example
+     * @code
+     * FastGraphics::setTextArea(0, 240, 800, 240);    // Bottom half as log console
+     * FastGraphics::setTextScroll(true);
+     * FastGraphics::setCursor(0, 240);
+     * for (int i = 0; i < 1000; i++) FastGraphics::println(i);
+     * @endcode
+     */
+    static void setTextScroll(bool scroll);
+    
+    /**
+     * @brief Get the text area scrolling mode
+     * @return true if the text area scrolls, false if it clears on overflow
+     */
+    static bool getTextScroll();
+    
+    /**
+     * @brief Scroll the content of a rectangle upwards
+     * @details Moves the pixels inside the rectangle up by dy (in logical coordinates)
+     *          and fills the dy rows exposed at the bottom with a solid color.
+     *          Pixels outside the rectangle are not touched.
+     * 
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param w Width in pixels
+     * @param h Height in pixels
+     * @param dy Number of pixel rows to scroll up by
+     * @param color RGB565 color for the exposed rows
+     * 
+     * @note Works in all rotations by moving physical rows or in-row spans with memmove
+     * @note dy >= h just fills the rectangle
+     */
+    static void scrollRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dy, uint16_t color);
     
     /**
-     * @brief Clear the current text area
-     * @details Fills the current text area with the background color and resets
-     *          the cursor to the top-left of the text area.
-     * 
-     * @note Uses current text background color for clearing
-     * @note Cursor is reset to text area origin
+     * @brief Turn a band of full-width rows into a circular scroll viewport
+     * @details scrollRect() moves every pixel of the area through PSRAM. In viewport
+     *          mode the framebuffer rows of the band are a ring with a moving start
+     *          row instead: scrollViewport() only advances the start and clears the
+     *          rows that scroll in. Every primitive is drawn through the ring (split
+     *          where a shape crosses the wrap), and flush() copies it to the panel in
+     *          display order, so scrolling costs the cleared rows plus the flush copy
+     *          of the band that any scroll needs anyway.
+     * 
+     * @param y Top edge of the viewport (logical)
+     * @param h Height in rows, 0 to end viewport mode
+     * @return false in ROTATION_90/270 (rows are not full-width there), in deferred,
+     *         double-buffer, render task or rotate-on-flush mode, without a
+     *         framebuffer, or if the band is not on the screen
+     * 
+     * @note Ending the mode, or changing the rotation (which ends it), puts the rows
+     *       back in display order; begin() drops it
+     * @note While it is on, frame_buffer holds the band in ring order. scrollRect()
+     *       (also text area scrolling) follows the ring, and scrolling exactly the
+     *       band unclipped is the same as scrollViewport()
      * 
      * @example
      * @code
-     * FastGraphics::setTextArea(50, 50, 200, 100);
-     * FastGraphics::println("Some text...");
-     * FastGraphics::clearTextArea();  // Clear and reset cursor
-     * FastGraphics::println("New text from top");
+     * FastGraphics::setScrollViewport(100, 300);        // Rows 100-399 scroll
+     * FastGraphics::scrollViewport(2, COLOR_BLACK);     // Clears 2 rows, moves none
+     * FastGraphics::text(0, 392, line, COLOR_GREEN, COLOR_BLACK);
+     * FastGraphics::flush();
      * @endcode
      */
-    static void clearTextArea();
+    static bool setScrollViewport(int16_t y, int16_t h);
+    
+    /**
+     * @brief Scroll the viewport content up
+     * @param lines Rows to scroll up by (negative: down), the band clamps it
+     * @param color RGB565 color of the rows scrolled in at the bottom (top)
+     * @note Does nothing without a viewport
+     */
+    static void scrollViewport(int16_t lines, uint16_t color);
+    
+    /**
+     * @brief Get the scroll viewport band
+     * @param y Receives the top edge (logical)
+     * @param h Receives the height in rows, 0 without a viewport
+     * @return true if a viewport is on
+     */
+    static bool getScrollViewport(int16_t& y, int16_t& h);
     
     /**
      * @brief Print text with automatic word wrapping
-     * @details Renders text within a specified width with intelligent word wrapping.
-     *          Words are kept intact and wrapped at word boundaries when possible.
-     *          Includes improved line spacing for better readability.
+     * @details Renders text within a specified width, wrapping at word boundaries.
+     *          Each line is found with TextLayout::nextLine() and drawn straight from
+     *          the string, so there is no limit on the length of the text or a word.
      * 
      * @param x Left edge X coordinate
      * @param y Top edge Y coordinate  
@@ -697,10 +1611,10 @@ public:
      * @param color RGB565 text color
      * @param size Text scaling factor (default: 1)
      * 
-     * @note Respects word boundaries - won't break words in middle
+     * @note Words wider than maxWidth on their own are broken between characters
      * @note Handles spaces, newlines, and tabs appropriately
      * @note Uses current line spacing setting for vertical spacing
-     * @note More intelligent than basic text wrapping
+     * @note Uses the current font if one is set (size applies to the 8x8 font)
      * 
      * @example
      * @code
@@ -757,15 +1671,363 @@ public:
      */
     static void demo();
     
+    // =============================================================================
+    // DIRTY REGION TRACKING & FLUSH
+    // =============================================================================
+    
+    /**
+     * @brief Mark a logical rectangle as changed
+     * @details Every drawing function marks what it touches automatically. Call this
+     *          only after writing to the framebuffer directly, bypassing the library.
+     * 
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param w Width in pixels
+     * @param h Height in pixels
+     * 
+     * @note Coordinates are logical (affected by rotation) and clipped to the screen
+     * @note Overlapping or touching rectangles are merged into their bounding box
+     */
+    static void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+    
+    /**
+     * @brief Mark the whole screen as changed
+     * @details The next flush() will send the complete framebuffer.
+     */
+    static void markAllDirty();
+    
+    /**
+     * @brief Check whether anything was drawn since the last flush()
+     * @return true if at least one dirty rectangle is pending
+     */
+    static bool isDirty();
+    
+    /**
+     * @brief Send only the changed regions of the framebuffer to the panel
+     * @details Pushes each pending dirty rectangle with esp_lcd_panel_draw_bitmap()
+     *          and clears the dirty list. Wide rectangles are sent as one full-width
+     *          band (contiguous in the framebuffer), narrow ones row by row.
+     * 
+     * @note Does nothing but forget the dirty list when begin() got no panel handle
+     * @note Small updates (a touch dot, one number) cost a few KB instead of 768 KB
+     * @note In double-buffer mode this is the same as present()
+     * 
+     * @example
+     * @code
+     * FastGraphics::fillCircle(touch_last_x, touch_last_y, 5, COLOR_WHITE);
+     * FastGraphics::flush();    // Sends an 11x11 area, not the whole screen
+     * @endcode
+     */
+    static void flush();
+    
+    /**
+     * @brief Finish the current frame and make it visible
+     * @details Marks a frame boundary. In single-buffer mode this is the same as flush().
+     *          In double-buffer mode the back buffer becomes the front buffer at the next
+     *          VSYNC, then the regions changed this frame are copied into the new back
+     *          buffer so drawing continues on an up-to-date frame.
+     * 
+     * @note Double-buffer mode blocks until the swap takes effect: up to one frame, or
+     *       two when a VSYNC lands while the buffer is being handed over
+     * @note Frames without any drawing are not swapped
+     */
+    static void present();
+    
+    // =============================================================================
+    // DEFERRED RENDERING
+    // =============================================================================
+    
+    /**
+     * @brief Initialize the library in deferred (display-list) mode
+     * @details Drawing functions record compact DrawCommands instead of writing pixels.
+     *          With a framebuffer, flush() replays the list one FG_BAND_LINES-row band
+     *          at a time in an internal-SRAM buffer: each band touched by the list is
+     *          read from PSRAM in one sequential burst, every command is clipped to the
+     *          band, and the band is written back in one burst before the changed
+     *          regions go to the panel.
+     * 
+     *          Without a framebuffer (LCD_FB_NONE scanout) the list recorded between two
+     *          flush() calls is the whole frame: flush() hands it to renderBand(), which
+     *          the panel's bounce-buffer callback calls to render each band on the fly.
+     * 
+     * @param framebuffer PSRAM framebuffer, or nullptr for framebuffer-less rendering
+     * @param panel Panel handle used by flush() (default: nullptr)
+     * @return false if the command list or band buffer could not be allocated
+     * 
+     * @note Memory: FG_MAX_COMMANDS * 24 bytes (x2 without framebuffer), plus
+     *       LCD_H_RES * FG_BAND_LINES * 2 bytes of band buffer with a framebuffer
+     * @note A full-screen fillRect()/clear() discards everything recorded before it
+     * @note Without a framebuffer scrollRect() has nothing to scroll and does nothing
+     * @note Images and bitmaps are recorded by pointer: their pixels must stay valid
+     *       and unchanged until the frame is replaced (flash images always are)
+     * 
+     * @example
+     * @code
+     * // Framebuffer-less UI: LCD_FB_MODE = LCD_FB_NONE in display_config.h
+     * static void band(uint16_t* buf, int y, int lines, void* ctx) {
+     *     FastGraphics::renderBand(buf, y, lines, ctx);
+     * }
+     * lcd_set_band_renderer(band, nullptr);
+     * initialize_display_and_framebuffer();
+     * FastGraphics::beginDeferred(nullptr, panel_handle);
+     * 
+     * FastGraphics::clear(COLOR_BLACK);
+     * FastGraphics::text(10, 10, "No framebuffer", COLOR_WHITE);
+     * FastGraphics::flush();            // Shown from the next refresh on
+     * @endcode
+     */
+    static bool beginDeferred(uint16_t* framebuffer, esp_lcd_panel_handle_t panel = nullptr);
+    
+    /**
+     * @brief Initialize the library on a palettised framebuffer
+     * @details Deferred rendering into a buffer of 8, 4 or 1-bit palette indices:
+     *          2, 4 or 16 times less memory and PSRAM write traffic than RGB565.
+     *          Every drawing function works unchanged. flush() expands each band the
+     *          list touches into the internal-SRAM band buffer, replays the commands
+     *          there in RGB565 and stores the band back as the nearest palette
+     *          indices (FastPalette). The changed rectangles are then expanded
+     *          through the palette into the band buffer and sent to the panel.
+     * 
+     *          With LCD_FB_NONE scanout there is no panel framebuffer at all: pass
+     *          no panel, and renderBand() (the bounce-buffer callback) expands the
+     *          index buffer on the fly.
+     * 
+     * @param framebuffer Index buffer, FastPalette::bufferBytes(format, LCD_H_RES,
+     *                    LCD_V_RES) bytes (index_buffer from display_config with
+     *                    LCD_FB_BITS set)
+     * @param format PIXEL_INDEX8, PIXEL_INDEX4 or PIXEL_INDEX1
+     * @param palette Colors of the indices; must outlive indexed mode, changes show
+     *                from the next flush of each area
+     * @param panel Panel handle used by flush() (nullptr with LCD_FB_NONE)
+     * @return false for another format, a missing buffer or palette, a panel width
+     *         that is not a multiple of 8, or if the command list or band buffer
+     *         could not be allocated
+     * 
+     * @note Colors outside the palette are stored as the nearest palette color;
+     *       anti-aliased edges and blends need palette entries between the colors
+     *       they mix to look smooth
+     * @note Memory as beginDeferred() with a framebuffer, plus the index buffer
+     * 
+     * @example
+     * @code
+     * // display_config.h: #define LCD_FB_BITS 4 (allocates index_buffer, 192 KB)
+     * static const uint16_t colors[16] = { COLOR_BLACK, COLOR_WHITE, COLOR_RED, COLOR_GREEN, ... };
+     * static FastPalette palette;
+     * palette.setColors(colors, 16);
+     * FastGraphics::beginIndexed(index_buffer, PIXEL_INDEX4, &palette, panel_handle);
+     * 
+     * FastGraphics::clear(COLOR_BLACK);
+     * FastGraphics::text(10, 10, "16 colors", COLOR_WHITE, COLOR_BLACK, 2);
+     * FastGraphics::flush();            // Replays, packs, expands the dirty area
+     * @endcode
+     */
+    static bool beginIndexed(uint8_t* framebuffer, PixelFormat format, const FastPalette* palette,
+                             esp_lcd_panel_handle_t panel = nullptr);
+    
+    /**
+     * @brief Get the framebuffer pixel format
+     * @return The format of beginIndexed(), PIXEL_RGB565 otherwise
+     */
+    static PixelFormat getPixelFormat();
+    
+    /**
+     * @brief Render rows of the current frame into a band buffer
+     * @details Fills the band with black, then replays every command of the frame
+     *          last published by flush() that touches rows [y, y + lines). In
+     *          indexed mode it expands the rows of the index buffer instead.
+     * 
+     * @param band Destination, lines * LCD_H_RES pixels
+     * @param y First physical row of the band
+     * @param lines Number of physical rows
+     * @param user_ctx Unused (matches the lcd_band_renderer_t callback signature)
+     * 
+     * @note Runs in the LCD interrupt when used as bounce-buffer callback; keep the
+     *       command count per band modest
+     * @note Draws with FastKernels in scalar mode (see FastKernels::beginScalar()),
+     *       since the interrupt does not save the PIE registers
+     * @note Only meaningful after beginDeferred(nullptr, ...) or beginIndexed()
+     */
+    static void renderBand(uint16_t* band, int y, int lines, void* user_ctx = nullptr);
+    
+    /**
+     * @brief Get the number of commands recorded since the last flush()
+     * @return Pending command count (always 0 outside deferred mode)
+     */
+    static uint16_t getCommandCount();
+    
+    /**
+     * @brief Get the number of commands dropped because the list was full
+     * @details Only framebuffer-less mode drops commands; with a framebuffer a full
+     *          list is replayed early instead. Reset by beginDeferred().
+     */
+    static uint32_t getDroppedCommands();
+    
+    // =============================================================================
+    // RENDER TASK
+    // =============================================================================
+    
+    /**
+     * @brief Move drawing onto its own FreeRTOS task
+     * @details From then on drawing functions only push compact commands into a
+     *          lock-free single-producer/single-consumer ring (FG_QUEUE_COMMANDS
+     *          entries in internal SRAM) and return; a task pinned to the other core
+     *          pops them, draws into the framebuffer and tracks dirty regions.
+     *          flush()/present() push an end-of-frame marker: the render task flushes
+     *          (or swaps, in double-buffer mode) when it reaches it, so the panel is
+     *          only ever handed complete frames.
+     * 
+     * @param core Core to pin the task to (default: -1, the core not running the caller)
+     * @param priority FreeRTOS task priority
+     * @return false in deferred mode, without a framebuffer, or if allocation failed
+     * 
+     * @note Call after begin()/beginDoubleBuffered(); begin() stops the task again
+     * @note One task draws: text state (cursor, colors, text area) is the producer's
+     * @note A full queue makes the producer wait for the render task (counted by
+     *       getQueueStalls()), it never waits for PSRAM itself
+     * @note Image and bitmap pixels must stay valid until the frame is drawn
+     * @note setRotation(), drawBitmap4() and direct frame_buffer access need the
+     *       render task idle and wait for it (see waitRenderIdle())
+     * @note Tear-free presentation needs double-buffer mode; with a single buffer the
+     *       render task draws into the buffer being scanned out
+     * 
+     * @example
+     * @code
+     * FastGraphics::beginDoubleBuffered(panel_handle);
+     * FastGraphics::beginRenderTask();          // Draws on core 0, loop() runs on core 1
+     * 
+     * void loop() {
+     *     FastGraphics::clear(COLOR_BLACK);      // Queued
+     *     FastGraphics::printf("%d rpm", rpm);  // Queued
+     *     FastGraphics::present();              // Frame marker, returns at once
+     *     readSensors();                        // Overlaps with drawing
+     * }
+     * @endcode
+     */
+    static bool beginRenderTask(int core = -1, unsigned priority = 2);
+    
+    /**
+     * @brief Draw everything queued, then end the render task
+     * @details Drawing returns to the calling task afterwards.
+     */
+    static void stopRenderTask();
+    
+    /**
+     * @brief Block until the render task has drawn everything queued so far
+     * @details Afterwards the framebuffer can be read or written directly until the
+     *          next drawing call. Pending dirty regions are still shown by the next
+     *          flush()/present().
+     * @note Returns immediately without a render task
+     */
+    static void waitRenderIdle();
+    
+    /**
+     * @brief Check whether a render task is running
+     */
+    static bool isRenderTaskRunning();
+    
+    /**
+     * @brief Get how often a producer found the queue full and had to wait
+     * @details A steadily growing count means FG_QUEUE_COMMANDS is too small or the
+     *          render task cannot keep up. Reset by beginRenderTask().
+     */
+    static uint32_t getQueueStalls();
+    
+    // =============================================================================
+    // ASYNC DMA
+    // =============================================================================
+    
+    /**
+     * @brief Offload large fills and copies to the GDMA
+     * @details In async mode fillRect()/clear() of at least FG_DMA_MIN_PIXELS pixels,
+     *          large unkeyed image copies in ROTATION_0 and the double-buffer catch-up
+     *          copy are queued to FastDMA (esp_async_memcpy) and return immediately.
+     *          Transfers complete in order, so consecutive DMA operations never wait.
+     *          Every CPU drawing path first waits for queued transfers overlapping
+     *          the rows it touches, and flush()/present() wait for all of them, so
+     *          drawing results are the same as in synchronous mode.
+     * 
+     * @param enable true to enable, false to wait for pending transfers and disable
+     * @return false if the DMA driver could not be installed (mode stays off)
+     * 
+     * @note Applies to immediate drawing; deferred replay runs in SRAM bands on the CPU
+     * @note Code writing frame_buffer directly must call waitIdle() first
+     * @note Survives begin(), which waits for pending transfers before switching buffers
+     * 
+     * @example
+     * @code
+     * FastGraphics::setAsync(true);
+     * FastGraphics::clear(COLOR_BLUE);    // Queued, returns in microseconds
+     * updateSensorFusion();               // Runs while the DMA clears
+     * FastGraphics::text(10, 10, "Ready", COLOR_WHITE);  // Waits only for its rows
+     * FastGraphics::flush();
+     * @endcode
+     */
+    static bool setAsync(bool enable);
+    
+    /**
+     * @brief Check whether async DMA mode is enabled
+     */
+    static bool getAsync();
+    
+    /**
+     * @brief Wait until all queued DMA transfers completed
+     * @note Needed only before accessing frame_buffer directly
+     */
+    static void waitIdle();
+    
+    // =============================================================================
+    // PROFILING
+    // =============================================================================
+    
+    /**
+     * @brief Get the statistics of the last completed frame
+     * @details Each flush()/present() closes a frame: the counters collected since the
+     *          previous one are published here and start again from zero. Cycles are
+     *          read with esp_cpu_get_cycle_count(), frame time with esp_timer_get_time().
+     * 
+     * @return Statistics of the last frame (all zero unless built with FG_PROFILE=1)
+     * 
+     * @note Enable with build_flags = -DFG_PROFILE=1; the default build has no overhead
+     * @note Cycle counts are per core and wrap after ~17 s at 240 MHz, far beyond a frame
+     * 
+     * @example
+     * @code
+     * const FrameStats& stats = FastGraphics::getFrameStats();
+     * Serial.printf("%lu us/frame, %lu fillRect px\n", stats.frame_us,
+     *               stats.primitives[PROFILE_FILL_RECT].pixels);
+     * @endcode
+     */
+    static const FrameStats& getFrameStats();
+    
+    /**
+     * @brief Draw a two-line FPS / frame time overlay
+     * @details Shows fps and frame time, then draw and flush time in milliseconds of the
+     *          last completed frame, in the 8x8 font with an opaque background.
+     * 
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param color RGB565 text color
+     * @param bg RGB565 background color
+     * 
+     * @note The overlay's own drawing is counted in the frame it is drawn in
+     * @note Does nothing unless built with FG_PROFILE=1
+     */
+    static void drawStatsOverlay(int16_t x, int16_t y, uint16_t color = COLOR_WHITE, uint16_t bg = COLOR_BLACK);
+    
 private:
     // =============================================================================
     // PRIVATE MEMBERS
     // =============================================================================
     
     static uint16_t* frame_buffer;          /**< Pointer to RGB565 framebuffer */
-    static ScreenRotation current_rotation; /**< Current screen rotation */
-    static int16_t display_width;           /**< Current logical display width */
-    static int16_t display_height;          /**< Current logical display height */
+    static FastCanvas screen;               /**< Drawing surface over frame_buffer, holds the rotation */
+    static uint16_t* shadow_buffer;         /**< Logical-orientation pixels (setRotateOnFlush()) */
+    static bool rotate_on_flush;            /**< Rotated screens draw into shadow_buffer */
+    static ScreenRotation shadow_rotation;  /**< Rotation applied on flush, ROTATION_0: no shadow */
+    static int16_t viewport_y;              /**< Scroll viewport top, logical (setScrollViewport()) */
+    static int16_t viewport_top;            /**< Scroll viewport first framebuffer row */
+    static int16_t viewport_rows;           /**< Scroll viewport height, 0: no viewport */
+    static int16_t viewport_offset;         /**< Ring row holding the viewport's first screen row */
     
     // Text cursor and settings
     static int16_t cursor_x, cursor_y;                      /**< Current text cursor position */
@@ -774,34 +2036,303 @@ private:
     static bool text_wrap;                                  /**< Text wrapping enabled flag */
     static int16_t text_area_x, text_area_y, text_area_w, text_area_h; /**< Text area boundaries */
     static int16_t line_spacing;                            /**< Additional spacing between lines */
+    static bool text_scroll;                                /**< Scroll text area on overflow instead of clearing */
+    static const GFXfont* font;                             /**< Proportional font, nullptr for the 8x8 font */
+    static uint8_t font_bpp;                                /**< Bits per pixel of the font table */
+    static int16_t font_ascent;                             /**< Line top to baseline */
+    static FastGlyphCache glyph_cache;                      /**< Scaled glyph tiles (setGlyphCache()) */
+    
+    /**
+     * @struct DirtyRect
+     * @brief Changed area of the screen canvas buffer (end-exclusive)
+     * @details Physical coordinates, or shadow coordinates while shadow_rotation
+     *          is set, until flush() rotates them into the framebuffer.
+     */
+    struct DirtyRect {
+        int16_t x0, y0, x1, y1;
+    };
+    
+    /**
+     * @struct ClipRect
+     * @brief Clip stack entry in logical coordinates
+     */
+    struct ClipRect {
+        int16_t x, y, w, h;
+    };
+    
+    /**
+     * @struct ViewportPart
+     * @brief Screen rows stored contiguously in the framebuffer while a viewport is on
+     */
+    struct ViewportPart {
+        uint16_t* rows;         /**< Storage of row0 */
+        int16_t row0, row1;     /**< Physical screen rows, end-exclusive */
+    };
+    
+    /**
+     * @struct QueuedCommand
+     * @brief Render task queue entry: a command and the physical box it dirties
+     */
+    struct QueuedCommand {
+        DrawCommand cmd;
+        DirtyRect box;
+    };
+    
+    // Dirty region tracking
+    static esp_lcd_panel_handle_t panel;                    /**< Panel used by flush() */
+    static uint16_t* front_buffer;                          /**< Scanned-out buffer in double-buffer mode */
+    static bool double_buffered;                            /**< Drawing goes to a driver-owned back buffer */
+    static DirtyRect dirty_rects[FG_MAX_DIRTY_RECTS];       /**< Pending changed areas */
+    static uint8_t dirty_count;                             /**< Number of pending dirty rectangles */
+    
+    // Deferred rendering
+    static bool deferred;                                   /**< Drawing functions record commands */
+    static DrawCommand* commands;                           /**< List being recorded */
+    static uint16_t command_count;                          /**< Commands in the recorded list */
+    static DrawCommand* command_lists[2];                   /**< Framebuffer-less mode: recording / shown */
+    static uint16_t* band_buffer;                           /**< Internal SRAM band (framebuffer mode) */
+    static uint8_t* indexed_buffer;                         /**< Palettised framebuffer (beginIndexed()) */
+    static PixelFormat pixel_format;                        /**< Format of indexed_buffer, PIXEL_RGB565 without */
+    static const FastPalette* index_palette;                /**< Colors of indexed_buffer */
+    static uint32_t dropped_commands;                       /**< Commands lost to a full list */
+    static bool async_mode;                                 /**< Large writes go to FastDMA */
+    
+    // Render task
+    static bool recording;                                  /**< Drawing calls record() instead of drawing */
+    static TaskHandle_t render_task;                        /**< Consumer task, nullptr when not running */
+    static QueuedCommand* queue;                            /**< Command ring, FG_QUEUE_COMMANDS entries */
+    static uint32_t queue_head;                             /**< Next entry to write (producer) */
+    static uint32_t queue_tail;                             /**< Next entry to read (render task) */
+    static bool queue_waiting;                              /**< Producer waits for free entries */
+    static uint32_t queue_stalls;                           /**< Times the producer found the ring full */
+    
+    // Clipping
+    static ClipRect clip_stack[FG_CLIP_DEPTH];              /**< Pushed clips, each inside the one below */
+    static uint8_t clip_depth;                              /**< Number of pushed clips (0: whole screen) */
     
     // =============================================================================
     // PRIVATE HELPER FUNCTIONS
     // =============================================================================
     
     /**
-     * @brief Transform logical coordinates to physical framebuffer coordinates
-     * @details Applies the current rotation transformation to convert logical screen
-     *          coordinates to physical framebuffer coordinates.
-     * 
-     * @param x Reference to X coordinate (modified in-place)
-     * @param y Reference to Y coordinate (modified in-place)
+     * @brief Clip a logical rectangle and map it to physical coordinates
+     * @param r Receives the physical rectangle (end-exclusive)
+     * @return false if the rectangle is entirely off screen
+     */
+    static bool physicalBounds(int16_t x, int16_t y, int16_t w, int16_t h, DirtyRect& r);
+    
+    /**
+     * @brief Intersect a logical rectangle with the current clip
+     * @note w or h may end up <= 0
+     */
+    static void clipBox(int16_t& x, int16_t& y, int16_t& w, int16_t& h);
+    
+    /**
+     * @brief Mark the clipped part of a drawn rectangle dirty (immediate mode)
+     */
+    static void markDrawn(int16_t x, int16_t y, int16_t w, int16_t h);
+    
+    /**
+     * @brief Build the CMD_CLIP command for the current clip
+     */
+    static DrawCommand clipCommand();
+    
+    /**
+     * @brief Apply a changed clip to the screen canvas
+     * @details Sets the clip directly, records it in deferred mode, or queues it
+     *          for the render task, which owns the screen while it runs.
+     */
+    static void applyClip();
+    
+    /**
+     * @brief Record a command in deferred or render task mode
+     * @details Stores the command with the physical rows of its bounding box and marks
+     *          the box dirty, or queues both for the render task. The box is clipped
+     *          first; commands entirely off screen or outside the clip are not stored.
      * 
-     * @note Called internally by all drawing functions
-     * @note Handles all four rotation cases efficiently
+     * @param cmd Command to record (row0/row1 are filled in)
+     * @param x, y, w, h Logical bounding box of the command
+     */
+    static void record(DrawCommand cmd, int16_t x, int16_t y, int16_t w, int16_t h);
+    
+    /**
+     * @brief Push a command into the render task queue
+     * @details Waits for the render task while the ring is full, and wakes it
+     *          every quarter ring so it draws while the producer keeps recording.
+     */
+    static void enqueue(const DrawCommand& cmd, const DirtyRect& box);
+    
+    /**
+     * @brief Push a frame/sync/stop marker and wake the render task
+     */
+    static void pushMarker(uint8_t type);
+    
+    /**
+     * @brief Render task body: pop, draw, mark dirty, present on CMD_FRAME
+     */
+    static void renderTaskLoop(void* arg);
+    
+    /**
+     * @brief Check whether the caller is the render task
      */
-    static void transformCoordinates(int16_t& x, int16_t& y);
+    static bool onRenderTask();
     
     /**
-     * @brief Transform dimensions for rotated operations
-     * @details Handles dimension transformations needed for certain rotated operations.
+     * @brief Execute one command on a canvas
+     * @details Calls the canvas primitive, without dirty tracking or recording.
      * 
-     * @param w Reference to width (may be modified)
-     * @param h Reference to height (may be modified)
-     * @param x X coordinate context
-     * @param y Y coordinate context
+     * @param target The screen, or the band being replayed
+     * @param cmd Command to draw
+     */
+    static void execute(FastCanvas& target, const DrawCommand& cmd);
+    
+    /**
+     * @brief Replay the recorded list into the framebuffer band by band
+     * @details Only bands touched by at least one command are loaded and stored.
+     */
+    static void renderCommands();
+    
+    /**
+     * @brief Allocate what deferred mode needs, on first use
+     * @param list_count Command lists (2 without a framebuffer)
+     * @param band Also allocate the band buffer
+     */
+    static bool allocateDeferred(int list_count, bool band);
+    
+    /**
+     * @brief Switch to recording after begin(), with an empty list
+     */
+    static void startDeferred();
+    
+    /**
+     * @brief Load physical rows into the band buffer
+     * @details Copies them from the RGB565 framebuffer or expands them from the
+     *          index buffer.
+     */
+    static void loadBand(int16_t row0, int16_t row1);
+    
+    /**
+     * @brief Store the band buffer back into physical rows
+     */
+    static void storeBand(int16_t row0, int16_t row1);
+    
+    /**
+     * @brief Canvas over the band buffer holding physical rows row0..row1
+     * @details Screen rotation, clip and glyph cache as the screen canvas.
+     */
+    static void bandCanvas(FastCanvas& band, int16_t row0, int16_t row1);
+    
+    /**
+     * @brief Send one physical rectangle of the index buffer to the panel
+     * @details Expands it, widened to whole bytes, into the band buffer in chunks
+     *          and sends each chunk with one esp_lcd_panel_draw_bitmap() call.
+     */
+    static void flushIndexed(const DirtyRect& r);
+    
+    /**
+     * @brief scrollRect() on the index buffer
+     * @details Moves packed rows or in-row spans like FastCanvas::scrollRect() and
+     *          records the fill of the exposed rows.
+     */
+    static void scrollIndexed(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dy, uint16_t color);
+    
+    /**
+     * @brief Hand the recorded list to renderBand() (framebuffer-less mode)
+     * @details Waits until the next refresh starts showing it, then records into the
+     *          list that was shown before.
+     */
+    static void publishCommands();
+    
+    /**
+     * @brief Shared implementation of drawImage(), blit() and their alpha versions
+     * @details Clips the source rectangle to the image, then records or draws it.
+     * @param alpha Opacity, 255 for a plain copy
+     */
+    static void blitImage(int16_t x, int16_t y, const uint16_t* image, int16_t image_w, int16_t image_h,
+                          int16_t sx, int16_t sy, int16_t sw, int16_t sh, bool keyed, uint16_t key,
+                          uint8_t alpha = 255);
+    
+    /**
+     * @brief Add a physical rectangle to the dirty list
+     * @details Merges with pending rectangles it overlaps or touches, or when the
+     *          merge wastes at most FG_DIRTY_MERGE_SLACK pixels. When the list is full
+     *          the rectangle is merged into the one whose bounding box grows least.
+     * 
+     * @param x0 Left edge (inclusive)
+     * @param y0 Top edge (inclusive)
+     * @param x1 Right edge (exclusive)
+     * @param y1 Bottom edge (exclusive)
+     */
+    static void addDirtyRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+    
+    /**
+     * @brief Send one physical rectangle of the framebuffer to the panel
+     * @param r Rectangle to send
+     */
+    static void flushRect(const DirtyRect& r);
+    
+    /**
+     * @brief Send a physical rectangle stored contiguously from rows on
+     * @param rows Storage of column 0 of row r.y0
+     */
+    static void flushRows(const DirtyRect& r, const uint16_t* rows);
+    
+    /**
+     * @brief Split physical rows into the parts the scroll viewport stores contiguously
+     * @param parts Receives up to 4 parts: above, the two halves of the ring, below
+     * @return Number of parts that overlap rows row0..row1
+     */
+    static uint8_t viewportParts(int16_t row0, int16_t row1, ViewportPart* parts);
+    
+    /**
+     * @brief Draw a command through the scroll viewport
+     * @details Points the screen canvas at each part in turn, then back at the
+     *          whole framebuffer.
+     */
+    static void drawViewport(const DrawCommand& cmd);
+    
+    /**
+     * @brief Framebuffer storage of a physical row, following the viewport ring
+     */
+    static uint16_t* viewportRow(int16_t row);
+    
+    /**
+     * @brief scrollRect() while a scroll viewport is on
+     * @details Moves screen rows through viewportRow(); a rectangle that is exactly
+     *          the band becomes scrollViewport().
+     */
+    static void scrollViewportRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dy, uint16_t color);
+    
+    /**
+     * @brief Put the viewport rows back in display order
+     */
+    static void unrollViewport();
+    
+    /**
+     * @brief Swap front and back buffers on VSYNC (double-buffer mode)
+     * @details Hands the back buffer to the driver, waits for the swap, then brings
+     *          the new back buffer up to date by copying only the dirty rectangles.
+     */
+    static void swapBuffers();
+    
+    /**
+     * @brief Point the screen canvas at the framebuffer or the shadow buffer
+     * @details Flushes pending shadow pixels into the framebuffer, then for a
+     *          rotated shadow loads it from the framebuffer, so the screen content
+     *          and the dirty list carry over.
+     */
+    static void attachScreen(ScreenRotation rotation);
+    
+    /**
+     * @brief Rotate the dirty shadow rectangles into the framebuffer
+     * @details Leaves the dirty list in physical coordinates. No-op without shadow.
+     */
+    static void rotateDirtyRects();
+    
+    /**
+     * @brief Map a rectangle of a w x h area rotated clockwise by quarter turns
      */
-    static void transformDimensions(int16_t& w, int16_t& h, int16_t x, int16_t y);
+    static DirtyRect rotatedRect(const DirtyRect& r, uint8_t turns, int16_t w, int16_t h);
     
     /**
      * @brief Draw a single character at specified position
@@ -816,10 +2347,39 @@ private:
      * @param size Scaling factor
      * 
      * @note Characters outside ASCII range 0-127 are ignored
-     * @note Optimized for both size 1 and scaled characters
+     * @note Clipped once per glyph; on-screen glyphs are written as whole rows
+     * @note Scaled characters are drawn as runs of equal bits, not per-bit blocks
      */
     static void drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size);
     
+    /**
+     * @brief Draw one character of the current proportional font
+     * @param x, y Top-left corner of the character cell (line top)
+     * @param bg Fills the advance x line height cell unless equal to color
+     * @return Advance in pixels, 0 if the font has no glyph for c
+     */
+    static int16_t drawFontChar(int16_t x, int16_t y, uint16_t c, uint16_t color, uint16_t bg);
+    
+    /**
+     * @brief Height of a text line without line spacing
+     * @return Font yAdvance, or text_size * 8 for the built-in font
+     */
+    static int16_t lineHeight();
+    
+    /**
+     * @brief Draw a run of characters on one line
+     * @param size Text scaling factor of the 8x8 font
+     * @return X after the last character
+     */
+    static int16_t drawRun(int16_t x, int16_t y, const char* str, size_t length, uint16_t color, uint16_t bg,
+                           uint8_t size);
+    
+    /**
+     * @brief Fill the part of old not covered by box
+     * @details At most four rectangles: above, below, left and right of the overlap.
+     */
+    static void fillOutside(const TextBox& old, const TextBox& box, uint16_t color);
+    
     /**
      * @brief Advance text cursor after character output
      * @details Moves the cursor to the next character position and handles
@@ -839,7 +2399,7 @@ private:
      *          text area boundaries and line spacing.
      * 
      * @note Includes line spacing in vertical advancement
-     * @note Handles text area overflow by scrolling or resetting
+     * @note Handles text area overflow by scrolling (setTextScroll) or resetting
      */
     static void newLine();
 };
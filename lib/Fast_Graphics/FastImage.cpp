@@ -0,0 +1,189 @@
+// FastImage.cpp - Compressed RGB565 image decoder implementation
+
+#include "FastImage.h"
+#include "FastKernels.h"
+#include "esp_partition.h"
+#include "esp_idf_version.h"
+#include <string.h>
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+typedef esp_partition_mmap_handle_t image_mmap_handle_t;
+#define FG_IMAGE_MMAP_DATA ESP_PARTITION_MMAP_DATA
+#else
+typedef spi_flash_mmap_handle_t image_mmap_handle_t;
+#define FG_IMAGE_MMAP_DATA SPI_FLASH_MMAP_DATA
+#endif
+
+#define FG_IMAGE_OP_DIFF  0x40
+#define FG_IMAGE_OP_LUMA  0x80
+#define FG_IMAGE_OP_RUN   0xC0
+#define FG_IMAGE_OP_RAW   0xFE
+#define FG_IMAGE_OP_RUN8  0xFF
+
+#define FG_IMAGE_FILL_MIN 16            // Shorter runs are stored pixel by pixel
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+// Byte loads: images may start at any address and flash is read through the cache anyway
+static inline uint16_t read16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t read32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint8_t colorHash(uint16_t c) {
+    return (uint8_t)(((c >> 11) * 3 + ((c >> 5) & 0x3F) * 5 + (c & 0x1F) * 7) & (FG_IMAGE_INDEX_SIZE - 1));
+}
+
+/**
+ * @brief Decode one code
+ * @implementation Channels are added in place: each one is masked after the add, so
+ *                 carries never reach the next channel and differences wrap.
+ * @param color Previous color, replaced by the decoded one
+ * @param count Receives the number of pixels of that color
+ * @return Address of the next code
+ */
+static inline const uint8_t* decodeOp(const uint8_t* p, uint16_t& color, uint16_t* index, int32_t& count) {
+    uint8_t op = *p++;
+    count = 1;
+    if (op < FG_IMAGE_OP_DIFF) {
+        color = index[op];
+        return p;
+    }
+    if (op < FG_IMAGE_OP_RUN) {
+        int32_t dr, dg, db;
+        if (op < FG_IMAGE_OP_LUMA) {
+            dr = ((op >> 4) & 3) - 2;
+            dg = ((op >> 2) & 3) - 2;
+            db = (op & 3) - 2;
+        } else {
+            uint8_t rb = *p++;
+            dg = (op & 0x3F) - 32;
+            dr = (dg >> 1) + (rb >> 4) - 8;
+            db = (dg >> 1) + (rb & 0x0F) - 8;
+        }
+        color = (uint16_t)(((((color >> 11) + dr) & 0x1F) << 11) |
+                           (((((color >> 5) & 0x3F) + dg) & 0x3F) << 5) |
+                           (((color & 0x1F) + db) & 0x1F));
+    } else if (op == FG_IMAGE_OP_RAW) {
+        color = read16(p);
+        p += 2;
+    } else {
+        count = op == FG_IMAGE_OP_RUN8 ? *p++ + 63 : op - (FG_IMAGE_OP_RUN - 1);
+        return p;
+    }
+    index[colorHash(color)] = color;
+    return p;
+}
+
+// =============================================================================
+// IMAGE INFO
+// =============================================================================
+
+bool FastImage::valid(const uint8_t* image) {
+    if (!image || read32(image) != FG_IMAGE_MAGIC) return false;
+    uint16_t w = read16(image + 4), h = read16(image + 6);
+    return w > 0 && h > 0 && w <= INT16_MAX && h <= INT16_MAX &&
+           read32(image + 8) >= FG_IMAGE_HEADER_BYTES + 4u * h;
+}
+
+int16_t FastImage::getWidth(const uint8_t* image) {
+    return (int16_t)read16(image + 4);
+}
+
+int16_t FastImage::getHeight(const uint8_t* image) {
+    return (int16_t)read16(image + 6);
+}
+
+uint32_t FastImage::getSize(const uint8_t* image) {
+    return read32(image + 8);
+}
+
+const uint8_t* FastImage::next(const uint8_t* image) {
+    return image + ((getSize(image) + 3) & ~3u);
+}
+
+// =============================================================================
+// DECODING
+// =============================================================================
+
+/**
+ * @brief Decode part of one row
+ * @implementation Seeks to the row through the row table, runs the codes left of x
+ *                 without storing (a run that straddles x is split), then writes
+ *                 count pixels. Runs in a buffer row are filled with
+ *                 FastKernels::fill16().
+ * @performance One code per pixel or run; the only state is 64 colors on the stack
+ */
+void FastImage::decodeRow(const uint8_t* image, int16_t row, int16_t x, int16_t count,
+                          uint16_t* dst, int32_t step) {
+    if (count <= 0) return;
+    const uint8_t* p = image + read32(image + FG_IMAGE_HEADER_BYTES + 4 * (int32_t)row);
+    uint16_t index[FG_IMAGE_INDEX_SIZE];
+    memset(index, 0, sizeof(index));
+    uint16_t color = 0;
+    int32_t n = 0;
+
+    int32_t skip = x;
+    while (skip > 0) {
+        p = decodeOp(p, color, index, n);
+        if (n > skip) {
+            n -= skip;      // The rest of the run is drawn
+            break;
+        }
+        skip -= n;
+        n = 0;
+    }
+
+    int32_t left = count;
+    while (left > 0) {
+        if (n == 0) p = decodeOp(p, color, index, n);
+        if (n > left) n = left;
+        left -= n;
+        if (step == 1 && n >= FG_IMAGE_FILL_MIN) {
+            FastKernels::fill16(dst, color, n);
+            dst += n;
+        } else {
+            for (; n > 0; n--) {
+                *dst = color;
+                dst += step;
+            }
+        }
+        n = 0;
+    }
+}
+
+void FastImage::decode(const uint8_t* image, int16_t sx, int16_t sy, int16_t sw, int16_t sh,
+                       uint16_t* dst, int32_t dst_stride) {
+    if (!valid(image) || !dst) return;
+    int16_t w = getWidth(image), h = getHeight(image);
+    if (sx < 0) { dst -= sx; sw += sx; sx = 0; }
+    if (sy < 0) { dst -= (int32_t)sy * dst_stride; sh += sy; sy = 0; }
+    if (sx + sw > w) sw = w - sx;
+    if (sy + sh > h) sh = h - sy;
+    for (int16_t row = 0; row < sh; row++) {
+        decodeRow(image, sy + row, sx, sw, dst, 1);
+        dst += dst_stride;
+    }
+}
+
+// =============================================================================
+// FLASH MAPPING
+// =============================================================================
+
+const uint8_t* FastImage::mapPartition(const char* label, size_t* size) {
+    const esp_partition_t* partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                                ESP_PARTITION_SUBTYPE_ANY, label);
+    if (!partition) return nullptr;
+    const void* data = nullptr;
+    image_mmap_handle_t handle;     // Never unmapped
+    if (esp_partition_mmap(partition, 0, partition->size, FG_IMAGE_MMAP_DATA, &data, &handle) != ESP_OK) {
+        return nullptr;
+    }
+    if (size) *size = partition->size;
+    return (const uint8_t*)data;
+}
@@ -0,0 +1,128 @@
+// FastImage.h - Compressed RGB565 images decoded straight from flash
+// QOI-style run/index/delta codes with a row table, written by tools/fgimage.py
+
+#ifndef FAST_IMAGE_H
+#define FAST_IMAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =============================================================================
+// IMAGE FORMAT
+// =============================================================================
+
+#define FG_IMAGE_MAGIC 0x31494746u      /**< "FGI1", little-endian */
+#define FG_IMAGE_HEADER_BYTES 16        /**< Header before the row table */
+#define FG_IMAGE_INDEX_SIZE 64          /**< Recently seen colors per row */
+
+/**
+ * @note Layout (all fields little-endian):
+ *
+ *       offset  size        field
+ *       0       4           magic "FGI1"
+ *       4       2           width
+ *       6       2           height
+ *       8       4           size: bytes of the whole image, header included
+ *       12      4           reserved, 0
+ *       16      4 * height  byte offset of each row's codes from the image start
+ *
+ *       Each row is coded on its own, starting from color 0x0000 and an all-zero
+ *       index, so any row can be decoded without the ones above it. A code is one
+ *       of (r, g, b are the 5/6/5-bit channels, differences wrap around):
+ *
+ *       00iiiiii            INDEX  color index[i]
+ *       01rrggbb            DIFF   previous color + (r - 2, g - 2, b - 2)
+ *       10gggggg rrrrbbbb   LUMA   dg = g - 32, previous + (dg/2 + r - 8, dg, dg/2 + b - 8)
+ *       11nnnnnn            RUN    previous color n + 1 times (n < 62)
+ *       11111110 lo hi      RAW    RGB565 color
+ *       11111111 n          RUN    previous color n + 63 times
+ *
+ *       Every color produced by DIFF, LUMA or RAW is stored at
+ *       index[(r * 3 + g * 5 + b * 7) % 64].
+ */
+
+// =============================================================================
+// FASTIMAGE CLASS
+// =============================================================================
+
+/**
+ * @class FastImage
+ * @brief Decoder for compressed RGB565 images
+ * @details Backgrounds, icons and dial faces drawn from an RGB565 array cost 2 bytes
+ *          of flash per pixel and as many bytes read through the flash cache. The
+ *          FGI format (see above) stores flat areas as runs and gradients as 1-byte
+ *          deltas, several times smaller for flat artwork, and decodes with a few
+ *          table loads per code. There is no decompression buffer: rows are decoded from the
+ *          memory-mapped data directly into the destination, and the row table lets
+ *          a partial blit start at its first row instead of the top of the image.
+ *
+ *          Images come from tools/fgimage.py, either as a C array (already in
+ *          memory-mapped flash) or as a binary written to a data partition and
+ *          mapped with mapPartition().
+ *
+ * @note Column access is sequential: a row is decoded from its first pixel, the
+ *       pixels left of the requested range are only skipped, not written
+ * @note Data is trusted like font tables; only the header is checked
+ *
+ * @example
+ * @code
+ * // Partition "images" flashed with: python tools/fgimage.py bg.png -o bg.fgi
+ * const uint8_t* bg = FastImage::mapPartition("images");
+ * FastGraphics::drawCompressed(0, 0, bg);
+ * @endcode
+ */
+class FastImage {
+public:
+    /**
+     * @brief Check the header of an image
+     * @return false for nullptr, a wrong magic or an empty image
+     */
+    static bool valid(const uint8_t* image);
+
+    static int16_t getWidth(const uint8_t* image);     /**< Width in pixels */
+    static int16_t getHeight(const uint8_t* image);    /**< Height in pixels */
+    static uint32_t getSize(const uint8_t* image);     /**< Bytes of the image, header included */
+
+    /**
+     * @brief Get the image following this one in a pack
+     * @details fgimage.py writes several inputs into one binary, each starting on a
+     *          4-byte boundary.
+     * @return Address after the image, check it with valid()
+     */
+    static const uint8_t* next(const uint8_t* image);
+
+    /**
+     * @brief Decode part of one row
+     * @param image Valid image
+     * @param row Row to decode (0 to height - 1)
+     * @param x First column written (the columns before it are skipped)
+     * @param count Pixels written, x + count must not exceed the width
+     * @param dst Destination of column x
+     * @param step Pixels between destination pixels (1 for a buffer row, the row
+     *             stride for a column of a rotated buffer)
+     */
+    static void decodeRow(const uint8_t* image, int16_t row, int16_t x, int16_t count,
+                          uint16_t* dst, int32_t step = 1);
+
+    /**
+     * @brief Decode a rectangle into a pixel buffer
+     * @param sx, sy, sw, sh Source rectangle, clipped to the image
+     * @param dst Destination of (sx, sy), e.g. a tile buffer
+     * @param dst_stride Destination row stride in pixels
+     */
+    static void decode(const uint8_t* image, int16_t sx, int16_t sy, int16_t sw, int16_t sh,
+                       uint16_t* dst, int32_t dst_stride);
+
+    /**
+     * @brief Map a data partition into the address space
+     * @details Uses esp_partition_mmap(), so reads go through the flash cache and
+     *          nothing is copied to RAM. The mapping is kept for the lifetime of the
+     *          program; mapping the same partition again maps it again.
+     * @param label Partition label from the partition table
+     * @param size Receives the partition size (optional)
+     * @return First byte of the partition, nullptr if it was not found or mapped
+     */
+    static const uint8_t* mapPartition(const char* label, size_t* size = nullptr);
+};
+
+#endif // FAST_IMAGE_H
@@ -0,0 +1,366 @@
+// FastKernels.cpp - Framebuffer fill/copy/blend kernels implementation
+
+#include "FastKernels.h"
+#include <string.h>
+
+#if FG_USE_PIE
+#include "freertos/FreeRTOS.h"  // For xPortGetCoreID()
+#endif
+
+// =============================================================================
+// VECTOR HELPERS (ESP32-S3 PIE)
+// =============================================================================
+
+#if FG_USE_PIE
+
+/**
+ * @brief Store a 128-bit pattern to consecutive 16-byte blocks
+ * @implementation Loads the pattern into q0 once, then runs a zero-overhead loop of
+ *                 EE.VST.128.IP stores (8 RGB565 pixels each, pointer post-increment).
+ * @param dst 16-byte aligned destination
+ * @param pattern 16-byte aligned pattern (4 copies of the 32-bit pixel pair)
+ * @param blocks Number of 16-byte blocks, must be > 0
+ */
+static inline void fill128(uint16_t* dst, const uint32_t* pattern, size_t blocks) {
+    asm volatile (
+        "ee.vld.128.ip  q0, %[pat], 0       \n"
+        "loopnez        %[n], 1f            \n"
+        "ee.vst.128.ip  q0, %[dst], 16      \n"
+        "1:                                 \n"
+        : [dst] "+r" (dst)
+        : [pat] "r" (pattern), [n] "r" (blocks)
+        : "memory"
+    );
+}
+
+/**
+ * @brief Copy consecutive 16-byte blocks
+ * @implementation Zero-overhead loop of EE.VLD.128.IP / EE.VST.128.IP pairs.
+ * @param dst 16-byte aligned destination
+ * @param src 16-byte aligned source
+ * @param blocks Number of 16-byte blocks, must be > 0
+ */
+static inline void copy128(uint16_t* dst, const uint16_t* src, size_t blocks) {
+    asm volatile (
+        "loopnez        %[n], 1f            \n"
+        "ee.vld.128.ip  q0, %[src], 16      \n"
+        "ee.vst.128.ip  q0, %[dst], 16      \n"
+        "1:                                 \n"
+        : [dst] "+r" (dst), [src] "+r" (src)
+        : [n] "r" (blocks)
+        : "memory"
+    );
+}
+
+// beginScalar() nesting depth per core; nonzero keeps that core off q0
+static volatile uint8_t scalar_depth[portNUM_PROCESSORS];
+
+static inline bool vectorAllowed() {
+    return scalar_depth[xPortGetCoreID()] == 0;
+}
+
+#endif // FG_USE_PIE
+
+// =============================================================================
+// SCALAR MODE
+// =============================================================================
+
+/**
+ * @brief Keep the calling core on the scalar body until endScalar()
+ * @implementation Per-core counter: an ISR on one core never forces the other
+ *                 core's tasks off the vector path, and a nested interrupt on the
+ *                 same core restores the count before the outer one resumes.
+ */
+void FastKernels::beginScalar() {
+#if FG_USE_PIE
+    scalar_depth[xPortGetCoreID()]++;
+#endif
+}
+
+void FastKernels::endScalar() {
+#if FG_USE_PIE
+    scalar_depth[xPortGetCoreID()]--;
+#endif
+}
+
+// =============================================================================
+// FILL
+// =============================================================================
+
+/**
+ * @brief Fill a run of pixels with one color
+ * @implementation 16-bit head store to reach 32-bit alignment, optional 128-bit
+ *                 vector body, then 32-bit stores unrolled 4x and a 16-bit tail.
+ * @performance Vector body: 8 pixels per store, scalar body: 2 pixels per store
+ */
+void FastKernels::fill16(uint16_t* dst, uint16_t color, size_t count) {
+    if (count == 0) return;
+
+    // Head: reach 32-bit alignment
+    if ((uintptr_t)dst & 2) {
+        *dst++ = color;
+        count--;
+    }
+
+    uint32_t pattern = ((uint32_t)color << 16) | color;
+
+#if FG_USE_PIE
+    if (count >= FG_PIE_MIN_PIXELS && vectorAllowed()) {
+        // Head: reach 128-bit alignment with 32-bit stores (at most 6 pixels)
+        while ((uintptr_t)dst & 15) {
+            *(uint32_t*)dst = pattern;
+            dst += 2;
+            count -= 2;
+        }
+
+        uint32_t vector_pattern[4] __attribute__((aligned(16))) = { pattern, pattern, pattern, pattern };
+        size_t blocks = count >> 3;
+        fill128(dst, vector_pattern, blocks);
+        dst += blocks << 3;
+        count &= 7;
+    }
+#endif
+
+    // Body: 32-bit stores, 8 pixels per iteration
+    uint32_t* dst32 = (uint32_t*)dst;
+    size_t pairs = count >> 1;
+    while (pairs >= 4) {
+        dst32[0] = pattern; dst32[1] = pattern; dst32[2] = pattern; dst32[3] = pattern;
+        dst32 += 4;
+        pairs -= 4;
+    }
+    while (pairs > 0) {
+        *dst32++ = pattern;
+        pairs--;
+    }
+
+    // Tail: odd pixel
+    if (count & 1) {
+        *(uint16_t*)dst32 = color;
+    }
+}
+
+// =============================================================================
+// COPY
+// =============================================================================
+
+/**
+ * @brief Copy a run of pixels
+ * @implementation Co-aligned buffers use the 128-bit vector body after a scalar
+ *                 alignment head; everything else is left to memcpy(), which
+ *                 already handles mismatched alignment well.
+ */
+void FastKernels::copy16(uint16_t* dst, const uint16_t* src, size_t count) {
+#if FG_USE_PIE
+    if (count >= FG_PIE_MIN_PIXELS && (((uintptr_t)dst ^ (uintptr_t)src) & 15) == 0 && vectorAllowed()) {
+        // Head: reach 128-bit alignment (at most 7 pixels)
+        while ((uintptr_t)dst & 15) {
+            *dst++ = *src++;
+            count--;
+        }
+
+        size_t blocks = count >> 3;
+        copy128(dst, src, blocks);
+        dst += blocks << 3;
+        src += blocks << 3;
+        count &= 7;
+    }
+#endif
+
+    memcpy(dst, src, count * sizeof(uint16_t));
+}
+
+// =============================================================================
+// BLEND
+// =============================================================================
+
+/**
+ * @brief Blend a spread foreground over one pixel
+ * @param fg Foreground spread to 0x07E0F81F
+ * @param dst RGB565 pixel (upper bits ignored)
+ * @param a Alpha 0..32
+ */
+static inline uint32_t blendSpread(uint32_t fg, uint32_t dst, uint32_t a) {
+    uint32_t bg = ((dst & 0xFFFF) | (dst << 16)) & 0x07E0F81F;
+    uint32_t result = ((((fg - bg) * a) >> 5) + bg) & 0x07E0F81F;
+    return (result | (result >> 16)) & 0xFFFF;
+}
+
+static inline uint32_t spread(uint32_t color) {
+    return (color | (color << 16)) & 0x07E0F81F;
+}
+
+/**
+ * @brief Blend one color over a run of pixels
+ * @implementation Spreads RGB565 to 0x07E0F81F (green in the upper half-word) so the
+ *                 gaps between channels absorb the products of one 5-bit multiply.
+ *                 The foreground spread is computed once for the whole run; after
+ *                 a 16-bit head the body loads, blends and stores pixel pairs.
+ * @performance One multiply per pixel, one 32-bit load and store per two pixels
+ */
+void FastKernels::blend16(uint16_t* dst, uint16_t color, uint8_t alpha, size_t count) {
+    uint32_t a = (alpha + 4) >> 3;  // 0..32
+    if (a == 0 || count == 0) return;
+    if (a >= 32) {
+        fill16(dst, color, count);
+        return;
+    }
+
+    uint32_t fg = spread(color);
+    if ((uintptr_t)dst & 2) {
+        *dst = (uint16_t)blendSpread(fg, *dst, a);
+        dst++;
+        count--;
+    }
+
+    uint32_t* dst32 = (uint32_t*)dst;
+    for (size_t pairs = count >> 1; pairs > 0; pairs--) {
+        uint32_t pair = *dst32;
+        *dst32++ = blendSpread(fg, pair, a) | (blendSpread(fg, pair >> 16, a) << 16);
+    }
+
+    if (count & 1) {
+        uint16_t* last = (uint16_t*)dst32;
+        *last = (uint16_t)blendSpread(fg, *last, a);
+    }
+}
+
+/**
+ * @brief Blend source pixels over a run of pixels
+ * @implementation As blend16(), spreading each source pixel. Equally aligned
+ *                 buffers run the pair body on both sides; otherwise pixels are
+ *                 blended one by one.
+ * @performance One multiply per pixel
+ */
+void FastKernels::blendCopy16(uint16_t* dst, const uint16_t* src, uint8_t alpha, size_t count) {
+    uint32_t a = (alpha + 4) >> 3;  // 0..32
+    if (a == 0 || count == 0) return;
+    if (a >= 32) {
+        copy16(dst, src, count);
+        return;
+    }
+
+    if ((((uintptr_t)dst ^ (uintptr_t)src) & 2) == 0) {
+        if ((uintptr_t)dst & 2) {
+            *dst = (uint16_t)blendSpread(spread(*src++), *dst, a);
+            dst++;
+            count--;
+        }
+        uint32_t* dst32 = (uint32_t*)dst;
+        const uint32_t* src32 = (const uint32_t*)src;
+        for (size_t pairs = count >> 1; pairs > 0; pairs--) {
+            uint32_t pair = *dst32, fg = *src32++;
+            *dst32++ = blendSpread(spread(fg & 0xFFFF), pair, a) | (blendSpread(spread(fg >> 16), pair >> 16, a) << 16);
+        }
+        dst = (uint16_t*)dst32;
+        src = (const uint16_t*)src32;
+        count &= 1;
+    }
+
+    while (count > 0) {
+        *dst = (uint16_t)blendSpread(spread(*src++), *dst, a);
+        dst++;
+        count--;
+    }
+}
+
+// =============================================================================
+// DIM
+// =============================================================================
+
+/**
+ * @brief Darken a run of pixels
+ * @implementation One right shift moves every channel of both pixels in a 32-bit
+ *                 word; the mask drops the bits that crossed into the channel
+ *                 below. The mask is built once from the three channel masks.
+ * @performance Two pixels per load, shift, AND and store
+ */
+void FastKernels::dim16(uint16_t* dst, uint8_t level, size_t count) {
+    if (level == 0 || count == 0) return;
+    if (level >= 6) {
+        fill16(dst, 0, count);
+        return;
+    }
+
+    uint16_t mask = ((0xF800 >> level) & 0xF800) | ((0x07E0 >> level) & 0x07E0) | (0x001F >> level);
+    if ((uintptr_t)dst & 2) {
+        *dst = (*dst >> level) & mask;
+        dst++;
+        count--;
+    }
+
+    uint32_t mask32 = ((uint32_t)mask << 16) | mask;
+    uint32_t* dst32 = (uint32_t*)dst;
+    size_t pairs = count >> 1;
+    while (pairs >= 4) {
+        dst32[0] = (dst32[0] >> level) & mask32;
+        dst32[1] = (dst32[1] >> level) & mask32;
+        dst32[2] = (dst32[2] >> level) & mask32;
+        dst32[3] = (dst32[3] >> level) & mask32;
+        dst32 += 4;
+        pairs -= 4;
+    }
+    while (pairs > 0) {
+        *dst32 = (*dst32 >> level) & mask32;
+        dst32++;
+        pairs--;
+    }
+
+    if (count & 1) {
+        uint16_t* last = (uint16_t*)dst32;
+        *last = (*last >> level) & mask;
+    }
+}
+
+// =============================================================================
+// ROTATE
+// =============================================================================
+
+/**
+ * @brief Copy a block of pixels rotated clockwise
+ * @implementation Two turns reverse each row into the mirrored row, which is
+ *                 sequential on both sides. Quarter turns go tile by tile; inside
+ *                 a tile every source column becomes one destination row segment,
+ *                 so writes are sequential and reads stay within the tile's rows.
+ * @performance One load and store per pixel, the tiles keep PSRAM traffic to whole
+ *              cache lines on both sides
+ */
+void FastKernels::rotate16(uint16_t* dst, size_t dst_stride, const uint16_t* src, size_t src_stride,
+                           int16_t w, int16_t h, uint8_t turns) {
+    if (w <= 0 || h <= 0) return;
+    turns &= 3;
+
+    if (turns == 0) {
+        for (int16_t y = 0; y < h; y++) {
+            copy16(dst + (size_t)y * dst_stride, src + (size_t)y * src_stride, w);
+        }
+        return;
+    }
+    if (turns == 2) {
+        for (int16_t y = 0; y < h; y++) {
+            const uint16_t* s = src + (size_t)y * src_stride;
+            uint16_t* d = dst + (size_t)(h - 1 - y) * dst_stride + (w - 1);
+            for (int16_t x = 0; x < w; x++) *d-- = *s++;
+        }
+        return;
+    }
+
+    for (int16_t ty = 0; ty < h; ty += FG_ROTATE_TILE) {
+        int16_t th = h - ty < FG_ROTATE_TILE ? h - ty : FG_ROTATE_TILE;
+        for (int16_t tx = 0; tx < w; tx += FG_ROTATE_TILE) {
+            int16_t tx1 = w - tx < FG_ROTATE_TILE ? w : tx + FG_ROTATE_TILE;
+            for (int16_t x = tx; x < tx1; x++) {
+                const uint16_t* s = src + (size_t)ty * src_stride + x;
+                if (turns == 1) {
+                    // Column x is destination row x, filled right to left
+                    uint16_t* d = dst + (size_t)x * dst_stride + (h - 1 - ty);
+                    for (int16_t i = 0; i < th; i++, s += src_stride) *d-- = *s;
+                } else {
+                    // Column x is destination row w-1-x, filled left to right
+                    uint16_t* d = dst + (size_t)(w - 1 - x) * dst_stride + ty;
+                    for (int16_t i = 0; i < th; i++, s += src_stride) *d++ = *s;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,176 @@
+// FastKernels.h - Framebuffer fill/copy/blend kernels for FastGraphics
+// 128-bit vector stores on ESP32-S3 (PIE), 32-bit scalar stores elsewhere
+
+#ifndef FAST_KERNELS_H
+#define FAST_KERNELS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sdkconfig.h"  // For CONFIG_IDF_TARGET_*
+
+// =============================================================================
+// KERNEL CONFIGURATION
+// =============================================================================
+
+// Use the ESP32-S3 vector extension (PIE) for long runs (set to 0 to force scalar code)
+#ifndef FG_USE_PIE
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+#define FG_USE_PIE 1
+#else
+#define FG_USE_PIE 0
+#endif
+#endif
+
+// Runs shorter than this stay on the scalar path (alignment head/tail would dominate)
+#ifndef FG_PIE_MIN_PIXELS
+#define FG_PIE_MIN_PIXELS 32
+#endif
+
+// Edge of the square tiles rotate16() transposes at a time (both tiles stay in cache)
+#ifndef FG_ROTATE_TILE
+#define FG_ROTATE_TILE 16
+#endif
+
+// =============================================================================
+// FASTKERNELS CLASS
+// =============================================================================
+
+/**
+ * @class FastKernels
+ * @brief Low-level RGB565 span kernels used by FastGraphics
+ * @details Every function works on one contiguous run of pixels and takes care of
+ *          alignment itself: a 16-bit store reaches 32-bit alignment, 32-bit stores
+ *          reach 128-bit alignment, the body uses the widest store available, and
+ *          the tail is finished with narrower stores again.
+ *
+ * @note On ESP32-S3 the body uses PIE 128-bit stores (8 pixels per instruction)
+ * @note On other chips, or with FG_USE_PIE=0, the body uses 32-bit stores (2 pixels)
+ * @note Interrupt handlers do not save the PIE registers: code that runs in an ISR
+ *       must bracket its kernel calls with beginScalar() / endScalar()
+ *
+ * @example
+ * @code
+ * // Fill one framebuffer row segment and copy it to the next row
+ * FastKernels::fill16(&fb[y * 800 + x], COLOR_RED, w);
+ * FastKernels::copy16(&fb[(y + 1) * 800 + x], &fb[y * 800 + x], w);
+ * @endcode
+ */
+class FastKernels {
+public:
+    /**
+     * @brief Fill a run of pixels with one color
+     * @param dst First pixel to write (any 16-bit alignment)
+     * @param color RGB565 fill color
+     * @param count Number of pixels
+     *
+     * @note Full-width rectangles are contiguous and can be filled with one call
+     */
+    static void fill16(uint16_t* dst, uint16_t color, size_t count);
+
+    /**
+     * @brief Copy a run of pixels
+     * @param dst Destination (any 16-bit alignment)
+     * @param src Source (any 16-bit alignment), must not overlap dst
+     * @param count Number of pixels
+     *
+     * @note The vector path needs src and dst equally aligned modulo 16 bytes;
+     *       otherwise the copy falls back to memcpy()
+     */
+    static void copy16(uint16_t* dst, const uint16_t* src, size_t count);
+
+    /**
+     * @brief Keep the calling core on the scalar body until endScalar()
+     * @details An interrupt that uses q0 corrupts the vector state of the task it
+     *          interrupted (or raises a coprocessor exception), so kernels called
+     *          from an ISR must not take the PIE path. Calls nest and only affect
+     *          the core they are made on.
+     *
+     * @note No-op without FG_USE_PIE
+     */
+    static void beginScalar();
+
+    /**
+     * @brief Undo one beginScalar() on the calling core
+     */
+    static void endScalar();
+
+    /**
+     * @brief Blend one color over a run of pixels
+     * @details dst = dst + (color - dst) * alpha, per channel, on the packed
+     *          0x07E0F81F spread of RGB565 so all three channels share one multiply.
+     *          The body reads and writes two pixels per 32-bit access.
+     *
+     * @param dst Pixels to blend into (modified in-place)
+     * @param color RGB565 color drawn on top
+     * @param alpha Opacity of color (0 = unchanged, 255 = solid color)
+     * @param count Number of pixels
+     *
+     * @note Alpha is reduced to 5 bits (33 levels) for the packed multiply
+     */
+    static void blend16(uint16_t* dst, uint16_t color, uint8_t alpha, size_t count);
+
+    /**
+     * @brief Blend a run of source pixels over a run of pixels
+     * @details Same packed multiply as blend16(), with the color taken from src.
+     *
+     * @param dst Pixels to blend into (modified in-place)
+     * @param src RGB565 pixels drawn on top, must not overlap dst
+     * @param alpha Opacity of src (0 = unchanged, 255 = plain copy)
+     * @param count Number of pixels
+     *
+     * @note Two pixels per 32-bit access when src and dst are equally aligned
+     */
+    static void blendCopy16(uint16_t* dst, const uint16_t* src, uint8_t alpha, size_t count);
+
+    /**
+     * @brief Darken a run of pixels by a power of two
+     * @details Every channel is shifted right by level, two pixels per 32-bit
+     *          shift and mask, without any multiply. Level 1 halves the
+     *          brightness, 2 quarters it, 6 or more gives black.
+     *
+     * @param dst Pixels to darken (modified in-place)
+     * @param level Right shift per channel (0 = unchanged)
+     * @param count Number of pixels
+     */
+    static void dim16(uint16_t* dst, uint8_t level, size_t count);
+
+    /**
+     * @brief Copy a block of pixels rotated clockwise
+     * @details Quarter turns read and write the block in FG_ROTATE_TILE square
+     *          tiles: the strided side of the transpose then touches only one
+     *          tile's worth of cache lines instead of one line per pixel.
+     *
+     * @param dst Top-left pixel of the rotated block
+     * @param dst_stride Destination row pitch in pixels
+     * @param src Top-left pixel of the source block, must not overlap dst
+     * @param src_stride Source row pitch in pixels
+     * @param w Source block width (the rotated block is h wide for odd turns)
+     * @param h Source block height
+     * @param turns Clockwise quarter turns (0-3), same sense as ScreenRotation
+     *
+     * @note Source pixel (x, y) lands at (h-1-y, x) for one turn, (w-1-x, h-1-y)
+     *       for two and (y, w-1-x) for three
+     */
+    static void rotate16(uint16_t* dst, size_t dst_stride, const uint16_t* src, size_t src_stride,
+                         int16_t w, int16_t h, uint8_t turns);
+
+    /**
+     * @brief Blend one color over a single pixel
+     * @details Same packed multiply as blend16(), inline for per-pixel coverage
+     *          such as anti-aliased edges.
+     *
+     * @param dst Current RGB565 pixel
+     * @param color RGB565 color drawn on top
+     * @param alpha Opacity of color (0 = dst, 255 = color)
+     * @return Blended RGB565 pixel
+     */
+    static inline uint16_t blendPixel(uint16_t dst, uint16_t color, uint8_t alpha) {
+        uint32_t a = (alpha + 4) >> 3;  // 0..32
+        uint32_t fg = (color | ((uint32_t)color << 16)) & 0x07E0F81F;
+        uint32_t bg = (dst | ((uint32_t)dst << 16)) & 0x07E0F81F;
+        uint32_t result = ((((fg - bg) * a) >> 5) + bg) & 0x07E0F81F;
+        return (uint16_t)(result | (result >> 16));
+    }
+};
+
+#endif // FAST_KERNELS_H
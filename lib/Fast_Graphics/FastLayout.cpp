@@ -0,0 +1,133 @@
+// FastLayout.cpp - Text measurement and line breaking implementation
+
+#include "FastLayout.h"
+
+// =============================================================================
+// MEASUREMENT
+// =============================================================================
+
+int16_t TextLayout::advance(char c, const GFXfont* font, uint8_t size) {
+    if (c == '\n' || c == '\r') return 0;
+    if (c == '\t') return FG_LAYOUT_TAB_SPACES * advance(' ', font, size);
+    if (!font) return size * 8;
+    uint8_t code = (uint8_t)c;
+    if (code < font->first || code > font->last) return 0;
+    return font->glyph[code - font->first].xAdvance;
+}
+
+int16_t TextLayout::measure(const char* str, size_t length, const GFXfont* font, uint8_t size) {
+    int16_t width = 0;
+    for (size_t i = 0; i < length; i++) width += advance(str[i], font, size);
+    return width;
+}
+
+/**
+ * @brief Find the line starting at str
+ * @implementation One pass with a single lookahead state: the end and width of the
+ *                 text before the last run of spaces is the soft break candidate.
+ *                 When a character would overflow the wrap width, the line ends at
+ *                 that candidate, or at the character itself if the line holds a
+ *                 single word. Trailing spaces are never part of the width.
+ * @performance One advance() lookup per character, no copies
+ */
+TextLine TextLayout::nextLine(const char* str, const GFXfont* font, uint8_t size, int16_t max_width,
+                              const char*& next) {
+    const char* p = str;
+    int16_t width = 0;
+    const char* content_end = str;      // After the last non-space character
+    int16_t content_width = 0;
+    const char* break_end = nullptr;    // Soft break candidate
+    int16_t break_width = 0;
+    
+    while (*p && *p != '\n') {
+        char c = *p;
+        int16_t char_width = advance(c, font, size);
+        bool space = c == ' ' || c == '\t';
+        if (space) {
+            if (content_end == p && p > str) {
+                break_end = p;
+                break_width = content_width;
+            }
+        } else if (max_width > 0 && width + char_width > max_width && p > str) {
+            if (break_end) {
+                // Soft break: the spaces that caused it start no line
+                next = break_end;
+                while (*next == ' ' || *next == '\t') next++;
+                return { 0, (uint16_t)(break_end - str), break_width };
+            }
+            // One word wider than the line: break between characters
+            next = p;
+            return { 0, (uint16_t)(content_end - str), content_width };
+        }
+        width += char_width;
+        p++;
+        if (!space) {
+            content_end = p;
+            content_width = width;
+        }
+    }
+    next = *p == '\n' ? p + 1 : nullptr;
+    return { 0, (uint16_t)(content_end - str), content_width };
+}
+
+// =============================================================================
+// LAYOUT
+// =============================================================================
+
+TextLayout::TextLayout()
+    : text(""), length(0), hash(0), font(nullptr), size(1), max_width(0), line_spacing(0),
+      line_height(8), width(0), line_count(0), truncated(false), valid(false) {}
+
+/**
+ * @brief Lay out a string
+ * @implementation Length and hash are computed in one pass; if they and all the
+ *                 parameters match the cached layout only the string pointer is
+ *                 updated. Otherwise nextLine() runs until the end of the string or
+ *                 FG_LAYOUT_MAX_LINES lines.
+ * @performance Unchanged: one multiply per character; changed: plus one advance()
+ *              per character
+ */
+bool TextLayout::update(const char* str, const GFXfont* font, uint8_t size, int16_t max_width, int16_t line_spacing) {
+    if (!str) str = "";
+    if (size == 0) size = 1;
+    uint32_t h = 2166136261u;
+    size_t n = 0;
+    for (const char* p = str; *p; p++, n++) h = (h ^ (uint8_t)*p) * 16777619u;
+    
+    text = str;
+    if (valid && n == length && h == hash && font == this->font && size == this->size &&
+        max_width == this->max_width && line_spacing == this->line_spacing) {
+        return false;
+    }
+    length = n;
+    hash = h;
+    this->font = font;
+    this->size = size;
+    this->max_width = max_width;
+    this->line_spacing = line_spacing;
+    line_height = font ? font->yAdvance : size * 8;
+    line_count = 0;
+    width = 0;
+    truncated = false;
+    
+    const char* p = str;
+    while (p) {
+        if (line_count == FG_LAYOUT_MAX_LINES) {
+            truncated = true;
+            break;
+        }
+        const char* next;
+        TextLine line = nextLine(p, font, size, max_width, next);
+        line.start = (uint16_t)(p - str);
+        lines[line_count++] = line;
+        if (line.width > width) width = line.width;
+        p = next;
+    }
+    valid = true;
+    return true;
+}
+
+int16_t TextLayout::getHeight() const {
+    if (line_count == 0) return 0;
+    return line_count * line_height + (line_count - 1) * line_spacing;
+}
@@ -0,0 +1,158 @@
+// FastLayout.h - Text measurement and line breaking for FastGraphics
+// Allocation-free: lines are offsets into the caller's string, nothing is copied
+
+#ifndef FAST_LAYOUT_H
+#define FAST_LAYOUT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "FastFont.h"
+
+// =============================================================================
+// LAYOUT CONFIGURATION
+// =============================================================================
+
+#ifndef FG_LAYOUT_MAX_LINES
+#define FG_LAYOUT_MAX_LINES 16      /**< Lines a TextLayout holds, further lines are dropped */
+#endif
+
+#define FG_LAYOUT_TAB_SPACES 4      /**< A tab advances by this many space widths */
+
+/**
+ * @enum TextAlign
+ * @brief Horizontal alignment of text lines
+ */
+enum TextAlign {
+    ALIGN_LEFT   = 0,  /**< Lines start at the left edge */
+    ALIGN_CENTER = 1,  /**< Lines are centered */
+    ALIGN_RIGHT  = 2   /**< Lines end at the right edge */
+};
+
+/**
+ * @struct TextLine
+ * @brief One laid out line: a slice of the source string
+ * @details Trailing spaces are not part of the line, and at a soft break the
+ *          spaces that caused it are skipped.
+ */
+struct TextLine {
+    uint16_t start;         /**< Offset of the first character in the source string */
+    uint16_t length;        /**< Characters in the line */
+    int16_t width;          /**< Advance width in pixels */
+};
+
+/**
+ * @struct TextBox
+ * @brief Rectangle covered by drawn text, in logical coordinates
+ */
+struct TextBox {
+    int16_t x, y, w, h;
+};
+
+// =============================================================================
+// TEXTLAYOUT CLASS
+// =============================================================================
+
+/**
+ * @class TextLayout
+ * @brief Line breaks and bounds of a string, measured once and reused
+ * @details update() breaks the string at spaces so no line is wider than the wrap
+ *          width (a word that is wider on its own is broken between characters)
+ *          and at '\n'. The result refers to the caller's string, which must stay
+ *          valid until the layout is drawn. Calling update() again with an
+ *          unchanged string and the same parameters only hashes the string: the
+ *          line breaks are kept.
+ *
+ *          Widths come from the font's xAdvance, or 8 * size per character for the
+ *          built-in font; a tab is FG_LAYOUT_TAB_SPACES spaces wide.
+ *
+ * @note Unchanged means same length and the same 32-bit FNV-1a hash
+ * @note Strings are limited to 65535 characters
+ *
+ * @example
+ * @code
+ * static TextLayout info;
+ * info.update(message, nullptr, 2, 300, 2);   // Re-measured only when message changes
+ * FastGraphics::drawLayout(250, 100, info, COLOR_WHITE, COLOR_BLACK, ALIGN_CENTER);
+ * @endcode
+ */
+class TextLayout {
+public:
+    TextLayout();
+
+    /**
+     * @brief Lay out a string
+     * @param str Null-terminated text (not copied)
+     * @param font Proportional font, nullptr for the built-in 8x8 font
+     * @param size Scaling factor of the built-in font (ignored with a font)
+     * @param max_width Wrap width in pixels, 0 to break at '\n' only
+     * @param line_spacing Extra pixels between lines
+     * @return true if the layout was computed, false if the cached one still applies
+     */
+    bool update(const char* str, const GFXfont* font, uint8_t size, int16_t max_width, int16_t line_spacing);
+
+    /**
+     * @brief Forget the cached layout, the next update() measures again
+     */
+    void invalidate() { valid = false; }
+
+    const char* getText() const { return text; }                   /**< Source string */
+    uint8_t getLineCount() const { return line_count; }            /**< Lines held */
+    const TextLine& getLine(uint8_t index) const { return lines[index]; }
+    bool isTruncated() const { return truncated; }                 /**< More than FG_LAYOUT_MAX_LINES lines */
+    const GFXfont* getFont() const { return font; }
+    uint8_t getSize() const { return size; }
+    int16_t getMaxWidth() const { return max_width; }
+    int16_t getLineHeight() const { return line_height; }          /**< Without spacing */
+    int16_t getLineSpacing() const { return line_spacing; }
+
+    /**
+     * @brief Width of the widest line
+     */
+    int16_t getWidth() const { return width; }
+
+    /**
+     * @brief Height of all lines, spacing between them included
+     */
+    int16_t getHeight() const;
+
+    // =============================================================================
+    // MEASUREMENT
+    // =============================================================================
+
+    /**
+     * @brief Advance width of one character
+     * @return Pixels, 0 for characters the font does not contain and '\n' / '\r'
+     */
+    static int16_t advance(char c, const GFXfont* font, uint8_t size);
+
+    /**
+     * @brief Advance width of a run of characters, no line breaking
+     */
+    static int16_t measure(const char* str, size_t length, const GFXfont* font, uint8_t size);
+
+    /**
+     * @brief Find the line starting at str
+     * @details The streaming step behind update(), for text of any number of lines.
+     * @param next Receives the start of the following line, nullptr after the last
+     * @return The line (start is 0: it begins at str)
+     */
+    static TextLine nextLine(const char* str, const GFXfont* font, uint8_t size, int16_t max_width,
+                             const char*& next);
+
+private:
+    const char* text;           /**< Source string */
+    size_t length;              /**< Source length */
+    uint32_t hash;              /**< FNV-1a of the source */
+    const GFXfont* font;        /**< Parameters of the cached layout */
+    uint8_t size;
+    int16_t max_width;
+    int16_t line_spacing;
+    int16_t line_height;
+    int16_t width;              /**< Widest line */
+    uint8_t line_count;
+    bool truncated;
+    bool valid;                 /**< Cached layout present */
+    TextLine lines[FG_LAYOUT_MAX_LINES];
+};
+
+#endif // FAST_LAYOUT_H
@@ -0,0 +1,207 @@
+// FastPalette.cpp - Palettised pixel format implementation
+
+#include "FastPalette.h"
+#include <string.h>
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+// Packed pixel access, leftmost pixel in the high bits
+static inline uint8_t getPacked(const uint8_t* row, int32_t x, int bits) {
+    int32_t bit = x * bits;
+    return (row[bit >> 3] >> (8 - bits - (bit & 7))) & ((1 << bits) - 1);
+}
+
+static inline void setPacked(uint8_t* row, int32_t x, int bits, uint8_t index) {
+    int32_t bit = x * bits;
+    int shift = 8 - bits - (bit & 7);
+    uint8_t mask = (uint8_t)(((1 << bits) - 1) << shift);
+    row[bit >> 3] = (uint8_t)((row[bit >> 3] & ~mask) | ((index << shift) & mask));
+}
+
+// =============================================================================
+// PALETTE SETUP
+// =============================================================================
+
+FastPalette::FastPalette() {
+    static const uint16_t black_white[2] = { 0x0000, 0xFFFF };
+    setColors(black_white, 2);
+}
+
+/**
+ * @brief Set the palette colors
+ * @implementation Each RGB444 bucket gets the color closest to its center (red and
+ *                 blue doubled to the 6-bit green scale), then every palette color
+ *                 claims its own bucket, lowest index last so it wins.
+ * @performance 4096 x count distance computations
+ */
+void FastPalette::setColors(const uint16_t* new_colors, uint16_t new_count) {
+    if (!new_colors || new_count == 0) return;
+    if (new_count > 256) new_count = 256;
+    count = new_count;
+    memset(colors, 0, sizeof(colors));
+    memcpy(colors, new_colors, count * sizeof(uint16_t));
+
+    for (uint16_t k = 0; k < (1 << FG_PALETTE_KEY_BITS); k++) {
+        int32_t r = (((k >> 8) & 0xF) << 1 | 1) * 2;
+        int32_t g = ((k >> 4) & 0xF) << 2 | 2;
+        int32_t b = ((k & 0xF) << 1 | 1) * 2;
+        int32_t best = INT32_MAX;
+        for (uint16_t i = 0; i < count; i++) {
+            int32_t dr = r - (colors[i] >> 11) * 2;
+            int32_t dg = g - ((colors[i] >> 5) & 0x3F);
+            int32_t db = b - (colors[i] & 0x1F) * 2;
+            int32_t distance = dr * dr + dg * dg + db * db;
+            if (distance < best) {
+                best = distance;
+                reverse[k] = (uint8_t)i;
+            }
+        }
+    }
+    for (uint16_t i = count; i-- > 0;) {
+        reverse[key(colors[i])] = (uint8_t)i;
+    }
+}
+
+/**
+ * @brief Use the fixed RGB332 palette
+ * @implementation Channel bits are repeated to fill RGB565, so 0b111 is full red;
+ *                 the top bits of each bucket are the index.
+ */
+void FastPalette::setRGB332() {
+    count = 256;
+    for (uint16_t i = 0; i < 256; i++) {
+        uint16_t r = i >> 5, g = (i >> 2) & 0x7, b = i & 0x3;
+        colors[i] = (uint16_t)(((r << 2 | r >> 1) << 11) | ((g << 3 | g) << 5) | (b << 3 | b << 1 | b >> 1));
+    }
+    for (uint16_t k = 0; k < (1 << FG_PALETTE_KEY_BITS); k++) {
+        reverse[k] = (uint8_t)((((k >> 9) & 0x7) << 5) | (((k >> 5) & 0x7) << 2) | ((k >> 2) & 0x3));
+    }
+}
+
+int32_t FastPalette::rowBytes(PixelFormat format, int16_t width) {
+    return ((int32_t)width * format + 7) / 8;
+}
+
+size_t FastPalette::bufferBytes(PixelFormat format, int16_t width, int16_t height) {
+    return (size_t)rowBytes(format, width) * height;
+}
+
+// =============================================================================
+// ROW CONVERSION
+// =============================================================================
+
+/**
+ * @brief Expand packed pixels to RGB565
+ * @implementation Pixels before the first whole byte and after the last one are
+ *                 read one by one, whole bytes in between by shifts.
+ * @performance One table load and one 16-bit store per pixel
+ */
+void FastPalette::expand(const uint8_t* row, PixelFormat format, int32_t x, int32_t n, uint16_t* dst) const {
+    if (n <= 0) return;
+    if (format == PIXEL_INDEX8) {
+        row += x;
+        for (int32_t i = 0; i < n; i++) dst[i] = colors[row[i]];
+        return;
+    }
+
+    int bits = format;
+    int32_t per_byte = 8 / bits;
+    while (n > 0 && x % per_byte) {
+        *dst++ = colors[getPacked(row, x++, bits)];
+        n--;
+    }
+    const uint8_t* p = row + x / per_byte;
+    if (format == PIXEL_INDEX4) {
+        for (; n >= 2; n -= 2) {
+            uint8_t byte = *p++;
+            dst[0] = colors[byte >> 4];
+            dst[1] = colors[byte & 0x0F];
+            dst += 2;
+        }
+        if (n) *dst = colors[*p >> 4];
+    } else {
+        uint16_t c0 = colors[0], c1 = colors[1];
+        for (; n >= 8; n -= 8) {
+            uint8_t byte = *p++;
+            for (int i = 0; i < 8; i++) dst[i] = (byte & (0x80 >> i)) ? c1 : c0;
+            dst += 8;
+        }
+        for (int i = 0; i < n; i++) dst[i] = (*p & (0x80 >> i)) ? c1 : c0;
+    }
+}
+
+/**
+ * @brief Store RGB565 pixels as their nearest indices
+ * @implementation Whole bytes are assembled in a register and stored once; the
+ *                 partial bytes at the ends are read, merged and written back.
+ */
+void FastPalette::pack(const uint16_t* src, PixelFormat format, int32_t x, int32_t n, uint8_t* row) const {
+    if (n <= 0) return;
+    if (format == PIXEL_INDEX8) {
+        row += x;
+        for (int32_t i = 0; i < n; i++) row[i] = reverse[key(src[i])];
+        return;
+    }
+
+    int bits = format;
+    int32_t per_byte = 8 / bits;
+    while (n > 0 && x % per_byte) {
+        setPacked(row, x++, bits, reverse[key(*src++)]);
+        n--;
+    }
+    uint8_t* p = row + x / per_byte;
+    for (; n >= per_byte; n -= per_byte) {
+        uint8_t byte = 0;
+        for (int32_t i = 0; i < per_byte; i++) byte = (uint8_t)(byte << bits | reverse[key(src[i])]);
+        *p++ = byte;
+        src += per_byte;
+    }
+    for (int32_t i = 0; i < n; i++) setPacked(p, i, bits, reverse[key(src[i])]);
+}
+
+/**
+ * @brief Move packed pixels, like memmove()
+ * @implementation Same-phase spans copy their whole bytes with memmove() and the
+ *                 partial ends pixel by pixel; the end nearer the destination
+ *                 goes last so an overlapping source is read before it is
+ *                 overwritten. Other spans go pixel by pixel in the direction
+ *                 that keeps an overlap intact.
+ */
+void FastPalette::movePixels(const uint8_t* src, int32_t src_x, uint8_t* dst, int32_t dst_x,
+                             int32_t n, PixelFormat format) {
+    if (n <= 0) return;
+    if (format == PIXEL_INDEX8) {
+        memmove(dst + dst_x, src + src_x, n);
+        return;
+    }
+
+    int bits = format;
+    int32_t per_byte = 8 / bits;
+    bool backward = ((intptr_t)dst - (intptr_t)src) * 8 + (dst_x - src_x) * bits > 0;
+    if (src_x % per_byte == dst_x % per_byte && n >= 2 * per_byte) {
+        int32_t head = (per_byte - src_x % per_byte) % per_byte;
+        int32_t bytes = (n - head) / per_byte;
+        int32_t tail = n - head - bytes * per_byte;
+        int32_t mid = head + bytes * per_byte;
+        if (backward) {
+            for (int32_t i = n; i-- > mid;) setPacked(dst, dst_x + i, bits, getPacked(src, src_x + i, bits));
+        } else {
+            for (int32_t i = 0; i < head; i++) setPacked(dst, dst_x + i, bits, getPacked(src, src_x + i, bits));
+        }
+        memmove(dst + (dst_x + head) / per_byte, src + (src_x + head) / per_byte, bytes);
+        if (backward) {
+            for (int32_t i = head; i-- > 0;) setPacked(dst, dst_x + i, bits, getPacked(src, src_x + i, bits));
+        } else {
+            for (int32_t i = mid; i < mid + tail; i++) setPacked(dst, dst_x + i, bits, getPacked(src, src_x + i, bits));
+        }
+        return;
+    }
+
+    if (backward) {
+        for (int32_t i = n; i-- > 0;) setPacked(dst, dst_x + i, bits, getPacked(src, src_x + i, bits));
+    } else {
+        for (int32_t i = 0; i < n; i++) setPacked(dst, dst_x + i, bits, getPacked(src, src_x + i, bits));
+    }
+}
@@ -0,0 +1,149 @@
+// FastPalette.h - Palettised pixel formats for reduced-memory framebuffers
+// 8, 4 and 1-bit color indices, expanded to RGB565 through a lookup table
+
+#ifndef FAST_PALETTE_H
+#define FAST_PALETTE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =============================================================================
+// PIXEL FORMATS
+// =============================================================================
+
+/**
+ * @enum PixelFormat
+ * @brief Framebuffer pixel format, the value is the number of bits per pixel
+ * @details Packed formats store the leftmost pixel of a byte in its high bits,
+ *          like the bitmaps of drawBitmap() and drawBitmap4().
+ */
+enum PixelFormat {
+    PIXEL_RGB565 = 16,  /**< RGB565, one uint16_t per pixel */
+    PIXEL_INDEX8 = 8,   /**< Palette index, one byte per pixel (256 colors, or RGB332) */
+    PIXEL_INDEX4 = 4,   /**< Palette index, two pixels per byte (16 colors) */
+    PIXEL_INDEX1 = 1    /**< Palette index, eight pixels per byte (2 colors) */
+};
+
+#define FG_PALETTE_KEY_BITS 12      /**< RGB444 buckets of the color-to-index table */
+
+// =============================================================================
+// FASTPALETTE CLASS
+// =============================================================================
+
+/**
+ * @class FastPalette
+ * @brief Color table of a palettised framebuffer
+ * @details Maps indices to RGB565 for scanout, and RGB565 back to the nearest
+ *          index for drawing: every primitive still draws RGB565 (anti-aliased
+ *          edges and blends included) and the result is stored as indices, see
+ *          FastGraphics::beginIndexed(). The reverse lookup is a table over the
+ *          4096 RGB444 buckets, built by setColors(), so storing a pixel costs
+ *          one shift-and-mask and one byte load whatever the palette size.
+ *
+ * @note About 4.6 KB; keep it in internal RAM when the bounce-buffer callback
+ *       expands through it
+ * @note Colors of the palette map to their own index as long as no two of them
+ *       share an RGB444 bucket (the first one wins)
+ *
+ * @example
+ * @code
+ * static const uint16_t colors[16] = { COLOR_BLACK, COLOR_WHITE, COLOR_RED, ... };
+ * static FastPalette palette;
+ * palette.setColors(colors, 16);
+ * FastGraphics::beginIndexed(index_buffer, PIXEL_INDEX4, &palette, panel_handle);
+ * @endcode
+ */
+class FastPalette {
+public:
+    /**
+     * @brief Create a black and white palette
+     */
+    FastPalette();
+
+    /**
+     * @brief Set the palette colors
+     * @details Builds the reverse table by a nearest-color search for every
+     *          bucket, a few milliseconds for 256 colors: set palettes at start-up.
+     * @param colors RGB565 colors, index 0 first
+     * @param count Number of colors (1 to 256; 16 for PIXEL_INDEX4, 2 for PIXEL_INDEX1)
+     */
+    void setColors(const uint16_t* colors, uint16_t count);
+
+    /**
+     * @brief Use the fixed RGB332 palette (3 bits red, 3 green, 2 blue)
+     * @details Index bits are RRRGGGBB. No search: every color maps to its index
+     *          by truncation, the fastest setup for PIXEL_INDEX8 with many colors.
+     */
+    void setRGB332();
+
+    /** @brief RGB565 color of an index */
+    uint16_t getColor(uint8_t index) const { return colors[index]; }
+
+    /** @brief Nearest index of an RGB565 color */
+    uint8_t getIndex(uint16_t color) const { return reverse[key(color)]; }
+
+    /** @brief Number of colors */
+    uint16_t getCount() const { return count; }
+
+    /**
+     * @brief Bytes of one buffer row
+     * @param format Pixel format
+     * @param width Row width in pixels
+     */
+    static int32_t rowBytes(PixelFormat format, int16_t width);
+
+    /**
+     * @brief Bytes of a whole buffer
+     */
+    static size_t bufferBytes(PixelFormat format, int16_t width, int16_t height);
+
+    // =============================================================================
+    // ROW CONVERSION
+    // =============================================================================
+
+    /**
+     * @brief Expand packed pixels to RGB565
+     * @param row Packed row (or several rows back to back if their bytes are whole)
+     * @param format PIXEL_INDEX8, PIXEL_INDEX4 or PIXEL_INDEX1
+     * @param x First pixel in the row
+     * @param count Pixels to expand
+     * @param dst Destination, count RGB565 pixels
+     */
+    void expand(const uint8_t* row, PixelFormat format, int32_t x, int32_t count, uint16_t* dst) const;
+
+    /**
+     * @brief Store RGB565 pixels as their nearest indices
+     * @details Bits of partial bytes at either end are kept.
+     * @param src Source, count RGB565 pixels
+     * @param format PIXEL_INDEX8, PIXEL_INDEX4 or PIXEL_INDEX1
+     * @param x First pixel in the row
+     * @param count Pixels to store
+     * @param row Packed row
+     */
+    void pack(const uint16_t* src, PixelFormat format, int32_t x, int32_t count, uint8_t* row) const;
+
+    /**
+     * @brief Move packed pixels, like memmove()
+     * @details The source and destination may overlap, e.g. within one row.
+     *          Spans starting at the same bit of a byte are moved as bytes.
+     * @param src Source row
+     * @param src_x First source pixel
+     * @param dst Destination row
+     * @param dst_x First destination pixel
+     * @param count Pixels to move
+     */
+    static void movePixels(const uint8_t* src, int32_t src_x, uint8_t* dst, int32_t dst_x,
+                           int32_t count, PixelFormat format);
+
+private:
+    /** @brief RGB444 bucket of an RGB565 color */
+    static inline uint16_t key(uint16_t color) {
+        return ((color >> 4) & 0xF00) | ((color >> 3) & 0x0F0) | ((color >> 1) & 0x00F);
+    }
+
+    uint16_t colors[256];                           /**< RGB565 color of each index */
+    uint8_t reverse[1 << FG_PALETTE_KEY_BITS];      /**< Nearest index of each RGB444 bucket */
+    uint16_t count;                                 /**< Number of colors */
+};
+
+#endif // FAST_PALETTE_H
@@ -0,0 +1,275 @@
+// FixedCanvas.h - Drawing surface with compile-time size, stride and rotation
+// For devices that never rotate: every address is constant-folded arithmetic
+
+#ifndef FIXED_CANVAS_H
+#define FIXED_CANVAS_H
+
+#include "FastCanvas.h"     // ScreenRotation, shared 8x8 font
+#include "FastKernels.h"    // Row fills
+
+// =============================================================================
+// FIXEDCANVAS TEMPLATE
+// =============================================================================
+
+/**
+ * @class FixedCanvas
+ * @brief RGB565 drawing surface whose geometry is known at compile time
+ * @details The specialised counterpart of FastCanvas for units that ship in one
+ *          orientation. Buffer size, stride and rotation are template parameters, so
+ *          the rotation mapping folds into one constant origin and two constant
+ *          address steps: pixel(), fillRect() and the text paths compile down to
+ *          multiply-add address arithmetic without the run-time rotation switch or
+ *          the mutable width/height loads. FastCanvas remains the choice for
+ *          displays that rotate at run time; both draw identical pixels.
+ *
+ * @tparam W Buffer width in pixels
+ * @tparam H Buffer height in pixels
+ * @tparam R Rotation, as for FastGraphics::setRotation() (default: ROTATION_0)
+ * @tparam STRIDE Pixels from one buffer row to the next (default: W)
+ *
+ * @note Header only; each combination of parameters is a separate instantiation
+ * @note Writes with the CPU only. Call FastGraphics::waitIdle() first in async mode,
+ *       and FastGraphics::markDirty() afterwards (with the screen in rotation R)
+ *
+ * @example
+ * @code
+ * // Panel mounted in portrait, never rotated
+ * typedef FixedCanvas<LCD_H_RES, LCD_V_RES, ROTATION_90> Screen;
+ * Screen screen(frame_buffer);
+ *
+ * FastGraphics::setRotation(ROTATION_90);          // Same mapping for markDirty()
+ * screen.fillRect(0, 0, Screen::getWidth(), 40, COLOR_BLUE);
+ * screen.text(8, 16, "Status", COLOR_WHITE, COLOR_BLUE);
+ * FastGraphics::markDirty(0, 0, Screen::getWidth(), 40);
+ * FastGraphics::flush();
+ * @endcode
+ */
+template <int16_t W, int16_t H, ScreenRotation R = ROTATION_0, int16_t STRIDE = W>
+class FixedCanvas {
+    static_assert(W > 0 && H > 0, "FixedCanvas needs a non-empty buffer");
+    static_assert(STRIDE >= W, "FixedCanvas stride must be at least the buffer width");
+
+public:
+    // =============================================================================
+    // CANVAS SETUP
+    // =============================================================================
+
+    /**
+     * @brief Create a canvas on a buffer of at least STRIDE * H pixels
+     */
+    explicit FixedCanvas(uint16_t* buffer = nullptr) : pixels(buffer) {}
+
+    /**
+     * @brief Point the canvas at another buffer of the same geometry
+     * @details E.g. the new back buffer after a double-buffer swap.
+     */
+    void setBuffer(uint16_t* buffer) { pixels = buffer; }
+
+    /**
+     * @brief Get the buffer
+     */
+    uint16_t* getBuffer() const { return pixels; }
+
+    /**
+     * @brief Check whether the rotation swaps width and height
+     */
+    static constexpr bool isPortrait() { return R == ROTATION_90 || R == ROTATION_270; }
+
+    /**
+     * @brief Get the logical width in rotation R
+     */
+    static constexpr int16_t getWidth() { return isPortrait() ? H : W; }
+
+    /**
+     * @brief Get the logical height in rotation R
+     */
+    static constexpr int16_t getHeight() { return isPortrait() ? W : H; }
+
+    // =============================================================================
+    // COORDINATE MAPPING
+    // =============================================================================
+
+    /**
+     * @brief Buffer offset of logical (0, 0)
+     * @details Same mapping as FastCanvas::transformCoordinates():
+     *          ROTATION_90 x'=W-1-y, y'=x; ROTATION_180 x'=W-1-x, y'=H-1-y;
+     *          ROTATION_270 x'=y, y'=H-1-x.
+     */
+    static constexpr int32_t origin() {
+        return R == ROTATION_90  ? W - 1 :
+               R == ROTATION_180 ? (int32_t)(H - 1) * STRIDE + W - 1 :
+               R == ROTATION_270 ? (int32_t)(H - 1) * STRIDE : 0;
+    }
+
+    /**
+     * @brief Buffer offset step for logical x + 1
+     */
+    static constexpr int32_t stepX() {
+        return R == ROTATION_90  ? STRIDE :
+               R == ROTATION_180 ? -1 :
+               R == ROTATION_270 ? -STRIDE : 1;
+    }
+
+    /**
+     * @brief Buffer offset step for logical y + 1
+     */
+    static constexpr int32_t stepY() {
+        return R == ROTATION_90  ? -1 :
+               R == ROTATION_180 ? -STRIDE :
+               R == ROTATION_270 ? 1 : STRIDE;
+    }
+
+    /**
+     * @brief Buffer offset of a logical pixel
+     * @note No bounds check; constant-folds entirely for constant coordinates
+     */
+    static constexpr int32_t offset(int16_t x, int16_t y) {
+        return origin() + x * stepX() + y * stepY();
+    }
+
+    // =============================================================================
+    // DRAWING FUNCTIONS
+    // =============================================================================
+
+    /**
+     * @brief Fill the whole canvas
+     * @details Buffer rows are contiguous when STRIDE == W, then this is one run.
+     */
+    void clear(uint16_t color) {
+        fillRect(0, 0, getWidth(), getHeight(), color);
+    }
+
+    /**
+     * @brief Draw a single pixel (clipped)
+     * @details One unsigned compare per axis, then a single indexed store.
+     */
+    void pixel(int16_t x, int16_t y, uint16_t color) {
+        if ((uint16_t)x >= (uint16_t)getWidth() || (uint16_t)y >= (uint16_t)getHeight()) return;
+        pixels[offset(x, y)] = color;
+    }
+
+    /**
+     * @brief Draw a filled rectangle (clipped)
+     * @details The buffer rectangle starts at the logical corner that maps to the
+     *          lowest address, which the rotation fixes at compile time, and spans
+     *          w x h (swapped in portrait). Rows are filled with FastKernels::fill16().
+     */
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        // Clip to logical canvas boundaries
+        if (x < 0) { w += x; x = 0; }
+        if (y < 0) { h += y; y = 0; }
+        if (x + w > getWidth()) w = getWidth() - x;
+        if (y + h > getHeight()) h = getHeight() - y;
+        if (w <= 0 || h <= 0) return;
+
+        int16_t corner_x = (R == ROTATION_180 || R == ROTATION_270) ? x + w - 1 : x;
+        int16_t corner_y = (R == ROTATION_90 || R == ROTATION_180) ? y + h - 1 : y;
+        int16_t row_pixels = isPortrait() ? h : w;
+        int16_t rows = isPortrait() ? w : h;
+
+        uint16_t* ptr = pixels + offset(corner_x, corner_y);
+        if (row_pixels == STRIDE) {
+            // Full-width rows are contiguous - one long run
+            FastKernels::fill16(ptr, color, (size_t)row_pixels * rows);
+            return;
+        }
+        for (int16_t row = 0; row < rows; row++) {
+            FastKernels::fill16(ptr, color, row_pixels);
+            ptr += STRIDE;
+        }
+    }
+
+    /**
+     * @brief Draw one character of the built-in 8x8 font
+     * @details A size 1 glyph fully on the canvas walks the buffer with the constant
+     *          steps; scaled glyphs are one fillRect() per run of equal bits. Glyphs
+     *          crossing the edge are drawn pixel by pixel.
+     *
+     * @param c Character (ASCII 0-127, others are ignored)
+     * @param color RGB565 foreground color
+     * @param bg RGB565 background color (same as color: transparent background)
+     * @param size Scaling factor
+     */
+    void drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size = 1) {
+        if (c < 0 || c > 127) return;
+
+        const uint8_t* char_data = font8x8_basic[(uint8_t)c];
+        int16_t glyph_size = size * 8;
+        bool opaque = bg != color;  // bg == color means transparent background
+
+        // Trivially reject glyphs entirely off the canvas
+        if (x >= getWidth() || y >= getHeight() || x + glyph_size <= 0 || y + glyph_size <= 0) return;
+
+        if (size > 1) {
+            for (int8_t row = 0; row < 8; row++) {
+                uint8_t line = char_data[row];
+                int8_t col = 0;
+                while (col < 8) {
+                    bool set = line & (1 << col);
+                    int8_t run = 1;
+                    while (col + run < 8 && (bool)(line & (1 << (col + run))) == set) run++;
+                    if (set || opaque) {
+                        fillRect(x + col * size, y + row * size, run * size, size, set ? color : bg);
+                    }
+                    col += run;
+                }
+            }
+        } else if (x < 0 || y < 0 || x + 8 > getWidth() || y + 8 > getHeight()) {
+            // Partially visible - per-pixel clipped path
+            for (int8_t row = 0; row < 8; row++) {
+                uint8_t line = char_data[row];
+                for (int8_t col = 0; col < 8; col++) {
+                    if (line & (1 << col)) {
+                        pixel(x + col, y + row, color);
+                    } else if (opaque) {
+                        pixel(x + col, y + row, bg);
+                    }
+                }
+            }
+        } else if (opaque) {
+            uint16_t* row_ptr = pixels + offset(x, y);
+            for (int8_t row = 0; row < 8; row++) {
+                uint8_t line = char_data[row];
+                for (int8_t col = 0; col < 8; col++) {
+                    row_ptr[col * stepX()] = (line & (1 << col)) ? color : bg;
+                }
+                row_ptr += stepY();
+            }
+        } else {
+            // Transparent background: visit set bits only
+            uint16_t* row_ptr = pixels + offset(x, y);
+            for (int8_t row = 0; row < 8; row++) {
+                uint8_t line = char_data[row];
+                while (line) {
+                    int col = __builtin_ctz(line);
+                    row_ptr[col * stepX()] = color;
+                    line &= line - 1;
+                }
+                row_ptr += stepY();
+            }
+        }
+    }
+
+    /**
+     * @brief Draw a string, '\n' starts a new line at x
+     */
+    void text(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size = 1) {
+        int16_t cursor_x = x, cursor_y = y;
+
+        while (*str) {
+            if (*str == '\n') {
+                cursor_y += size * 8;
+                cursor_x = x;
+            } else if (*str != '\r') {
+                drawChar(cursor_x, cursor_y, *str, color, bg, size);
+                cursor_x += size * 8;
+            }
+            str++;
+        }
+    }
+
+private:
+    uint16_t* pixels;   /**< Buffer row 0 */
+};
+
+#endif // FIXED_CANVAS_H
@@ -0,0 +1,750 @@
+// FastWidgets.cpp - Retained-mode widgets implementation
+
+#include "FastWidgets.h"
+#include "FastFormat.h"
+#include "esp_heap_caps.h"
+#include <string.h>
+#include <math.h>
+
+// =============================================================================
+// FASTWIDGET BASE CLASS
+// =============================================================================
+
+FastWidget::FastWidget(int16_t x, int16_t y, int16_t w, int16_t h)
+    : x(x), y(y), w(w), h(h), needs_full(true), needs_partial(false), touchable(false), pressed(false) {
+}
+
+/**
+ * @brief Redraw the widget if its state changed
+ * @implementation A pending full redraw supersedes an incremental one. Both flags
+ *                 are cleared only after render() so a widget can compare its new
+ *                 state against the last rendered state inside render().
+ */
+bool FastWidget::update() {
+    if (needs_full) {
+        render(true);
+    } else if (needs_partial) {
+        render(false);
+    } else {
+        return false;
+    }
+    needs_full = false;
+    needs_partial = false;
+    return true;
+}
+
+void FastWidget::invalidate() {
+    needs_full = true;
+}
+
+bool FastWidget::needsUpdate() const {
+    return needs_full || needs_partial;
+}
+
+bool FastWidget::contains(int16_t px, int16_t py) const {
+    return px >= x && px < x + w && py >= y && py < y + h;
+}
+
+void FastWidget::setTouchable(bool new_touchable) {
+    if (new_touchable == touchable) return;
+    touchable = new_touchable;
+    FastWidgets::index_valid = false;
+    if (!touchable && FastWidgets::pressed == this) FastWidgets::pressed = nullptr;
+}
+
+void FastWidget::setPressed(bool new_pressed) {
+    if (new_pressed == pressed) return;
+    pressed = new_pressed;
+    changed();
+}
+
+void FastWidget::changed() {
+    needs_partial = true;
+}
+
+// =============================================================================
+// TEXT LABEL
+// =============================================================================
+
+FastLabel::FastLabel(int16_t x, int16_t y, int16_t w, int16_t h, const char* text,
+                     uint16_t color, uint16_t bg, uint8_t size)
+    : FastWidget(x, y, w, h), drawn_x(x), right_aligned(false), color(color), bg(bg), size(size) {
+    this->text[0] = '\0';
+    drawn_text[0] = '\0';
+    storeText(text);
+}
+
+void FastLabel::setText(const char* new_text) {
+    if (storeText(new_text)) changed();
+}
+
+void FastLabel::setColor(uint16_t new_color, uint16_t new_bg) {
+    if (new_color == color && new_bg == bg) return;
+    color = new_color;
+    bg = new_bg;
+    invalidate();
+}
+
+/**
+ * @brief Store new text, truncated to the characters that fit the widget width
+ * @implementation Compares while copying so an unchanged string costs one pass.
+ */
+bool FastLabel::storeText(const char* new_text) {
+    int16_t fit = w / (size * 8);
+    if (fit > FG_WIDGET_TEXT_MAX - 1) fit = FG_WIDGET_TEXT_MAX - 1;
+    if (fit < 0) fit = 0;
+    if (!new_text) new_text = "";
+
+    bool different = false;
+    int16_t i = 0;
+    for (; i < fit && new_text[i]; i++) {
+        if (text[i] != new_text[i]) {
+            text[i] = new_text[i];
+            different = true;
+        }
+    }
+    if (text[i] != '\0') {
+        text[i] = '\0';
+        different = true;
+    }
+    return different;
+}
+
+/**
+ * @brief Draw the label
+ * @implementation Full: fill the rectangle, then draw the text. Incremental: walk the
+ *                 new text and redraw only cells whose glyph differs from the glyph
+ *                 drawn there last time, then clear the cells only the old text
+ *                 covered. Both alignments keep the character grid fixed relative to
+ *                 the aligned edge, so old and new cells line up.
+ * @performance Changing one digit of a readout redraws one glyph
+ */
+void FastLabel::render(bool full) {
+    int16_t char_w = size * 8;
+    int16_t text_y = y + (h - char_w) / 2;
+    int16_t len = strlen(text);
+    int16_t text_x = right_aligned ? x + w - len * char_w : x;
+
+    if (full) {
+        FastGraphics::fillRect(x, y, w, h, bg);
+        FastGraphics::text(text_x, text_y, text, color, bg, size);
+    } else {
+        int16_t drawn_len = strlen(drawn_text);
+        int16_t drawn_end = drawn_x + drawn_len * char_w;
+        char glyph[2] = { 0, 0 };
+
+        for (int16_t i = 0; i < len; i++) {
+            int16_t cell_x = text_x + i * char_w;
+            int16_t old_index = (cell_x - drawn_x) / char_w;
+            bool covered = cell_x >= drawn_x && cell_x < drawn_end;
+            if (covered && drawn_text[old_index] == text[i]) continue;
+            glyph[0] = text[i];
+            FastGraphics::text(cell_x, text_y, glyph, color, bg, size);
+        }
+
+        // Clear what the old text covered outside the new text
+        int16_t text_end = text_x + len * char_w;
+        if (drawn_x < text_x) {
+            int16_t end = drawn_end < text_x ? drawn_end : text_x;
+            FastGraphics::fillRect(drawn_x, text_y, end - drawn_x, char_w, bg);
+        }
+        if (drawn_end > text_end) {
+            int16_t start = drawn_x > text_end ? drawn_x : text_end;
+            FastGraphics::fillRect(start, text_y, drawn_end - start, char_w, bg);
+        }
+    }
+
+    memcpy(drawn_text, text, len + 1);
+    drawn_x = text_x;
+}
+
+// =============================================================================
+// NUMERIC VALUE
+// =============================================================================
+
+FastNumber::FastNumber(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t decimals,
+                       uint16_t color, uint16_t bg, uint8_t size)
+    : FastLabel(x, y, w, h, "", color, bg, size), value(0), decimals(decimals) {
+    right_aligned = true;
+    setValue(0);
+}
+
+/**
+ * @brief Change the value
+ * @implementation Formats into a full FastFormat buffer, then fits the caption:
+ *                 a value too long for FG_WIDGET_TEXT_MAX loses its decimals
+ *                 first, and is cut only if the integer part alone is too long.
+ */
+void FastNumber::setValue(double new_value) {
+    value = new_value;
+    char buffer[FG_FORMAT_BUFFER_SIZE];
+    size_t len = FastFormat::formatFixed(buffer, new_value, decimals);
+    if (len > FG_WIDGET_TEXT_MAX - 1) len = FastFormat::formatFixed(buffer, new_value, 0);
+    if (len > FG_WIDGET_TEXT_MAX - 1) buffer[FG_WIDGET_TEXT_MAX - 1] = '\0';
+    setText(buffer);
+}
+
+// =============================================================================
+// PROGRESS BAR
+// =============================================================================
+
+FastBar::FastBar(int16_t x, int16_t y, int16_t w, int16_t h, float min_value, float max_value,
+                 uint16_t color, uint16_t bg, uint16_t border)
+    : FastWidget(x, y, w, h), min_value(min_value), max_value(max_value),
+      fill(0), drawn_fill(0), color(color), bg(bg), border(border) {
+}
+
+void FastBar::setValue(float value) {
+    int16_t inner = w - 2;
+    if (inner <= 0 || max_value == min_value) return;
+
+    float t = (value - min_value) / (max_value - min_value);
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+    int16_t new_fill = (int16_t)(t * inner + 0.5f);
+    if (new_fill == fill) return;
+    fill = new_fill;
+    changed();
+}
+
+void FastBar::setColor(uint16_t new_color) {
+    if (new_color == color) return;
+    color = new_color;
+    invalidate();
+}
+
+/**
+ * @brief Draw the bar
+ * @implementation Incremental redraws fill only the strip between the old and the
+ *                 new fill width: bar color when growing, background when shrinking.
+ */
+void FastBar::render(bool full) {
+    int16_t inner_h = h - 2;
+    if (full) {
+        FastGraphics::rect(x, y, w, h, border);
+        FastGraphics::fillRect(x + 1, y + 1, fill, inner_h, color);
+        FastGraphics::fillRect(x + 1 + fill, y + 1, w - 2 - fill, inner_h, bg);
+    } else if (fill > drawn_fill) {
+        FastGraphics::fillRect(x + 1 + drawn_fill, y + 1, fill - drawn_fill, inner_h, color);
+    } else {
+        FastGraphics::fillRect(x + 1 + fill, y + 1, drawn_fill - fill, inner_h, bg);
+    }
+    drawn_fill = fill;
+}
+
+// =============================================================================
+// CIRCULAR GAUGE
+// =============================================================================
+
+#define GAUGE_START_DEG 135.0f      // Sweep starts bottom left (screen Y points down)
+#define GAUGE_SWEEP_DEG 270.0f      // ...and runs clockwise through the top
+#define GAUGE_TICKS 11              // Tick marks including both ends
+
+FastGauge::FastGauge(int16_t cx, int16_t cy, int16_t radius, float min_value, float max_value,
+                     uint16_t needle, uint16_t face, uint16_t ticks)
+    : FastWidget(cx - radius, cy - radius, 2 * radius + 1, 2 * radius + 1),
+      cx(cx), cy(cy), radius(radius), min_value(min_value), max_value(max_value),
+      value(min_value), needle(needle), face(face), ticks(ticks) {
+    needleTip(value, tip_x, tip_y);
+    drawn_tip_x = tip_x;
+    drawn_tip_y = tip_y;
+}
+
+void FastGauge::setValue(float new_value) {
+    if (new_value < min_value) new_value = min_value;
+    if (new_value > max_value) new_value = max_value;
+    value = new_value;
+
+    int16_t tx, ty;
+    needleTip(value, tx, ty);
+    if (tx == tip_x && ty == tip_y) return;
+    tip_x = tx;
+    tip_y = ty;
+    changed();
+}
+
+/**
+ * @brief Needle tip position for a value
+ * @implementation The needle reaches 70% of the radius; ticks start at 80%.
+ */
+void FastGauge::needleTip(float v, int16_t& tx, int16_t& ty) const {
+    float t = max_value != min_value ? (v - min_value) / (max_value - min_value) : 0.0f;
+    float angle = (GAUGE_START_DEG + t * GAUGE_SWEEP_DEG) * (float)(M_PI / 180.0);
+    float length = radius * 0.7f;
+    tx = cx + (int16_t)lroundf(cosf(angle) * length);
+    ty = cy + (int16_t)lroundf(sinf(angle) * length);
+}
+
+/**
+ * @brief Draw the gauge
+ * @implementation Full: face, rim, ticks, needle and hub. Incremental: overdraw the
+ *                 old needle in the face color, then draw the new needle and hub.
+ * @performance An incremental redraw touches two lines and the hub, and only their
+ *              bounding boxes end up in the dirty list
+ */
+void FastGauge::render(bool full) {
+    if (full) {
+        FastGraphics::fillCircle(cx, cy, radius, face);
+        FastGraphics::circle(cx, cy, radius, ticks);
+        for (int i = 0; i < GAUGE_TICKS; i++) {
+            float angle = (GAUGE_START_DEG + i * GAUGE_SWEEP_DEG / (GAUGE_TICKS - 1)) * (float)(M_PI / 180.0);
+            float c = cosf(angle), s = sinf(angle);
+            float inner = radius * 0.8f, outer = radius - 2.0f;
+            FastGraphics::line(cx + (int16_t)lroundf(c * inner), cy + (int16_t)lroundf(s * inner),
+                               cx + (int16_t)lroundf(c * outer), cy + (int16_t)lroundf(s * outer), ticks);
+        }
+    } else {
+        FastGraphics::line(cx, cy, drawn_tip_x, drawn_tip_y, face);
+    }
+
+    FastGraphics::line(cx, cy, tip_x, tip_y, needle);
+    FastGraphics::fillCircle(cx, cy, radius / 16 + 2, needle);
+    drawn_tip_x = tip_x;
+    drawn_tip_y = tip_y;
+}
+
+// =============================================================================
+// BUTTON
+// =============================================================================
+
+FastButton::FastButton(int16_t x, int16_t y, int16_t w, int16_t h, const char* text,
+                       uint16_t color, uint16_t bg, uint16_t pressed_bg, uint8_t size)
+    : FastWidget(x, y, w, h), color(color), bg(bg), pressed_bg(pressed_bg), size(size) {
+    this->text[0] = '\0';
+    setText(text);
+    setTouchable(true);
+}
+
+void FastButton::setText(const char* new_text) {
+    if (!new_text) new_text = "";
+    if (strncmp(text, new_text, FG_WIDGET_TEXT_MAX - 1) == 0) return;
+    strncpy(text, new_text, FG_WIDGET_TEXT_MAX - 1);
+    text[FG_WIDGET_TEXT_MAX - 1] = '\0';
+    changed();
+}
+
+/**
+ * @brief Draw the button
+ * @implementation A press changes the whole face, so every redraw is a full one:
+ *                 face, border, then the caption centered in the face color.
+ */
+void FastButton::render(bool full) {
+    (void)full;
+    uint16_t face = isPressed() ? pressed_bg : bg;
+    FastGraphics::fillRect(x + 1, y + 1, w - 2, h - 2, face);
+    FastGraphics::rect(x, y, w, h, color);
+
+    int16_t text_w = FastGraphics::textWidth(text, size);
+    FastGraphics::text(x + (w - text_w) / 2, y + (h - size * 8) / 2, text, color, face, size);
+}
+
+// =============================================================================
+// STRIP CHART
+// =============================================================================
+
+#define CHART_HEADROOM 0.125f       // Range added on both sides when the range is fitted
+#define CHART_SHRINK 4              // Refit when the trace uses less than 1/4 of the range
+
+FastChart::FastChart(int16_t x, int16_t y, int16_t w, int16_t h, float min_value, float max_value,
+                     uint8_t series_count, ChartMode mode, uint16_t bg)
+    : FastWidget(x, y, w, h), spans(nullptr),
+      length(mode == CHART_SWEEP ? w : h), breadth(mode == CHART_SWEEP ? h : w), gap(0), shown(0),
+      series(series_count < 1 ? 1 : (series_count > FG_CHART_SERIES ? FG_CHART_SERIES : series_count)),
+      mode(mode), bg(bg), range_min(0), range_max(1), scale(0), auto_range(false),
+      decimation(1), pending(0), has_last(false), columns(0), drawn_columns(0) {
+    static const uint16_t defaults[] = { COLOR_GREEN, COLOR_YELLOW, COLOR_CYAN, COLOR_MAGENTA };
+    for (uint8_t i = 0; i < FG_CHART_SERIES; i++) {
+        colors[i] = defaults[i % (sizeof(defaults) / sizeof(defaults[0]))];
+    }
+    if (length > 0 && breadth > 0) {
+        gap = mode == CHART_SWEEP ? (FG_CHART_GAP < length ? FG_CHART_GAP : length - 1) : 0;
+        shown = length - gap;
+        spans = (Span*)heap_caps_malloc((size_t)length * series * sizeof(Span), MALLOC_CAP_DEFAULT);
+    }
+    applyRange(min_value, max_value);
+}
+
+FastChart::~FastChart() {
+    if (viewportActive()) FastGraphics::setScrollViewport(0, 0);
+    heap_caps_free(spans);
+}
+
+/**
+ * @brief Add one sample to every series
+ * @implementation The unfinished column starts at the previous sample, so its span
+ *                 joins the trace of the column before. A finished column is copied
+ *                 into the ring; with auto range it is checked against the range,
+ *                 and once per sweep the whole trace is checked for a range that
+ *                 became too wide.
+ * @performance No drawing: the column is drawn by the next update()
+ */
+void FastChart::addSamples(const float* samples) {
+    if (!samples) return;
+    for (uint8_t i = 0; i < series; i++) {
+        float v = samples[i];
+        Span& span = current[i];
+        if (pending == 0) span.lo = span.hi = has_last ? last[i] : v;
+        if (v < span.lo) span.lo = v;
+        if (v > span.hi) span.hi = v;
+        last[i] = v;
+    }
+    has_last = true;
+    if (++pending < decimation) return;
+    pending = 0;
+    if (!spans) return;
+
+    memcpy(&spans[(columns % length) * series], current, series * sizeof(Span));
+    columns++;
+    changed();
+
+    if (!auto_range) return;
+    for (uint8_t i = 0; i < series; i++) {
+        if (current[i].lo < range_min || current[i].hi > range_max) {
+            fitRange();
+            return;
+        }
+    }
+    if (columns % shown == 0) {
+        float lo, hi;
+        if (dataExtent(lo, hi) && (hi - lo) * CHART_SHRINK < range_max - range_min) fitRange();
+    }
+}
+
+void FastChart::addSample(float value) {
+    float samples[FG_CHART_SERIES];
+    for (uint8_t i = 1; i < series; i++) samples[i] = has_last ? last[i] : value;
+    samples[0] = value;
+    addSamples(samples);
+}
+
+void FastChart::clearData() {
+    columns = 0;
+    drawn_columns = 0;
+    pending = 0;
+    has_last = false;
+    invalidate();
+}
+
+void FastChart::setRange(float min_value, float max_value) {
+    auto_range = false;
+    applyRange(min_value, max_value);
+}
+
+void FastChart::setAutoRange(bool enabled) {
+    auto_range = enabled;
+    if (enabled) fitRange();
+}
+
+void FastChart::setDecimation(uint16_t samples) {
+    decimation = samples > 0 ? samples : 1;
+    pending = 0;
+}
+
+void FastChart::setSeriesColor(uint8_t index, uint16_t color) {
+    if (index >= series || colors[index] == color) return;
+    colors[index] = color;
+    invalidate();
+}
+
+/**
+ * @brief Set the range without changing auto range
+ * @implementation An empty or reversed range is widened to one unit above the
+ *                 start. The scale is computed once here, mapping a value costs a
+ *                 multiply.
+ */
+void FastChart::applyRange(float min_value, float max_value) {
+    if (!(max_value > min_value)) max_value = min_value + 1.0f;
+    bool different = min_value != range_min || max_value != range_max;
+    range_min = min_value;
+    range_max = max_value;
+    scale = (breadth - 1) / (max_value - min_value);
+    if (different) invalidate();
+}
+
+/**
+ * @brief Fit the range to the visible columns with headroom
+ * @implementation Flat data gets a range of a quarter of its value (one unit
+ *                 around zero), so noise does not trigger another fit right away.
+ */
+void FastChart::fitRange() {
+    float lo, hi;
+    if (!dataExtent(lo, hi)) return;
+    float extent = hi - lo;
+    if (!(extent > 0)) extent = fabsf(hi) > 0 ? fabsf(hi) * 0.25f : 1.0f;
+    applyRange(lo - extent * CHART_HEADROOM, hi + extent * CHART_HEADROOM);
+}
+
+bool FastChart::dataExtent(float& lo, float& hi) const {
+    uint32_t n = columns < (uint32_t)shown ? columns : (uint32_t)shown;
+    if (!spans || n == 0) return false;
+    lo = INFINITY;
+    hi = -INFINITY;
+    for (uint32_t c = columns - n; c < columns; c++) {
+        const Span* column = &spans[(c % length) * series];
+        for (uint8_t i = 0; i < series; i++) {
+            if (column[i].lo < lo) lo = column[i].lo;
+            if (column[i].hi > hi) hi = column[i].hi;
+        }
+    }
+    return lo <= hi;
+}
+
+int16_t FastChart::valuePixel(float value) const {
+    float p = (value - range_min) * scale;
+    if (!(p > 0)) return 0;     // Also NaN
+    if (p >= breadth - 1) return breadth - 1;
+    return (int16_t)(p + 0.5f);
+}
+
+/**
+ * @brief Pixel along the time axis a column is drawn at
+ * @implementation A sweep draws column c at c % length. A scrolling chart draws
+ *                 the newest column at the bottom and older ones above it.
+ */
+int16_t FastChart::columnSlot(uint32_t column) const {
+    return mode == CHART_SWEEP ? (int16_t)(column % length) : (int16_t)(length - (columns - column));
+}
+
+void FastChart::drawColumn(int16_t slot, uint32_t column) {
+    const Span* column_spans = &spans[(column % length) * series];
+    for (uint8_t i = 0; i < series; i++) {
+        int16_t p0 = valuePixel(column_spans[i].lo), p1 = valuePixel(column_spans[i].hi);
+        if (mode == CHART_SWEEP) {
+            FastGraphics::fillRect(x + slot, y + breadth - 1 - p1, 1, p1 - p0 + 1, colors[i]);
+        } else {
+            FastGraphics::fillRect(x + p0, y + slot, p1 - p0 + 1, 1, colors[i]);
+        }
+    }
+}
+
+void FastChart::clearSlot(int16_t slot) {
+    if (mode == CHART_SWEEP) {
+        FastGraphics::fillRect(x + slot, y, 1, h, bg);
+    } else {
+        FastGraphics::fillRect(x, y + slot, w, 1, bg);
+    }
+}
+
+bool FastChart::viewportActive() const {
+    int16_t viewport_y, viewport_h;
+    return FastGraphics::getScrollViewport(viewport_y, viewport_h) && viewport_y == y && viewport_h == h;
+}
+
+/**
+ * @brief Draw the chart
+ * @implementation Full: background, then the last shown columns from the ring. A
+ *                 scrolling chart of the screen width turns the scroll viewport on
+ *                 first. Incremental, CHART_SWEEP: each new column lands on a slot
+ *                 the gap already cleared, then the slot FG_CHART_GAP ahead is
+ *                 cleared. Incremental, CHART_SCROLL: one scroll by the number of
+ *                 new columns, then the new rows at the bottom. More new columns
+ *                 than fit on screen make it a full redraw.
+ * @performance A sweep column costs one 1-pixel-wide background fill plus one span
+ *              per series; a scrolled row adds the viewport scroll (a row clear)
+ *              or, without a viewport, a scrollRect() of the chart
+ */
+void FastChart::render(bool full) {
+    uint32_t added = columns - drawn_columns;
+    if (added > (uint32_t)shown) full = true;
+
+    if (full) {
+        if (mode == CHART_SCROLL && x == 0 && w == FastGraphics::getWidth() && !viewportActive()) {
+            FastGraphics::setScrollViewport(y, h);
+        }
+        FastGraphics::fillRect(x, y, w, h, bg);
+        if (spans) {
+            uint32_t n = columns < (uint32_t)shown ? columns : (uint32_t)shown;
+            for (uint32_t c = columns - n; c < columns; c++) drawColumn(columnSlot(c), c);
+        }
+    } else if (mode == CHART_SWEEP) {
+        for (uint32_t c = drawn_columns; c < columns; c++) {
+            int16_t slot = columnSlot(c);
+            if (gap == 0) clearSlot(slot);
+            drawColumn(slot, c);
+            if (gap > 0) clearSlot((int16_t)((c + gap) % length));
+        }
+    } else if (added > 0) {
+        if (viewportActive()) {
+            FastGraphics::scrollViewport((int16_t)added, bg);
+        } else {
+            FastGraphics::scrollRect(x, y, w, h, (int16_t)added, bg);
+        }
+        for (uint32_t c = drawn_columns; c < columns; c++) drawColumn(columnSlot(c), c);
+    }
+    drawn_columns = columns;
+}
+
+// =============================================================================
+// WIDGET MANAGER
+// =============================================================================
+
+FastWidget* FastWidgets::widgets[FG_MAX_WIDGETS];
+uint16_t FastWidgets::widget_count = 0;
+FastWidget* FastWidgets::pressed = nullptr;
+bool FastWidgets::index_valid = false;
+bool FastWidgets::index_overflow = false;
+uint16_t FastWidgets::cell_first[FG_HIT_CELLS + 1];
+uint16_t FastWidgets::cell_entries[FG_HIT_ENTRIES];
+
+bool FastWidgets::add(FastWidget* widget) {
+    if (!widget || widget_count >= FG_MAX_WIDGETS) return false;
+    widgets[widget_count++] = widget;
+    index_valid = false;
+    return true;
+}
+
+/**
+ * @brief Unregister a widget
+ * @implementation Shifts the remaining entries down to keep the draw order.
+ */
+void FastWidgets::remove(FastWidget* widget) {
+    for (uint16_t i = 0; i < widget_count; i++) {
+        if (widgets[i] == widget) {
+            memmove(&widgets[i], &widgets[i + 1], (widget_count - i - 1) * sizeof(FastWidget*));
+            widget_count--;
+            index_valid = false;
+            if (pressed == widget) pressed = nullptr;
+            return;
+        }
+    }
+}
+
+void FastWidgets::removeAll() {
+    widget_count = 0;
+    index_valid = false;
+    pressed = nullptr;
+}
+
+uint16_t FastWidgets::update() {
+    uint16_t drawn = 0;
+    for (uint16_t i = 0; i < widget_count; i++) {
+        if (widgets[i]->update()) drawn++;
+    }
+    return drawn;
+}
+
+void FastWidgets::invalidateAll() {
+    for (uint16_t i = 0; i < widget_count; i++) {
+        widgets[i]->invalidate();
+    }
+}
+
+uint16_t FastWidgets::count() {
+    return widget_count;
+}
+
+FastWidget* FastWidgets::get(uint16_t index) {
+    return index < widget_count ? widgets[index] : nullptr;
+}
+
+// =============================================================================
+// HIT TESTING
+// =============================================================================
+
+/**
+ * @brief Grid cells a widget overlaps
+ * @return false if the widget lies entirely outside the grid
+ */
+static bool cellRange(const FastWidget* widget, int16_t& cx0, int16_t& cy0, int16_t& cx1, int16_t& cy1) {
+    const int32_t limit = (int32_t)FG_HIT_GRID << FG_HIT_CELL_SHIFT;
+    int32_t x0 = widget->getX(), y0 = widget->getY();
+    int32_t x1 = x0 + widget->getWidth() - 1, y1 = y0 + widget->getHeight() - 1;
+    if (x1 < x0 || y1 < y0 || x1 < 0 || y1 < 0 || x0 >= limit || y0 >= limit) return false;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= limit) x1 = limit - 1;
+    if (y1 >= limit) y1 = limit - 1;
+    cx0 = x0 >> FG_HIT_CELL_SHIFT;
+    cy0 = y0 >> FG_HIT_CELL_SHIFT;
+    cx1 = x1 >> FG_HIT_CELL_SHIFT;
+    cy1 = y1 >> FG_HIT_CELL_SHIFT;
+    return true;
+}
+
+/**
+ * @brief Sort the touchable widgets into the grid cells they overlap
+ * @implementation Two passes over the widgets, no allocation: the first counts the
+ *                 entries of every cell and turns the counts into end offsets, the
+ *                 second walks the widgets top to bottom and fills each cell from
+ *                 its end, which leaves every offset at the cell start and every
+ *                 cell sorted bottom to top.
+ * @performance O(widgets + cells), rebuilt only after the widget set changed
+ */
+void FastWidgets::buildIndex() {
+    memset(cell_first, 0, sizeof(cell_first));
+    index_valid = true;
+    index_overflow = false;
+
+    int16_t cx0, cy0, cx1, cy1;
+    for (uint16_t i = 0; i < widget_count; i++) {
+        if (!widgets[i]->isTouchable() || !cellRange(widgets[i], cx0, cy0, cx1, cy1)) continue;
+        for (int16_t cy = cy0; cy <= cy1; cy++) {
+            for (int16_t cx = cx0; cx <= cx1; cx++) cell_first[cy * FG_HIT_GRID + cx]++;
+        }
+    }
+
+    uint32_t total = 0;
+    for (uint16_t c = 0; c < FG_HIT_CELLS; c++) {
+        total += cell_first[c];
+        if (total > FG_HIT_ENTRIES) {
+            index_overflow = true;
+            return;
+        }
+        cell_first[c] = total;
+    }
+    cell_first[FG_HIT_CELLS] = total;
+
+    for (uint16_t i = widget_count; i-- > 0;) {
+        if (!widgets[i]->isTouchable() || !cellRange(widgets[i], cx0, cy0, cx1, cy1)) continue;
+        for (int16_t cy = cy0; cy <= cy1; cy++) {
+            for (int16_t cx = cx0; cx <= cx1; cx++) cell_entries[--cell_first[cy * FG_HIT_GRID + cx]] = i;
+        }
+    }
+}
+
+/**
+ * @brief Find the topmost touchable widget at a point
+ * @implementation Scans the point's cell from the top down; the first widget that
+ *                 contains the point wins.
+ * @performance O(widgets overlapping one cell)
+ */
+FastWidget* FastWidgets::hitTest(int16_t x, int16_t y) {
+    if (x < 0 || y < 0) return nullptr;
+    int16_t cx = x >> FG_HIT_CELL_SHIFT, cy = y >> FG_HIT_CELL_SHIFT;
+    if (cx >= FG_HIT_GRID || cy >= FG_HIT_GRID) return nullptr;
+
+    if (!index_valid) buildIndex();
+    if (index_overflow) {
+        for (uint16_t i = widget_count; i-- > 0;) {
+            if (widgets[i]->isTouchable() && widgets[i]->contains(x, y)) return widgets[i];
+        }
+        return nullptr;
+    }
+    uint16_t c = cy * FG_HIT_GRID + cx;
+    for (uint16_t k = cell_first[c + 1]; k-- > cell_first[c];) {
+        FastWidget* widget = widgets[cell_entries[k]];
+        if (widget->contains(x, y)) return widget;
+    }
+    return nullptr;
+}
+
+FastWidget* FastWidgets::touchDown(int16_t x, int16_t y) {
+    FastWidget* hit = hitTest(x, y);
+    if (hit != pressed) {
+        if (pressed) pressed->setPressed(false);
+        if (hit) hit->setPressed(true);
+        pressed = hit;
+    }
+    return hit;
+}
+
+FastWidget* FastWidgets::touchUp() {
+    FastWidget* released = pressed;
+    if (released) released->setPressed(false);
+    pressed = nullptr;
+    return released;
+}
+
+FastWidget* FastWidgets::getPressed() {
+    return pressed;
+}
@@ -0,0 +1,720 @@
+// FastWidgets.h - Retained-mode widgets for FastGraphics
+// Widgets remember what they drew and only redraw when their value changes
+
+#ifndef FAST_WIDGETS_H
+#define FAST_WIDGETS_H
+
+#include <Arduino.h>
+#include "FastGraphics.h"
+
+// =============================================================================
+// WIDGET CONFIGURATION
+// =============================================================================
+
+#ifndef FG_MAX_WIDGETS
+#define FG_MAX_WIDGETS 128          /**< Widgets the FastWidgets manager can hold */
+#endif
+
+#ifndef FG_WIDGET_TEXT_MAX
+#define FG_WIDGET_TEXT_MAX 32       /**< Characters stored per label/number (incl. terminator) */
+#endif
+
+#ifndef FG_HIT_CELL_SHIFT
+#define FG_HIT_CELL_SHIFT 5         /**< Hit-test grid cells are 1 << 5 = 32 pixels square */
+#endif
+
+#ifndef FG_HIT_ENTRIES
+#define FG_HIT_ENTRIES 2048         /**< Widget/cell pairs the grid holds (a full screen takes 375) */
+#endif
+
+#ifndef FG_CHART_SERIES
+#define FG_CHART_SERIES 4           /**< Series a FastChart can plot */
+#endif
+
+#ifndef FG_CHART_GAP
+#define FG_CHART_GAP 4              /**< Blank columns ahead of the cursor of a sweeping chart */
+#endif
+
+// Square grid over the larger screen side, so it covers every rotation (and every panel)
+#define FG_HIT_GRID ((((LCD_MAX_H_RES > LCD_MAX_V_RES) ? LCD_MAX_H_RES : LCD_MAX_V_RES) + (1 << FG_HIT_CELL_SHIFT) - 1) >> FG_HIT_CELL_SHIFT)
+#define FG_HIT_CELLS (FG_HIT_GRID * FG_HIT_GRID)
+
+// =============================================================================
+// FASTWIDGET BASE CLASS
+// =============================================================================
+
+/**
+ * @class FastWidget
+ * @brief Base class for retained-mode widgets
+ * @details A widget owns a screen rectangle and remembers its last rendered state.
+ *          Setters only record the new state; update() redraws when something
+ *          actually changed. A full redraw paints the whole rectangle (after
+ *          invalidate() or the first update()), an incremental redraw touches only
+ *          the pixels that differ from the previous state.
+ *
+ * @note Drawing goes through FastGraphics, so every redraw lands in the dirty-rect
+ *       tracker and a following flush() sends only what changed
+ * @note Widgets are plain objects: create them statically or once at start-up
+ *
+ * @example
+ * @code
+ * FastNumber temperature(10, 10, 120, 16, 1, COLOR_WHITE, COLOR_BLACK, 2);
+ * FastWidgets::add(&temperature);
+ *
+ * void loop() {
+ *     temperature.setValue(readSensor());   // Redraws only if the text changes
+ *     FastWidgets::update();
+ *     FastGraphics::flush();
+ * }
+ * @endcode
+ */
+class FastWidget {
+public:
+    /**
+     * @brief Create a widget covering a logical screen rectangle
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param w Width in pixels
+     * @param h Height in pixels
+     */
+    FastWidget(int16_t x, int16_t y, int16_t w, int16_t h);
+    virtual ~FastWidget() {}
+
+    /**
+     * @brief Redraw the widget if its state changed
+     * @return true if anything was drawn
+     */
+    bool update();
+
+    /**
+     * @brief Force a full redraw on the next update()
+     * @note Needed after something else painted over the widget (e.g. clear())
+     */
+    void invalidate();
+
+    /**
+     * @brief Check whether the next update() will draw
+     * @return true if a full or incremental redraw is pending
+     */
+    bool needsUpdate() const;
+
+    /**
+     * @brief Check whether a point lies inside the widget
+     * @param px X coordinate
+     * @param py Y coordinate
+     * @return true if (px, py) is inside the widget rectangle
+     */
+    bool contains(int16_t px, int16_t py) const;
+
+    /**
+     * @brief Let FastWidgets::hitTest() find the widget
+     * @note Buttons are touchable from the start, other widgets are not
+     */
+    void setTouchable(bool touchable);
+
+    /** @brief Check whether hit tests can return the widget */
+    bool isTouchable() const { return touchable; }
+
+    /**
+     * @brief Show the widget pressed or released
+     * @details Normally called by FastWidgets::touchDown() / touchUp(). A change
+     *          schedules a redraw of this widget only.
+     */
+    void setPressed(bool pressed);
+
+    /** @brief Check whether the widget is shown pressed */
+    bool isPressed() const { return pressed; }
+
+    int16_t getX() const { return x; }        /**< Left edge */
+    int16_t getY() const { return y; }        /**< Top edge */
+    int16_t getWidth() const { return w; }    /**< Width in pixels */
+    int16_t getHeight() const { return h; }   /**< Height in pixels */
+
+protected:
+    /**
+     * @brief Draw the widget
+     * @param full true to paint the whole rectangle, false to paint only the
+     *             difference from the previously rendered state
+     */
+    virtual void render(bool full) = 0;
+
+    /**
+     * @brief Record that the state changed and an incremental redraw is needed
+     */
+    void changed();
+
+    int16_t x, y, w, h;     /**< Widget rectangle (logical coordinates) */
+
+private:
+    bool needs_full;        /**< Whole rectangle must be painted */
+    bool needs_partial;     /**< State changed since the last render */
+    bool touchable;         /**< Found by hit tests */
+    bool pressed;           /**< Finger is down on the widget */
+};
+
+// =============================================================================
+// TEXT LABEL
+// =============================================================================
+
+/**
+ * @class FastLabel
+ * @brief Left-aligned single-line text label
+ * @details Redraws only when the text changes, and then only the character cells
+ *          whose glyph differs from what is on screen. Cells the old text covered
+ *          but the new text does not are cleared to the background color.
+ */
+class FastLabel : public FastWidget {
+public:
+    /**
+     * @brief Create a text label
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param w Width in pixels (characters that do not fit are dropped)
+     * @param h Height in pixels (text is centered vertically)
+     * @param text Initial text (copied, up to FG_WIDGET_TEXT_MAX - 1 characters)
+     * @param color RGB565 text color
+     * @param bg RGB565 background color
+     * @param size Text scaling factor
+     */
+    FastLabel(int16_t x, int16_t y, int16_t w, int16_t h, const char* text,
+              uint16_t color = COLOR_WHITE, uint16_t bg = COLOR_BLACK, uint8_t size = 1);
+
+    /**
+     * @brief Change the text
+     * @param text New text (copied); no redraw if equal to the current text
+     */
+    void setText(const char* text);
+
+    /**
+     * @brief Change the colors
+     * @note Triggers a full redraw if the colors differ
+     */
+    void setColor(uint16_t color, uint16_t bg);
+
+    /** @brief Current text */
+    const char* getText() const { return text; }
+
+protected:
+    void render(bool full) override;
+
+    /**
+     * @brief Store new text (truncated to what fits the width)
+     * @return true if it differs from the current text
+     */
+    bool storeText(const char* new_text);
+
+    char text[FG_WIDGET_TEXT_MAX];          /**< Text to show */
+    char drawn_text[FG_WIDGET_TEXT_MAX];    /**< Text currently on screen */
+    int16_t drawn_x;                        /**< X of the first character on screen */
+    bool right_aligned;                     /**< Align text to the right edge */
+    uint16_t color, bg;                     /**< Text and background colors */
+    uint8_t size;                           /**< Text scaling factor */
+};
+
+// =============================================================================
+// NUMERIC VALUE
+// =============================================================================
+
+/**
+ * @class FastNumber
+ * @brief Right-aligned numeric readout
+ * @details Formats the value with FastFormat and redraws only when the formatted
+ *          text changes, so sensor noise below the shown resolution costs nothing.
+ *          Digits are right-aligned, so e.g. 23.4 -> 23.5 redraws a single glyph.
+ */
+class FastNumber : public FastLabel {
+public:
+    /**
+     * @brief Create a numeric readout
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param w Width in pixels (digits are right-aligned inside)
+     * @param h Height in pixels
+     * @param decimals Number of decimal places
+     * @param color RGB565 text color
+     * @param bg RGB565 background color
+     * @param size Text scaling factor
+     */
+    FastNumber(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t decimals,
+               uint16_t color = COLOR_WHITE, uint16_t bg = COLOR_BLACK, uint8_t size = 1);
+
+    /**
+     * @brief Change the value
+     * @param value New value; no redraw if it formats to the same text
+     * @note Text longer than FG_WIDGET_TEXT_MAX - 1 characters is shown without decimals
+     */
+    void setValue(double value);
+
+    /** @brief Last value set */
+    double getValue() const { return value; }
+
+private:
+    double value;           /**< Last value set */
+    uint8_t decimals;       /**< Decimal places shown */
+};
+
+// =============================================================================
+// PROGRESS BAR
+// =============================================================================
+
+/**
+ * @class FastBar
+ * @brief Horizontal progress/level bar
+ * @details An incremental redraw fills only the strip between the old and the new
+ *          fill level, in the bar or the background color.
+ */
+class FastBar : public FastWidget {
+public:
+    /**
+     * @brief Create a bar
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param w Width in pixels (including 1px border)
+     * @param h Height in pixels (including 1px border)
+     * @param min_value Value shown as empty
+     * @param max_value Value shown as full
+     * @param color RGB565 bar color
+     * @param bg RGB565 empty-area color
+     * @param border RGB565 border color
+     */
+    FastBar(int16_t x, int16_t y, int16_t w, int16_t h, float min_value, float max_value,
+            uint16_t color = COLOR_GREEN, uint16_t bg = COLOR_BLACK, uint16_t border = COLOR_GRAY);
+
+    /**
+     * @brief Change the value
+     * @param value New value (clamped to the range); no redraw if the fill width is unchanged
+     */
+    void setValue(float value);
+
+    /**
+     * @brief Change the bar color
+     * @note Triggers a full redraw if the color differs
+     */
+    void setColor(uint16_t color);
+
+protected:
+    void render(bool full) override;
+
+private:
+    float min_value, max_value;         /**< Value range */
+    int16_t fill;                       /**< Fill width for the current value */
+    int16_t drawn_fill;                 /**< Fill width last rendered */
+    uint16_t color, bg, border;         /**< Colors */
+};
+
+// =============================================================================
+// CIRCULAR GAUGE
+// =============================================================================
+
+/**
+ * @class FastGauge
+ * @brief Analog gauge with tick marks and a needle over a 270° sweep
+ * @details A full redraw paints the face and ticks; an incremental redraw erases the
+ *          old needle with the face color and draws the new one. Ticks sit outside
+ *          the needle radius so the needle never damages them.
+ */
+class FastGauge : public FastWidget {
+public:
+    /**
+     * @brief Create a gauge
+     * @param cx Center X coordinate
+     * @param cy Center Y coordinate
+     * @param radius Outer radius in pixels
+     * @param min_value Value at the start of the sweep (bottom left)
+     * @param max_value Value at the end of the sweep (bottom right)
+     * @param needle RGB565 needle color
+     * @param face RGB565 face color
+     * @param ticks RGB565 rim and tick color
+     */
+    FastGauge(int16_t cx, int16_t cy, int16_t radius, float min_value, float max_value,
+              uint16_t needle = COLOR_RED, uint16_t face = COLOR_BLACK, uint16_t ticks = COLOR_WHITE);
+
+    /**
+     * @brief Change the value
+     * @param value New value (clamped to the range); no redraw if the needle tip
+     *              lands on the same pixel
+     */
+    void setValue(float value);
+
+protected:
+    void render(bool full) override;
+
+private:
+    /**
+     * @brief Needle tip position for a value
+     */
+    void needleTip(float value, int16_t& tx, int16_t& ty) const;
+
+    int16_t cx, cy, radius;             /**< Geometry */
+    float min_value, max_value;         /**< Value range */
+    float value;                        /**< Current value */
+    int16_t tip_x, tip_y;               /**< Needle tip for the current value */
+    int16_t drawn_tip_x, drawn_tip_y;   /**< Needle tip last rendered */
+    uint16_t needle, face, ticks;       /**< Colors */
+};
+
+// =============================================================================
+// BUTTON
+// =============================================================================
+
+/**
+ * @class FastButton
+ * @brief Touchable button with a centered caption
+ * @details Paints a bordered face in the normal or the pressed color. Pressing and
+ *          releasing repaint the button rectangle, nothing else.
+ */
+class FastButton : public FastWidget {
+public:
+    /**
+     * @brief Create a button
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param w Width in pixels (including 1px border)
+     * @param h Height in pixels (including 1px border)
+     * @param text Caption (copied, up to FG_WIDGET_TEXT_MAX - 1 characters)
+     * @param color RGB565 caption and border color
+     * @param bg RGB565 face color
+     * @param pressed_bg RGB565 face color while pressed
+     * @param size Text scaling factor
+     */
+    FastButton(int16_t x, int16_t y, int16_t w, int16_t h, const char* text,
+               uint16_t color = COLOR_WHITE, uint16_t bg = COLOR_BLUE, uint16_t pressed_bg = COLOR_GRAY,
+               uint8_t size = 1);
+
+    /**
+     * @brief Change the caption
+     * @param text New caption (copied); no redraw if equal to the current one
+     */
+    void setText(const char* text);
+
+    /** @brief Current caption */
+    const char* getText() const { return text; }
+
+protected:
+    void render(bool full) override;
+
+private:
+    char text[FG_WIDGET_TEXT_MAX];      /**< Caption */
+    uint16_t color, bg, pressed_bg;     /**< Colors */
+    uint8_t size;                       /**< Text scaling factor */
+};
+
+// =============================================================================
+// STRIP CHART
+// =============================================================================
+
+/**
+ * @brief How a FastChart moves through time
+ */
+enum ChartMode {
+    CHART_SWEEP,    /**< Time runs left to right, the cursor wraps and overwrites the oldest column */
+    CHART_SCROLL    /**< Time runs top to bottom, the trace scrolls up and new samples enter at the bottom */
+};
+
+/**
+ * @class FastChart
+ * @brief Real-time strip chart with one or more series
+ * @details Keeps a ring of columns, one per pixel along the time axis. A column
+ *          holds the minimum and maximum of each series over its samples
+ *          (setDecimation() samples per column) and reaches back to the previous
+ *          sample, so a steep edge stays a connected trace. Each column is drawn
+ *          as one span per series, and an incremental redraw draws only the
+ *          columns added since the last update():
+ *
+ *          - CHART_SWEEP writes the new column at a cursor that wraps around,
+ *            with FG_CHART_GAP blank columns ahead of it, so a sample costs two
+ *            1-pixel-wide fills per series.
+ *          - CHART_SCROLL adds a row at the bottom and scrolls the rest up. A chart
+ *            spanning the screen width scrolls through the framebuffer scroll
+ *            viewport (FastGraphics::setScrollViewport()), which moves no pixels;
+ *            otherwise it falls back to FastGraphics::scrollRect().
+ *
+ *          The ring keeps the sample values, so a range change redraws the visible
+ *          columns at the new scale. With auto range, the range grows as soon as a
+ *          column leaves it and shrinks, checked once per sweep, when the trace
+ *          uses less than a quarter of it. Either way this costs one full redraw.
+ *
+ * @note The ring (8 bytes per column and series) is allocated in the constructor;
+ *       without memory the chart shows only its background
+ * @note A scrolling chart of the screen width keeps the scroll viewport on, see
+ *       FastGraphics::setScrollViewport() for the modes that excludes
+ *
+ * @example
+ * @code
+ * FastChart trend(0, 40, 800, 240, 0.0f, 100.0f, 2);     // Two series over 800 columns
+ * trend.setSeriesColor(1, COLOR_YELLOW);
+ * trend.setDecimation(4);                                  // 4 samples per column
+ * trend.setAutoRange(true);
+ * FastWidgets::add(&trend);
+ *
+ * void onSample() {                                        // 100 times a second
+ *     float values[2] = { readPressure(), readFlow() };
+ *     trend.addSamples(values);
+ * }
+ *
+ * void loop() {
+ *     FastWidgets::update();                               // Draws the new columns only
+ *     FastGraphics::flush();
+ * }
+ * @endcode
+ */
+class FastChart : public FastWidget {
+public:
+    /**
+     * @brief Create a chart
+     * @param x Left edge X coordinate
+     * @param y Top edge Y coordinate
+     * @param w Width in pixels
+     * @param h Height in pixels
+     * @param min_value Value at the bottom (CHART_SWEEP) or left edge (CHART_SCROLL)
+     * @param max_value Value at the top (CHART_SWEEP) or right edge (CHART_SCROLL)
+     * @param series Number of series (1 to FG_CHART_SERIES)
+     * @param mode Time axis, see ChartMode
+     * @param bg RGB565 background color
+     */
+    FastChart(int16_t x, int16_t y, int16_t w, int16_t h, float min_value, float max_value,
+              uint8_t series = 1, ChartMode mode = CHART_SWEEP, uint16_t bg = COLOR_BLACK);
+    ~FastChart();
+
+    FastChart(const FastChart&) = delete;
+    FastChart& operator=(const FastChart&) = delete;
+
+    /**
+     * @brief Add one sample to every series
+     * @param values One value per series
+     * @note Completes a column every setDecimation() calls; the column is drawn on
+     *       the next update()
+     */
+    void addSamples(const float* values);
+
+    /**
+     * @brief Add a sample to the first series
+     * @details For single-series charts. Other series repeat their last value.
+     */
+    void addSample(float value);
+
+    /**
+     * @brief Remove all samples
+     * @note Triggers a full redraw
+     */
+    void clearData();
+
+    /**
+     * @brief Set the value range
+     * @note Triggers a full redraw if the range differs, and turns auto range off
+     */
+    void setRange(float min_value, float max_value);
+
+    /**
+     * @brief Let the range follow the data
+     * @details Grows the range (with 1/8 headroom on both sides) when a new column
+     *          leaves it, and fits it again when the trace at the end of a sweep
+     *          uses less than a quarter of it.
+     */
+    void setAutoRange(bool enabled);
+
+    /**
+     * @brief Set the number of samples combined into one column
+     * @param samples Samples per column (at least 1)
+     * @note Samples of an unfinished column are dropped
+     */
+    void setDecimation(uint16_t samples);
+
+    /**
+     * @brief Change the color of a series
+     * @note Triggers a full redraw if the color differs
+     */
+    void setSeriesColor(uint8_t series, uint16_t color);
+
+    float getMin() const { return range_min; }                /**< Value range start */
+    float getMax() const { return range_max; }                /**< Value range end */
+    uint32_t getColumnCount() const { return columns; }       /**< Columns completed since the last clearData() */
+
+protected:
+    void render(bool full) override;
+
+private:
+    /** @brief Smallest and largest value of a series in one column */
+    struct Span {
+        float lo, hi;
+    };
+
+    /** @brief Set the range without changing auto range */
+    void applyRange(float min_value, float max_value);
+
+    /**
+     * @brief Position of a value along the value axis
+     * @return 0 for the range start to values - 1 for its end, clamped
+     */
+    int16_t valuePixel(float value) const;
+
+    /**
+     * @brief Pixel along the time axis a column is drawn at
+     * @return 0 to length - 1, for a column among the last shown ones
+     */
+    int16_t columnSlot(uint32_t column) const;
+
+    /**
+     * @brief Draw the spans of a column
+     * @param slot Pixel along the time axis (0 to length - 1)
+     * @param column Column to draw, its spans are in ring slot column % length
+     */
+    void drawColumn(int16_t slot, uint32_t column);
+
+    /** @brief Fill the line of a slot with the background */
+    void clearSlot(int16_t slot);
+
+    /**
+     * @brief Smallest and largest value in the visible columns
+     * @return false if there are none
+     */
+    bool dataExtent(float& lo, float& hi) const;
+
+    /** @brief Fit the range to the visible columns with headroom */
+    void fitRange();
+
+    /** @brief Check whether the chart owns the scroll viewport */
+    bool viewportActive() const;
+
+    Span* spans;                            /**< Ring of length columns x series spans */
+    int16_t length;                         /**< Columns along the time axis */
+    int16_t breadth;                        /**< Pixels along the value axis */
+    int16_t gap;                            /**< Blank columns ahead of the cursor (CHART_SWEEP) */
+    int16_t shown;                          /**< Columns on screen at most: length - gap */
+    uint8_t series;                         /**< Number of series */
+    ChartMode mode;                         /**< Time axis */
+    uint16_t bg;                            /**< Background color */
+    uint16_t colors[FG_CHART_SERIES];       /**< Series colors */
+    float range_min, range_max;             /**< Value range */
+    float scale;                            /**< Value axis pixels per unit */
+    bool auto_range;                        /**< Range follows the data */
+    uint16_t decimation;                    /**< Samples per column */
+    uint16_t pending;                       /**< Samples in the unfinished column */
+    Span current[FG_CHART_SERIES];          /**< Unfinished column */
+    float last[FG_CHART_SERIES];            /**< Last sample of each series */
+    bool has_last;                          /**< last[] holds samples */
+    uint32_t columns;                       /**< Completed columns */
+    uint32_t drawn_columns;                 /**< Completed columns on screen */
+};
+
+// =============================================================================
+// WIDGET MANAGER
+// =============================================================================
+
+/**
+ * @class FastWidgets
+ * @brief Registry that updates all widgets of a screen in one call
+ * @details Holds up to FG_MAX_WIDGETS widget pointers in insertion order. Widgets
+ *          added later are drawn later, i.e. on top.
+ *
+ *          Touchable widgets are indexed in a uniform grid of 32x32 pixel cells.
+ *          Each cell lists the widgets overlapping it bottom to top, so a hit test
+ *          checks only the few widgets of one cell instead of every widget. The
+ *          grid is rebuilt on the first hit test after widgets were added, removed
+ *          or made (un)touchable.
+ *
+ * @example
+ * @code
+ * FastButton ok(600, 400, 160, 60, "OK", COLOR_WHITE, COLOR_BLUE, COLOR_GRAY, 2);
+ * FastWidgets::add(&ok);
+ *
+ * TouchEvent event;
+ * if (touch_get_event(event)) {
+ *     if (event.type == TOUCH_EVENT_PRESS || event.type == TOUCH_EVENT_DRAG) {
+ *         FastWidgets::touchDown(event.points[0].x, event.points[0].y);
+ *     } else if (event.type == TOUCH_EVENT_RELEASE && FastWidgets::touchUp() == &ok) {
+ *         confirm();
+ *     }
+ * }
+ * FastWidgets::update();      // Repaints just the pressed / released button
+ * FastGraphics::flush();
+ * @endcode
+ */
+class FastWidgets {
+public:
+    /**
+     * @brief Register a widget
+     * @param widget Widget to add (must outlive its registration)
+     * @return false if the registry is full
+     */
+    static bool add(FastWidget* widget);
+
+    /**
+     * @brief Unregister a widget
+     * @param widget Widget to remove (its pixels stay on screen)
+     */
+    static void remove(FastWidget* widget);
+
+    /**
+     * @brief Unregister all widgets
+     */
+    static void removeAll();
+
+    /**
+     * @brief Redraw every widget whose state changed
+     * @return Number of widgets that drew something
+     */
+    static uint16_t update();
+
+    /**
+     * @brief Force a full redraw of every widget on the next update()
+     * @note Call after clear() or switching screens
+     */
+    static void invalidateAll();
+
+    /** @brief Number of registered widgets */
+    static uint16_t count();
+
+    /** @brief Registered widget by index (draw order) */
+    static FastWidget* get(uint16_t index);
+
+    // =============================================================================
+    // HIT TESTING
+    // =============================================================================
+
+    /**
+     * @brief Find the topmost touchable widget at a point
+     * @param x X coordinate (logical)
+     * @param y Y coordinate (logical)
+     * @return The widget added last among those containing the point, nullptr if none
+     *         or if the point is outside the grid (off screen)
+     */
+    static FastWidget* hitTest(int16_t x, int16_t y);
+
+    /**
+     * @brief Finger down or moved
+     * @details Presses the widget under the finger. Moving off it releases it
+     *          without activation, moving onto another widget presses that one.
+     * @return The pressed widget, nullptr if the finger is over no touchable widget
+     */
+    static FastWidget* touchDown(int16_t x, int16_t y);
+
+    /**
+     * @brief Finger lifted
+     * @details Releases the pressed widget.
+     * @return The widget the finger was lifted from (activated), nullptr if none
+     */
+    static FastWidget* touchUp();
+
+    /** @brief Widget currently pressed, nullptr if none */
+    static FastWidget* getPressed();
+
+private:
+    friend class FastWidget;
+
+    /**
+     * @brief Sort the touchable widgets into the grid cells they overlap
+     * @details Falls back to linear hit tests if FG_HIT_ENTRIES is too small.
+     */
+    static void buildIndex();
+
+    static FastWidget* widgets[FG_MAX_WIDGETS];     /**< Registered widgets in draw order */
+    static uint16_t widget_count;                   /**< Number of registered widgets */
+    static FastWidget* pressed;                     /**< Widget under the finger */
+    static bool index_valid;                        /**< Grid matches the widgets */
+    static bool index_overflow;                     /**< Grid too small, hit tests are linear */
+    static uint16_t cell_first[FG_HIT_CELLS + 1];   /**< First entry of each cell, end of the last */
+    static uint16_t cell_entries[FG_HIT_ENTRIES];   /**< Widget indices per cell, bottom to top */
+};
+
+#endif // FAST_WIDGETS_H
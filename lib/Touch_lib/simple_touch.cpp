@@ -1,12 +1,33 @@
 // simple_touch.cpp - Touch implementation for PlatformIO
 #include <Arduino.h>
 #include "simple_touch.h"
+#include "freertos/queue.h"
+#include "esp_timer.h"
+#include "FastGraphics.h"  // Current rotation, LCD_H_RES / LCD_V_RES
 
 int touch_last_x = 0, touch_last_y = 0;
 
 TAMC_GT911 ts = TAMC_GT911(TOUCH_GT911_SDA, TOUCH_GT911_SCL, TOUCH_GT911_INT, TOUCH_GT911_RST, 
                            max(TOUCH_MAP_X1, TOUCH_MAP_X2), max(TOUCH_MAP_Y1, TOUCH_MAP_Y2));
 
+static bool touch_found = false;
+
+// Touch task state
+static TaskHandle_t touch_task = nullptr;
+static QueueHandle_t touch_queue = nullptr;
+static volatile bool touch_stop = false;
+static volatile int64_t touch_irq_time = 0;       // esp_timer time of the last INT edge
+
+// Shared with touch_touched(), guarded by touch_mux
+static portMUX_TYPE touch_mux = portMUX_INITIALIZER_UNLOCKED;
+static bool touch_down = false;
+static int16_t touch_down_x = 0, touch_down_y = 0;
+
+// Gesture tracking, touch task only
+static TouchEvent touch_press;                     // Points and time of PRESS
+static TouchEvent touch_last;                      // Last report while down
+static bool touch_dragging = false;
+
 void touch_init()
 {
   Wire.begin(TOUCH_GT911_SDA, TOUCH_GT911_SCL);
@@ -30,20 +51,220 @@ void touch_init()
   if (!done) {
     Serial.println("GT911 touch controller NOT found!");
   }
+  touch_found = done;
 
   ts.setRotation(TOUCH_GT911_ROTATION);
 }
 
+// Linear map of one controller axis onto 0..size-1, like map() but clamped
+static int16_t touch_scale(int32_t value, int32_t from, int32_t to, int16_t size)
+{
+  int32_t p = (value - from) * (size - 1) / (to - from);
+  if (p < 0) return 0;
+  if (p >= size) return size - 1;
+  return (int16_t)p;
+}
+
+// Controller coordinates to screen coordinates of the current FastGraphics rotation,
+// the inverse of the canvas' logical-to-physical transform
+static void touch_map(uint16_t raw_x, uint16_t raw_y, int16_t& x, int16_t& y)
+{
+  int16_t px = touch_scale(raw_x, TOUCH_MAP_X1, TOUCH_MAP_X2, LCD_H_RES);
+  int16_t py = touch_scale(raw_y, TOUCH_MAP_Y1, TOUCH_MAP_Y2, LCD_V_RES);
+  switch (FastGraphics::getRotation()) {
+    case ROTATION_90:  x = py;                 y = LCD_H_RES - 1 - px; break;
+    case ROTATION_180: x = LCD_H_RES - 1 - px; y = LCD_V_RES - 1 - py; break;
+    case ROTATION_270: x = LCD_V_RES - 1 - py; y = px;                 break;
+    default:           x = px;                 y = py;                 break;
+  }
+}
+
 bool touch_touched()
 {
+  if (touch_task) {
+    portENTER_CRITICAL(&touch_mux);
+    bool down = touch_down;
+    if (down) {
+      touch_last_x = touch_down_x;
+      touch_last_y = touch_down_y;
+    }
+    portEXIT_CRITICAL(&touch_mux);
+    return down;
+  }
+
   ts.read();
   if (ts.isTouched) {
     // Map touch coordinates to screen coordinates
-    touch_last_x = map(ts.points[0].x, TOUCH_MAP_X1, TOUCH_MAP_X2, 0, 799);
-    touch_last_y = map(ts.points[0].y, TOUCH_MAP_Y1, TOUCH_MAP_Y2, 0, 479);
+    int16_t x, y;
+    touch_map(ts.points[0].x, ts.points[0].y, x, y);
+    touch_last_x = x;
+    touch_last_y = y;
     return true;
   }
   else {
     return false;
   }
-}
\ No newline at end of file
+}
+
+// =============================================================================
+// TOUCH TASK
+// =============================================================================
+
+static void IRAM_ATTR touch_isr()
+{
+  touch_irq_time = esp_timer_get_time();
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(touch_task, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+static void touch_post(const TouchEvent& event)
+{
+  // A newer drag supersedes this one, so drags never take the room kept for
+  // RELEASE and the gesture that follows it
+  if (event.type == TOUCH_EVENT_DRAG && uxQueueSpacesAvailable(touch_queue) <= 2) return;
+  xQueueSend(touch_queue, &event, 0);
+}
+
+// Turns one controller report into events and updates the gesture state
+static void touch_process(uint8_t count, int64_t time)
+{
+  TouchEvent event = {};
+  event.time_us = time;
+  event.count = count < TOUCH_MAX_POINTS ? count : TOUCH_MAX_POINTS;
+  for (uint8_t i = 0; i < event.count; i++) {
+    touch_map(ts.points[i].x, ts.points[i].y, event.points[i].x, event.points[i].y);
+    event.points[i].size = ts.points[i].size;
+    event.points[i].id = ts.points[i].id;
+  }
+
+  bool was_down = touch_last.count > 0;
+  if (event.count > 0) {
+    if (was_down) {
+      event.dx = event.points[0].x - touch_press.points[0].x;
+      event.dy = event.points[0].y - touch_press.points[0].y;
+    }
+    portENTER_CRITICAL(&touch_mux);
+    touch_down = true;
+    touch_down_x = event.points[0].x;
+    touch_down_y = event.points[0].y;
+    portEXIT_CRITICAL(&touch_mux);
+  }
+
+  if (event.count > 0 && !was_down) {
+    event.type = TOUCH_EVENT_PRESS;
+    touch_press = event;
+    touch_dragging = false;
+    touch_post(event);
+  } else if (event.count > 0) {
+    if (!touch_dragging && (abs(event.dx) > TOUCH_TAP_SLOP || abs(event.dy) > TOUCH_TAP_SLOP)) {
+      touch_dragging = true;
+    }
+    bool moved = false;
+    for (uint8_t i = 0; i < event.count; i++) {
+      moved |= event.points[i].x != touch_last.points[i].x || event.points[i].y != touch_last.points[i].y;
+    }
+    if (event.count != touch_last.count || (touch_dragging && moved)) {
+      event.type = TOUCH_EVENT_DRAG;
+      touch_post(event);
+    }
+  } else if (was_down) {
+    portENTER_CRITICAL(&touch_mux);
+    touch_down = false;
+    portEXIT_CRITICAL(&touch_mux);
+
+    // Lifted fingers report no position: the release is where they were last seen
+    TouchEvent release = touch_last;
+    release.type = TOUCH_EVENT_RELEASE;
+    release.time_us = time;
+    release.count = 0;
+    touch_post(release);
+
+    int64_t held_ms = (time - touch_press.time_us) / 1000;
+    int16_t dx = release.dx, dy = release.dy;
+    if (!touch_dragging && held_ms <= TOUCH_TAP_MAX_MS) {
+      TouchEvent tap = touch_press;
+      tap.type = TOUCH_EVENT_TAP;
+      tap.time_us = time;
+      tap.count = 0;
+      touch_post(tap);
+    } else if (held_ms <= TOUCH_SWIPE_MAX_MS && (abs(dx) >= TOUCH_SWIPE_MIN || abs(dy) >= TOUCH_SWIPE_MIN)) {
+      release.type = TOUCH_EVENT_SWIPE;
+      if (abs(dx) >= abs(dy)) release.direction = dx < 0 ? TOUCH_DIR_LEFT : TOUCH_DIR_RIGHT;
+      else release.direction = dy < 0 ? TOUCH_DIR_UP : TOUCH_DIR_DOWN;
+      touch_post(release);
+    }
+  }
+  touch_last = event;
+}
+
+// Sleeps until the controller raises INT, so an idle panel costs no I2C traffic.
+// While touched it also wakes after TOUCH_RELEASE_TIMEOUT_MS, in case the edge of
+// the release report was missed.
+static void touch_task_loop(void* arg)
+{
+  while (!touch_stop) {
+    TickType_t wait = touch_last.count > 0 ? pdMS_TO_TICKS(TOUCH_RELEASE_TIMEOUT_MS) : portMAX_DELAY;
+    bool irq = ulTaskNotifyTake(pdTRUE, wait) > 0;
+    if (touch_stop) break;
+    int64_t time = irq ? touch_irq_time : esp_timer_get_time();
+    ts.read();
+    touch_process(ts.isTouched ? ts.touches : 0, time);
+  }
+  touch_task = nullptr;
+  vTaskDelete(nullptr);
+}
+
+bool touch_begin_task(UBaseType_t priority, int core)
+{
+  if (touch_task) return true;
+  if (!touch_found) return false;
+  if (!touch_queue) {
+    touch_queue = xQueueCreate(TOUCH_QUEUE_LENGTH, sizeof(TouchEvent));
+    if (!touch_queue) return false;
+  }
+  xQueueReset(touch_queue);
+  touch_last = TouchEvent();
+  touch_down = false;
+  touch_stop = false;
+
+  TaskHandle_t task = nullptr;
+  if (xTaskCreatePinnedToCore(touch_task_loop, "touch", TOUCH_TASK_STACK, nullptr, priority, &task,
+                              core < 0 ? tskNO_AFFINITY : core) != pdPASS) {
+    return false;
+  }
+  touch_task = task;
+  pinMode(TOUCH_GT911_INT, INPUT);
+  attachInterrupt(digitalPinToInterrupt(TOUCH_GT911_INT), touch_isr, TOUCH_GT911_INT_EDGE);
+  xTaskNotifyGive(task);  // Pick up a finger that is already down
+  return true;
+}
+
+void touch_stop_task()
+{
+  if (!touch_task) return;
+  detachInterrupt(digitalPinToInterrupt(TOUCH_GT911_INT));
+  touch_stop = true;
+  xTaskNotifyGive(touch_task);
+  while (touch_task) vTaskDelay(1);  // The task finishes its I2C read, then exits
+}
+
+bool touch_task_running()
+{
+  return touch_task != nullptr;
+}
+
+bool touch_get_event(TouchEvent& event, uint32_t timeout_ms)
+{
+  if (!touch_queue || !touch_task) return false;
+  if (xQueueReceive(touch_queue, &event, timeout_ms == portMAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+    return false;
+  }
+  // Drags that piled up while the reader was busy collapse into the newest
+  TouchEvent next;
+  while (event.type == TOUCH_EVENT_DRAG && xQueuePeek(touch_queue, &next, 0) == pdTRUE &&
+         next.type == TOUCH_EVENT_DRAG) {
+    xQueueReceive(touch_queue, &event, 0);
+  }
+  return true;
+}
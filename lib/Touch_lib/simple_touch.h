@@ -2,6 +2,8 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <TAMC_GT911.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
 #ifndef SIMPLE_TOUCH_H
 #define SIMPLE_TOUCH_H
@@ -17,11 +19,114 @@
 #define TOUCH_MAP_Y1 480
 #define TOUCH_MAP_Y2 0
 
+// =============================================================================
+// TOUCH TASK CONFIGURATION
+// =============================================================================
+
+#ifndef TOUCH_GT911_INT_EDGE
+#define TOUCH_GT911_INT_EDGE FALLING    // GT911 default: INT pulses low per report
+#endif
+
+#define TOUCH_MAX_POINTS 5              // GT911 tracks up to five fingers
+
+#ifndef TOUCH_QUEUE_LENGTH
+#define TOUCH_QUEUE_LENGTH 16           // Events waiting for touch_get_event()
+#endif
+
+#ifndef TOUCH_TASK_STACK
+#define TOUCH_TASK_STACK 3072
+#endif
+
+#ifndef TOUCH_RELEASE_TIMEOUT_MS
+#define TOUCH_RELEASE_TIMEOUT_MS 100    // Read once without interrupt while touched (lost release)
+#endif
+
+#ifndef TOUCH_TAP_SLOP
+#define TOUCH_TAP_SLOP 12               // Pixels a finger may wander and still tap
+#endif
+
+#ifndef TOUCH_TAP_MAX_MS
+#define TOUCH_TAP_MAX_MS 300            // Longest press that is a tap
+#endif
+
+#ifndef TOUCH_SWIPE_MIN
+#define TOUCH_SWIPE_MIN 80              // Shortest travel that is a swipe
+#endif
+
+#ifndef TOUCH_SWIPE_MAX_MS
+#define TOUCH_SWIPE_MAX_MS 500          // Longest press that is a swipe
+#endif
+
+// =============================================================================
+// TOUCH EVENTS
+// =============================================================================
+
+/**
+ * @enum TouchEventType
+ * @brief What a TouchEvent reports
+ */
+enum TouchEventType {
+  TOUCH_EVENT_PRESS,    // First finger down
+  TOUCH_EVENT_DRAG,     // Fingers moved past TOUCH_TAP_SLOP or a finger was added/lifted (coalesced)
+  TOUCH_EVENT_RELEASE,  // Last finger up, points hold the last position
+  TOUCH_EVENT_TAP,      // Short press that stayed within TOUCH_TAP_SLOP, follows RELEASE
+  TOUCH_EVENT_SWIPE     // Fast press that travelled TOUCH_SWIPE_MIN, follows RELEASE
+};
+
+/**
+ * @enum TouchDirection
+ * @brief Dominant axis and sign of a swipe, in screen coordinates
+ */
+enum TouchDirection {
+  TOUCH_DIR_NONE,
+  TOUCH_DIR_LEFT,
+  TOUCH_DIR_RIGHT,
+  TOUCH_DIR_UP,
+  TOUCH_DIR_DOWN
+};
+
+/**
+ * @struct TouchPoint
+ * @brief One finger in screen coordinates of the current FastGraphics rotation
+ */
+struct TouchPoint {
+  int16_t x, y;
+  uint16_t size;        // Contact area reported by the controller
+  uint8_t id;           // Controller track id, stable while the finger stays down
+};
+
+/**
+ * @struct TouchEvent
+ * @brief One entry of the touch event queue
+ * @details dx/dy is the travel of the first finger since PRESS. time_us is the
+ *          esp_timer time of the controller interrupt the report belongs to.
+ */
+struct TouchEvent {
+  TouchEventType type;
+  TouchDirection direction;     // Swipes only
+  uint8_t count;                // Fingers down (0 for RELEASE, TAP and SWIPE)
+  int16_t dx, dy;
+  int64_t time_us;
+  TouchPoint points[TOUCH_MAX_POINTS];
+};
+
 extern int touch_last_x, touch_last_y;
 
 extern TAMC_GT911 ts;
 
 void touch_init();
+
+// Polls the controller, or with the touch task running returns its latest state
 bool touch_touched();
 
-#endif // SIMPLE_TOUCH_H
\ No newline at end of file
+// Starts the interrupt-driven reader task; call after touch_init(). false if no
+// controller was found or the task could not be created. core -1: any core
+bool touch_begin_task(UBaseType_t priority = 3, int core = -1);
+void touch_stop_task();
+bool touch_task_running();
+
+// Takes the next event, waiting up to timeout_ms. false on timeout or without task.
+// Call from one task only: queued drags are collapsed here
+bool touch_get_event(TouchEvent& event, uint32_t timeout_ms = 0);
+
+#endif // SIMPLE_TOUCH_H
@@ -77,18 +77,13 @@
                                "much easier to read!",
                                COLOR_ORANGE, 1);
  
-     // Update display
-     if (panel_handle && frame_buffer) {
-         esp_lcd_panel_draw_bitmap(panel_handle, 0, 0, LCD_H_RES, LCD_V_RES, frame_buffer);
-     }
+     // Update display (only the regions drawn since the last flush)
+     FastGraphics::flush();
  }
  
  void setup() {
      Serial.begin(115200);
  
-     // Initialize touch controller
-     touch_init();
- 
      // Initialize display and framebuffer - critical step
      if (!initialize_display_and_framebuffer()) {
          Serial.println("Display initialization FAILED! Halting.");
@@ -97,16 +92,39 @@
          }
      }
  
+     // Initialize touch controller (after the display: panel detection probes the same I2C bus)
+     touch_init();
+ 
      // Initialize graphics library
-     FastGraphics::begin(frame_buffer);
+     FastGraphics::begin(frame_buffer, panel_handle);
  
      // Draw initial screen
      drawMyApp();
  
+     // Touch events from the controller interrupt, no polling while idle
+     if (!touch_begin_task()) {
+         Serial.println("Touch task not started, polling instead");
+     }
+ 
      Serial.println("ESP32-S3 Fast Graphics initialized!");
  }
  
  void loop() {
+     if (touch_task_running()) {
+         // Sleeps until the touch task reports something
+         TouchEvent event;
+         if (!touch_get_event(event, 1000)) return;
+         if (event.type == TOUCH_EVENT_PRESS || event.type == TOUCH_EVENT_DRAG) {
+             for (uint8_t i = 0; i < event.count; i++) {
+                 FastGraphics::fillCircle(event.points[i].x, event.points[i].y, 5, COLOR_WHITE);
+             }
+             FastGraphics::flush();
+         } else if (event.type == TOUCH_EVENT_SWIPE) {
+             Serial.printf("Swipe %d by %d, %d\n", event.direction, event.dx, event.dy);
+         }
+         return;
+     }
+ 
      // Handle touch input
      if (touch_touched()) {
          Serial.print("Touch at: ");
@@ -116,10 +134,7 @@
  
          // Draw touch feedback
          FastGraphics::fillCircle(touch_last_x, touch_last_y, 5, COLOR_WHITE);
-         
-         if (panel_handle && frame_buffer) {
-             esp_lcd_panel_draw_bitmap(panel_handle, 0, 0, LCD_H_RES, LCD_V_RES, frame_buffer);
-         }
+         FastGraphics::flush();
      }
  
      delay(50); // 20Hz update rate
@@ -0,0 +1,109 @@
+// format_check.cpp - Host check of FastFormat's worst-case output lengths
+// FastFormat has no hardware dependencies, so this builds with any host compiler:
+//   g++ -std=gnu++11 -Ilib/Fast_Graphics test/host/format_check.cpp lib/Fast_Graphics/FastFormat.cpp -o format_check && ./format_check
+
+#include "FastFormat.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#define GUARD 0x5A
+
+static int failures = 0;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+/**
+ * @brief Buffer of exactly FG_FORMAT_BUFFER_SIZE bytes followed by guard bytes
+ */
+struct GuardedBuffer {
+    char text[FG_FORMAT_BUFFER_SIZE];
+    unsigned char guard[16];
+
+    GuardedBuffer() {
+        memset(text, GUARD, sizeof(text));
+        memset(guard, GUARD, sizeof(guard));
+    }
+
+    bool intact() const {
+        for (size_t i = 0; i < sizeof(guard); i++) {
+            if (guard[i] != GUARD) return false;
+        }
+        return true;
+    }
+};
+
+static void check(const char* what, const GuardedBuffer& buffer, size_t len, size_t expected_len) {
+    bool ok = buffer.intact() && len < FG_FORMAT_BUFFER_SIZE && strlen(buffer.text) == len &&
+              (expected_len == 0 || len == expected_len);
+    printf("%-28s %2u  %s%s\n", what, (unsigned)len, buffer.intact() ? buffer.text : "(overrun)", ok ? "" : "  FAIL");
+    if (!ok) failures++;
+}
+
+static void emitToBuffer(char c, void* context) {
+    GuardedBuffer* buffer = (GuardedBuffer*)context;
+    size_t len = strnlen(buffer->text, sizeof(buffer->text));
+    if (len + 1 < sizeof(buffer->text)) {
+        buffer->text[len] = c;
+        buffer->text[len + 1] = '\0';
+    }
+}
+
+static size_t formatTo(GuardedBuffer& buffer, const char* format, ...) {
+    buffer.text[0] = '\0';
+    va_list args;
+    va_start(args, format);
+    size_t len = FastFormat::vformat(emitToBuffer, &buffer, format, args);
+    va_end(args);
+    return len;
+}
+
+// =============================================================================
+// WORST CASES
+// =============================================================================
+
+int main() {
+    {
+        GuardedBuffer b;
+        check("formatUnsigned(UINT64_MAX)", b, FastFormat::formatUnsigned(b.text, UINT64_MAX), 20);
+    }
+    {
+        GuardedBuffer b;
+        check("formatSigned(INT64_MIN)", b, FastFormat::formatSigned(b.text, INT64_MIN), 1 + 19);
+    }
+    {
+        GuardedBuffer b;
+        check("formatHex(UINT64_MAX)", b, FastFormat::formatHex(b.text, UINT64_MAX, true), 16);
+    }
+    {
+        // Largest value below the "ovf" limit, negative, all decimals
+        GuardedBuffer b;
+        check("formatFixed(-1.79e19, 9)", b, FastFormat::formatFixed(b.text, -1.79999e19, 9), 1 + 20 + 1 + 9);
+    }
+    {
+        GuardedBuffer b;
+        check("formatFixed(1e19, 99)", b, FastFormat::formatFixed(b.text, 1e19, 99), 20 + 1 + 9);
+    }
+    {
+        GuardedBuffer b;
+        check("formatFixed(-2e19, 9)", b, FastFormat::formatFixed(b.text, -2e19, 9), 3);
+    }
+    {
+        // vformat renders each number into its own FG_FORMAT_BUFFER_SIZE + 1 buffer
+        GuardedBuffer b;
+        check("vformat(%+.9f, 1.79e19)", b, formatTo(b, "%+.9f", 1.79999e19), 1 + 20 + 1 + 9);
+    }
+    {
+        GuardedBuffer b;
+        check("vformat(% .9f, -1.79e19)", b, formatTo(b, "% .9f", -1.79999e19), 1 + 20 + 1 + 9);
+    }
+    {
+        GuardedBuffer b;
+        check("vformat(%+lld, INT64_MAX)", b, formatTo(b, "%+lld", (long long)INT64_MAX), 1 + 19);
+    }
+
+    puts(failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
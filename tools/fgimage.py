@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+"""fgimage.py - Convert images to the FastGraphics FGI format
+
+FGI is the compressed RGB565 format decoded by FastImage (lib/Fast_Graphics/FastImage.h):
+QOI-style index/delta/run codes, coded row by row behind a row table so any
+rectangle can be decoded without the rows above it.
+
+Usage:
+    python tools/fgimage.py background.png -o background.h     # C array for #include
+    python tools/fgimage.py icons/*.png -o images.fgi           # Binary pack for a data partition
+
+A .h output holds one `const uint8_t <name>[]` per input, named after the file.
+Any other extension writes the images back to back, each on a 4-byte boundary
+(walk them with FastImage::next()); flash it to a data partition, e.g.
+
+    python -m esptool --chip esp32s3 write_flash <partition offset> images.fgi
+
+and map it with FastImage::mapPartition("<label>").
+
+Colors are truncated to RGB565, alpha is dropped after compositing on --background.
+Requires Pillow (pip install pillow).
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+MAGIC = b"FGI1"
+HEADER_BYTES = 16
+INDEX_SIZE = 64
+
+OP_DIFF = 0x40
+OP_LUMA = 0x80
+OP_RUN = 0xC0
+OP_RAW = 0xFE
+OP_RUN8 = 0xFF
+RUN_MAX = 62            # Longest 1-byte run
+RUN8_MAX = 255 + 63     # Longest 2-byte run
+
+
+def color_hash(c):
+    return ((c >> 11) * 3 + ((c >> 5) & 0x3F) * 5 + (c & 0x1F) * 7) % INDEX_SIZE
+
+
+def wrap(value, bits):
+    """Signed difference in a channel of the given width, as the decoder wraps it."""
+    half = 1 << (bits - 1)
+    return ((value + half) & ((1 << bits) - 1)) - half
+
+
+def encode_run(out, run):
+    while run > 0:
+        if run <= RUN_MAX:
+            out.append(OP_RUN + run - 1)
+            return
+        n = min(run, RUN8_MAX)
+        out += bytes((OP_RUN8, n - 63))
+        run -= n
+
+
+def encode_row(pixels):
+    out = bytearray()
+    index = [0] * INDEX_SIZE
+    prev = 0
+    run = 0
+    for c in pixels:
+        if c == prev:
+            run += 1
+            continue
+        encode_run(out, run)
+        run = 0
+        h = color_hash(c)
+        if index[h] == c:
+            out.append(h)
+        else:
+            dr = wrap((c >> 11) - (prev >> 11), 5)
+            dg = wrap(((c >> 5) & 0x3F) - ((prev >> 5) & 0x3F), 6)
+            db = wrap((c & 0x1F) - (prev & 0x1F), 5)
+            dr_dg = wrap(dr - (dg >> 1), 5)
+            db_dg = wrap(db - (dg >> 1), 5)
+            if -2 <= dr <= 1 and -2 <= dg <= 1 and -2 <= db <= 1:
+                out.append(OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2))
+            elif -8 <= dr_dg <= 7 and -8 <= db_dg <= 7:
+                out += bytes((OP_LUMA | (dg + 32), (dr_dg + 8) << 4 | (db_dg + 8)))
+            else:
+                out += bytes((OP_RAW, c & 0xFF, c >> 8))
+            index[h] = c
+        prev = c
+    encode_run(out, run)
+    return out
+
+
+def decode_row(data, offset, width):
+    """Reference decoder, used to verify every encoded image."""
+    index = [0] * INDEX_SIZE
+    color = 0
+    row = []
+    p = offset
+    while len(row) < width:
+        op = data[p]
+        p += 1
+        count = 1
+        if op < OP_DIFF:
+            color = index[op]
+        elif op < OP_RUN:
+            if op < OP_LUMA:
+                dr, dg, db = ((op >> 4) & 3) - 2, ((op >> 2) & 3) - 2, (op & 3) - 2
+            else:
+                dg = (op & 0x3F) - 32
+                dr = (dg >> 1) + (data[p] >> 4) - 8
+                db = (dg >> 1) + (data[p] & 0x0F) - 8
+                p += 1
+            color = ((((color >> 11) + dr) & 0x1F) << 11 | ((((color >> 5) & 0x3F) + dg) & 0x3F) << 5 |
+                     (((color & 0x1F) + db) & 0x1F))
+            index[color_hash(color)] = color
+        elif op == OP_RAW:
+            color = data[p] | data[p + 1] << 8
+            p += 2
+            index[color_hash(color)] = color
+        else:
+            count = data[p] + 63 if op == OP_RUN8 else op - (OP_RUN - 1)
+            if op == OP_RUN8:
+                p += 1
+        row += [color] * count
+    if len(row) != width:
+        raise ValueError("run crosses the end of a row")
+    return row
+
+
+def encode(pixels, width, height):
+    rows = [encode_row(pixels[y * width:(y + 1) * width]) for y in range(height)]
+    offset = HEADER_BYTES + 4 * height
+    table = bytearray()
+    for row in rows:
+        table += struct.pack("<I", offset)
+        offset += len(row)
+    header = MAGIC + struct.pack("<HHII", width, height, offset, 0)
+    return header + table + b"".join(rows)
+
+
+def verify(data, pixels, width, height):
+    for y in range(height):
+        (offset,) = struct.unpack_from("<I", data, HEADER_BYTES + 4 * y)
+        if decode_row(data, offset, width) != pixels[y * width:(y + 1) * width]:
+            raise ValueError("row %d does not decode to its pixels" % y)
+
+
+def load(path, background):
+    from PIL import Image
+    image = Image.open(path)
+    if image.mode in ("RGBA", "LA", "P"):
+        image = image.convert("RGBA")
+        base = Image.new("RGBA", image.size, background + (255,))
+        image = Image.alpha_composite(base, image)
+    image = image.convert("RGB")
+    width, height = image.size
+    if width > 32767 or height > 32767:
+        raise ValueError("%s is larger than 32767 pixels" % path)
+    pixels = [(r >> 3) << 11 | (g >> 2) << 5 | (b >> 3) for r, g, b in image.getdata()]
+    return pixels, width, height
+
+
+def c_name(path):
+    name = re.sub(r"\W", "_", os.path.splitext(os.path.basename(path))[0])
+    return name if not name[:1].isdigit() else "_" + name
+
+
+def write_header(path, images):
+    guard = c_name(path).upper() + "_H"
+    lines = ["// %s - generated by tools/fgimage.py, FGI images for FastImage" % os.path.basename(path),
+             "", "#ifndef %s" % guard, "#define %s" % guard, "", "#include <stdint.h>", ""]
+    for name, data, width, height in images:
+        lines.append("// %d x %d, %d bytes" % (width, height, len(data)))
+        lines.append("alignas(4) const uint8_t %s[%d] = {" % (name, len(data)))
+        for i in range(0, len(data), 16):
+            lines.append("    " + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+        lines += ["};", ""]
+    lines.append("#endif // %s" % guard)
+    with open(path, "w", newline="\n") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+def write_pack(path, images):
+    with open(path, "wb") as f:
+        for _, data, _, _ in images:
+            f.write(data)
+            f.write(b"\0" * (-len(data) & 3))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert images to the FastGraphics FGI format")
+    parser.add_argument("inputs", nargs="+", help="Image files (anything Pillow reads)")
+    parser.add_argument("-o", "--output", required=True, help=".h for C arrays, otherwise a binary pack")
+    parser.add_argument("--background", default="000000",
+                        help="RGB hex color transparent pixels are composited on (default 000000)")
+    args = parser.parse_args()
+
+    background = tuple(int(args.background[i:i + 2], 16) for i in (0, 2, 4))
+    images = []
+    offset = 0
+    for path in args.inputs:
+        pixels, width, height = load(path, background)
+        data = encode(pixels, width, height)
+        verify(data, pixels, width, height)
+        images.append((c_name(path), data, width, height))
+        print("%s: %d x %d, %d bytes (%.1fx) at offset %d" %
+              (path, width, height, len(data), 2.0 * width * height / len(data), offset))
+        offset += (len(data) + 3) & ~3
+
+    if args.output.endswith(".h"):
+        write_header(args.output, images)
+    else:
+        write_pack(args.output, images)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())